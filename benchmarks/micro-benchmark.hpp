@@ -0,0 +1,249 @@
+#ifndef MICRO_BENCHMARK_HPP
+#define MICRO_BENCHMARK_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * \brief minimal in-tree microbenchmark harness
+ *
+ * Follows the Google Benchmark API closely enough (BENCHMARK, State,
+ * range-for over State, DoNotOptimize) that a benchmark file can be moved to
+ * the real library unchanged. Each benchmark is rerun with a growing number of
+ * iterations until it has run for at least --min_time seconds.
+ *
+ * Options: --filter=<substring>, --min_time=<seconds>, --format=console|csv
+ */
+namespace benchmark {
+
+template<typename T>
+inline void
+DoNotOptimize(T const& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+inline void
+ClobberMemory() {
+    asm volatile("" : : : "memory");
+}
+
+class State {
+  public:
+    State(uint64_t maxIterations, std::vector<int64_t> args)
+        : m_maxIterations(maxIterations), m_args(std::move(args)) {}
+
+    class Iterator {
+      public:
+        explicit Iterator(uint64_t remaining) : m_remaining(remaining) {}
+
+        // non-trivial so that "for (auto _ : state)" does not warn about an unused variable
+        struct Value {
+            ~Value() {}
+        };
+
+        Value operator*() const { return Value(); }
+
+        Iterator& operator++() {
+            --m_remaining;
+            return *this;
+        }
+
+        bool operator!=(const Iterator&) const { return m_remaining != 0; }
+
+      private:
+        uint64_t m_remaining;
+    };
+
+    Iterator begin() {
+        m_start = std::chrono::steady_clock::now();
+        return Iterator(m_maxIterations);
+    }
+
+    Iterator end() {
+        return Iterator(0);
+    }
+
+    bool KeepRunning() {
+        if (m_running == 0) {
+            m_start = std::chrono::steady_clock::now();
+        }
+        return m_running++ < m_maxIterations;
+    }
+
+    int64_t range(size_t pos = 0) const { return m_args.at(pos); }
+
+    uint64_t iterations() const { return m_maxIterations; }
+
+    void SetItemsProcessed(int64_t items) { m_items = items; }
+
+    int64_t items_processed() const { return m_items; }
+
+    void SetLabel(const std::string& label) { m_label = label; }
+
+    const std::string& label() const { return m_label; }
+
+    std::chrono::steady_clock::time_point startTime() const { return m_start; }
+
+  private:
+    uint64_t m_maxIterations;
+    uint64_t m_running = 0;
+    std::vector<int64_t> m_args;
+    int64_t m_items = 0;
+    std::string m_label;
+    std::chrono::steady_clock::time_point m_start;
+};
+
+namespace internal {
+
+class Benchmark {
+  public:
+    Benchmark(const char* name, std::function<void(State&)> fn) : m_name(name), m_fn(std::move(fn)) {}
+
+    Benchmark* Arg(int64_t x) {
+        m_args.push_back({x});
+        return this;
+    }
+
+    Benchmark* Args(const std::vector<int64_t>& args) {
+        m_args.push_back(args);
+        return this;
+    }
+
+    Benchmark* RangeMultiplier(int mult) {
+        m_multiplier = mult;
+        return this;
+    }
+
+    /** \brief lo, lo*multiplier, ... below hi, plus hi itself
+     */
+    Benchmark* Range(int64_t lo, int64_t hi) {
+        for (int64_t x = lo; x < hi; x *= m_multiplier) {
+            m_args.push_back({x});
+        }
+        m_args.push_back({hi});
+        return this;
+    }
+
+    const std::string& name() const { return m_name; }
+
+    std::vector<std::vector<int64_t>> argSets() const {
+        return m_args.empty() ? std::vector<std::vector<int64_t>>{{}} : m_args;
+    }
+
+    void run(State& state) const { m_fn(state); }
+
+  private:
+    std::string m_name;
+    std::function<void(State&)> m_fn;
+    std::vector<std::vector<int64_t>> m_args;
+    int m_multiplier = 8;
+};
+
+inline std::vector<std::unique_ptr<Benchmark>>&
+registry() {
+    static std::vector<std::unique_ptr<Benchmark>> benchmarks;
+    return benchmarks;
+}
+
+inline Benchmark*
+registerBenchmark(const char* name, void (*fn)(State&)) {
+    registry().emplace_back(new Benchmark(name, fn));
+    return registry().back().get();
+}
+
+inline const char*
+optionValue(const char* arg, const char* option) {
+    size_t len = std::strlen(option);
+    return std::strncmp(arg, option, len) == 0 ? arg + len : nullptr;
+}
+
+} // namespace internal
+
+inline int
+RunSpecifiedBenchmarks(int argc, char** argv) {
+    std::string filter;
+    double minTime = 0.5;
+    bool csv = false;
+    for (int i = 1; i < argc; i++) {
+        if (const char* v = internal::optionValue(argv[i], "--filter=")) {
+            filter = v;
+        }
+        else if (const char* v = internal::optionValue(argv[i], "--min_time=")) {
+            minTime = std::atof(v);
+        }
+        else if (const char* v = internal::optionValue(argv[i], "--format=")) {
+            csv = std::strcmp(v, "csv") == 0;
+        }
+        else {
+            std::fprintf(stderr, "unknown option %s\n", argv[i]);
+            return 1;
+        }
+    }
+
+    if (csv) {
+        std::printf("name,iterations,ns_per_iter,items_per_s,label\n");
+    }
+    else {
+        std::printf("%-48s %12s %14s %14s\n", "Benchmark", "Iterations", "ns/iter", "items/s");
+    }
+    for (const auto& bm : internal::registry()) {
+        for (const auto& args : bm->argSets()) {
+            std::string name = bm->name();
+            for (int64_t a : args) {
+                name += "/" + std::to_string(a);
+            }
+            if (!filter.empty() && name.find(filter) == std::string::npos) {
+                continue;
+            }
+            uint64_t iterations = 1;
+            double elapsed = 0;
+            State state(iterations, args);
+            while (true) {
+                state = State(iterations, args);
+                bm->run(state);
+                elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - state.startTime()).count();
+                if (elapsed >= minTime || iterations >= (uint64_t(1) << 40)) {
+                    break;
+                }
+                // aim a bit past minTime, but never grow more than 10x per round
+                double scale = elapsed > 0 ? minTime * 1.4 / elapsed : 10;
+                iterations = std::max<uint64_t>(iterations + 1, iterations * std::min(scale, 10.0));
+            }
+            double nsPerIter = elapsed * 1e9 / iterations;
+            double itemsPerSec = state.items_processed() > 0 ? state.items_processed() / elapsed : 0;
+            if (csv) {
+                std::printf("%s,%llu,%.3f,%.1f,%s\n", name.c_str(), (unsigned long long)iterations,
+                            nsPerIter, itemsPerSec, state.label().c_str());
+            }
+            else {
+                std::printf("%-48s %12llu %14.1f %14.4g %s\n", name.c_str(), (unsigned long long)iterations,
+                            nsPerIter, itemsPerSec, state.label().c_str());
+            }
+        }
+    }
+    return 0;
+}
+
+} // namespace benchmark
+
+#define BENCHMARK_CONCAT_(a, b) a##b
+#define BENCHMARK_CONCAT(a, b) BENCHMARK_CONCAT_(a, b)
+
+#define BENCHMARK(fn)                                                              \
+    static ::benchmark::internal::Benchmark* BENCHMARK_CONCAT(benchmark_, __LINE__) \
+        = ::benchmark::internal::registerBenchmark(#fn, fn)
+
+#define BENCHMARK_MAIN()                                          \
+    int main(int argc, char** argv) {                             \
+        return ::benchmark::RunSpecifiedBenchmarks(argc, argv);   \
+    }
+
+#endif // MICRO_BENCHMARK_HPP
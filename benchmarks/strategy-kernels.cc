@@ -0,0 +1,172 @@
+#include "micro-benchmark.hpp"
+#include "vanet-kernels.hpp"
+
+#include <random>
+#include <utility>
+#include <vector>
+
+// 各转发策略计算内核的微基准测试，节点规模与test/benchmark.py的场景一致
+// 运行: ./waf --run "strategy-kernels --filter=TOPSIS --min_time=1"
+
+namespace {
+
+namespace vanet = nfd::fw::vanet;
+
+const double RTH = 200.0;
+const int CONTENT_NUM = 50;
+const int CACHE_SIZE = 20;
+
+struct Vehicle {
+    ns3::Vector position;
+    ns3::Vector velocity;
+};
+
+/* 与benchmark.py相同的高速公路: 20车/km, 4车道, 20-33m/s, 前两车道向东 */
+std::vector<Vehicle>
+makeHighway(size_t num, uint32_t seed = 1) {
+    std::mt19937 rng(seed);
+    double length = std::max(1000.0, num / 20.0 * 1000.0);
+    std::uniform_real_distribution<double> x(0, length);
+    std::uniform_real_distribution<double> speed(20.0, 33.0);
+    std::vector<Vehicle> vehicles;
+    vehicles.reserve(num);
+    for (size_t i = 0; i < num; i++) {
+        int lane = i % 4;
+        double v = lane < 2 ? speed(rng) : -speed(rng);
+        vehicles.push_back({ { x(rng), lane * 4.0, 0.0 }, { v, 0.0, 0.0 } });
+    }
+    return vehicles;
+}
+
+/* 与节点i在通信范围内的全部邻居，模拟一次广播的候选集合 */
+std::vector<size_t>
+neighborsOf(const std::vector<Vehicle>& vehicles, size_t i) {
+    std::vector<size_t> neighbors;
+    for (size_t j = 0; j < vehicles.size(); j++) {
+        if (j != i && ns3::CalculateDistance(vehicles[i].position, vehicles[j].position) < RTH) {
+            neighbors.push_back(j);
+        }
+    }
+    return neighbors;
+}
+
+void
+BM_LinkExpirationTime(benchmark::State& state) {
+    auto vehicles = makeHighway(state.range(0));
+    auto neighbors = neighborsOf(vehicles, 0);
+    for (auto _ : state) {
+        for (size_t j : neighbors) {
+            benchmark::DoNotOptimize(vanet::linkExpirationTime(vehicles[0].position, vehicles[0].velocity,
+                                                               vehicles[j].position, vehicles[j].velocity, RTH));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * neighbors.size());
+    state.SetLabel(std::to_string(neighbors.size()) + " neighbors");
+}
+BENCHMARK(BM_LinkExpirationTime)->Arg(60)->Arg(500)->Arg(2000);
+
+void
+BM_LinkAvailabilityProbability(benchmark::State& state) {
+    std::vector<double> lets;
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<double> let(0, 20);
+    for (int i = 0; i < 1024; i++) {
+        lets.push_back(let(rng));
+    }
+    for (auto _ : state) {
+        for (double t : lets) {
+            benchmark::DoNotOptimize(vanet::linkAvailabilityProbability(t, 2.0));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * lets.size());
+}
+BENCHMARK(BM_LinkAvailabilityProbability);
+
+void
+BM_RoadDistance(benchmark::State& state) {
+    auto vehicles = makeHighway(state.range(0));
+    auto neighbors = neighborsOf(vehicles, 0);
+    for (auto _ : state) {
+        for (size_t j : neighbors) {
+            double d = ns3::CalculateDistance(vehicles[0].position, vehicles[j].position) + 0.0001;
+            benchmark::DoNotOptimize(vanet::roadDistance(vehicles[0].position, vehicles[j].position, d));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * neighbors.size());
+}
+BENCHMARK(BM_RoadDistance)->Arg(60)->Arg(2000);
+
+/* OPT/CCAF selectFIB中的完整TOPSIS决策: 归一化 + 正负理想解 + 贴近度 */
+void
+BM_TOPSIS(benchmark::State& state) {
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<double> dr(0, RTH);
+    std::uniform_real_distribution<double> unit(0, 1);
+    std::vector<vanet::FaceStats> faceList;
+    for (int64_t i = 0; i < state.range(0); i++) {
+        faceList.emplace_back(nullptr, dr(rng), unit(rng), unit(rng));
+    }
+    for (auto _ : state) {
+        auto normalized = vanet::topsisNormalize(faceList);
+        benchmark::DoNotOptimize(vanet::topsisOptimalIndex(normalized));
+    }
+    state.SetItemsProcessed(state.iterations() * faceList.size());
+}
+BENCHMARK(BM_TOPSIS)->RangeMultiplier(2)->Range(2, 128);
+
+/* CCAF::cachePrediction，clt为按最近请求时间排序的CLT表 */
+void
+BM_CachePrediction(benchmark::State& state) {
+    struct Rate {
+        double rate;
+    };
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<double> rate(0.01, 10);
+    std::vector<std::pair<int, Rate>> clt;
+    for (int64_t i = 0; i < state.range(0); i++) {
+        clt.push_back({ int(i), { rate(rng) } });
+    }
+    for (auto _ : state) {
+        // 同时覆盖 order <= CACHE_SIZE 与 order > CACHE_SIZE 两种情况
+        for (int order = 1; order <= int(clt.size()); order++) {
+            benchmark::DoNotOptimize(vanet::predictCacheHit(clt, order, 0.7, CACHE_SIZE, CONTENT_NUM));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * clt.size());
+}
+BENCHMARK(BM_CachePrediction)->Arg(10)->Arg(CONTENT_NUM)->Arg(1000);
+
+/* DASB: 对等待表中每个条目判断是否处于抑制区域 */
+void
+BM_IsInSuppressRegion(benchmark::State& state) {
+    auto vehicles = makeHighway(state.range(0));
+    auto neighbors = neighborsOf(vehicles, 0);
+    size_t receiver = neighbors.empty() ? 0 : neighbors.front();
+    for (auto _ : state) {
+        for (size_t j : neighbors) {
+            benchmark::DoNotOptimize(vanet::isInSuppressRegion(vehicles[0].position, vehicles[receiver].position,
+                                                               vehicles[j].position, M_PI / 6));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * neighbors.size());
+}
+BENCHMARK(BM_IsInSuppressRegion)->Arg(60)->Arg(2000);
+
+/* MUPF::calculateDensity，每次调用都遍历全部节点对 */
+void
+BM_TrafficDensity(benchmark::State& state) {
+    auto vehicles = makeHighway(state.range(0));
+    std::vector<ns3::Vector> positions;
+    for (const auto& v : vehicles) {
+        positions.push_back(v.position);
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(vanet::trafficDensity(positions, 0, RTH));
+    }
+    state.SetItemsProcessed(state.iterations() * positions.size() * positions.size());
+}
+BENCHMARK(BM_TrafficDensity)->Arg(60)->Arg(120)->Arg(250)->Arg(500)->Arg(1000)->Arg(2000);
+
+} // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,234 @@
+#include "airtime-report.hpp"
+
+#include "ndn-frame.hpp"
+
+#include "ns3/log.h"
+#include "ns3/mobility-model.h"
+#include "ns3/node-list.h"
+#include "ns3/node.h"
+#include "ns3/packet.h"
+#include "ns3/simulator.h"
+#include "ns3/wifi-net-device.h"
+#include "ns3/wifi-phy-state-helper.h"
+#include "ns3/wifi-phy.h"
+
+#include <cmath>
+
+NS_LOG_COMPONENT_DEFINE("AirtimeReport");
+
+namespace ns3 {
+
+namespace {
+
+void
+accumulate(AirtimeReport::Usage& target, const AirtimeReport::Usage& usage) {
+    target.time += usage.time;
+    target.tx += usage.tx;
+    target.rx += usage.rx;
+    target.ccaBusy += usage.ccaBusy;
+    target.collisions += usage.collisions;
+    for (int type = 0; type < AirtimeReport::N_PACKET_TYPES; type++) {
+        target.txByType[type] += usage.txByType[type];
+    }
+}
+
+}  // namespace
+
+AirtimeReport::Usage AirtimeReport::s_totals;
+
+AirtimeReport::AirtimeReport(const std::string& path, Time interval, double regionSize)
+    : m_path(path), m_interval(interval), m_regionSize(regionSize) {}
+
+const char* AirtimeReport::GetPacketTypeName(PacketType type) {
+    switch (type) {
+    case INTEREST:
+        return "interest";
+    case DATA:
+        return "data";
+    case BEACON:
+        return "beacon";
+    default:
+        return "other";
+    }
+}
+
+void AirtimeReport::Start() {
+    if (!IsEnabled()) {
+        return;
+    }
+    m_os.open(m_path);
+    if (!m_os) {
+        NS_LOG_ERROR("cannot write airtime report to " << m_path);
+        m_path.clear();
+        return;
+    }
+    m_os << "time_s,region,node_s,tx_s,rx_s,cca_busy_s,busy_share,collisions";
+    for (int type = 0; type < N_PACKET_TYPES; type++) {
+        m_os << "," << GetPacketTypeName(PacketType(type)) << "_tx_s";
+    }
+    m_os << "\n";
+
+    s_totals = Usage();
+    m_start = Simulator::Now();
+    m_mobility.assign(NodeList::GetNNodes(), nullptr);
+    m_txType.assign(NodeList::GetNNodes(), OTHER);
+    m_nodes.assign(NodeList::GetNNodes(), Usage());
+    uint32_t phys = 0;
+    for (uint32_t i = 0; i < NodeList::GetNNodes(); i++) {
+        Ptr<Node> node = NodeList::GetNode(i);
+        m_mobility[i] = node->GetObject<MobilityModel>();
+        for (uint32_t j = 0; j < node->GetNDevices(); j++) {
+            Ptr<WifiNetDevice> device = DynamicCast<WifiNetDevice>(node->GetDevice(j));
+            if (device == nullptr || device->GetPhy() == nullptr) {
+                continue;
+            }
+            Ptr<WifiPhyStateHelper> state = device->GetPhy()->GetState();
+            state->TraceConnectWithoutContext("State", MakeBoundCallback(&AirtimeReport::StateTrace, this, i));
+            state->TraceConnectWithoutContext("Tx", MakeBoundCallback(&AirtimeReport::TxTrace, this, i));
+            state->TraceConnectWithoutContext("RxError", MakeBoundCallback(&AirtimeReport::RxErrorTrace, this, i));
+            phys++;
+        }
+    }
+    if (phys == 0) {
+        NS_LOG_WARN("no WifiNetDevice found, the airtime report stays empty");
+    }
+    if (m_interval.IsStrictlyPositive()) {
+        m_event = Simulator::Schedule(m_interval, &AirtimeReport::DoSample, this);
+    }
+}
+
+void AirtimeReport::Finish() {
+    if (!IsEnabled()) {
+        return;
+    }
+    Simulator::Cancel(m_event);
+    WriteInterval();
+
+    double elapsed = (Simulator::Now() - m_start).GetSeconds();
+    std::ofstream nodes(m_path + ".nodes.csv");
+    nodes << "node,tx_share,rx_share,cca_busy_share,collisions";
+    for (int type = 0; type < N_PACKET_TYPES; type++) {
+        nodes << "," << GetPacketTypeName(PacketType(type)) << "_tx_s";
+    }
+    nodes << "\n";
+    for (uint32_t i = 0; i < m_nodes.size(); i++) {
+        const Usage& usage = m_nodes[i];
+        nodes << i << "," << (elapsed > 0 ? usage.tx / elapsed : 0) << "," << (elapsed > 0 ? usage.rx / elapsed : 0)
+              << "," << (elapsed > 0 ? usage.ccaBusy / elapsed : 0) << "," << usage.collisions;
+        for (double seconds : usage.txByType) {
+            nodes << "," << seconds;
+        }
+        nodes << "\n";
+    }
+
+    std::ofstream regions(m_path + ".regions.csv");
+    regions << "region_x,region_y,node_s,tx_share,rx_share,cca_busy_share,collisions";
+    for (int type = 0; type < N_PACKET_TYPES; type++) {
+        regions << "," << GetPacketTypeName(PacketType(type)) << "_tx_s";
+    }
+    regions << "\n";
+    for (const auto& item : m_regions) {
+        const Usage& usage = item.second;
+        double time = usage.time > 0 ? usage.time : 1;
+        regions << item.first.first * m_regionSize << "," << item.first.second * m_regionSize << "," << usage.time
+                << "," << usage.tx / time << "," << usage.rx / time << "," << usage.ccaBusy / time << ","
+                << usage.collisions;
+        for (double seconds : usage.txByType) {
+            regions << "," << seconds;
+        }
+        regions << "\n";
+    }
+    NS_LOG_INFO("airtime report written to " << m_path);
+}
+
+void AirtimeReport::StateTrace(AirtimeReport* report, uint32_t node, Time start, Time duration, WifiPhyState state) {
+    Usage usage;
+    usage.time = duration.GetSeconds();
+    switch (state) {
+    case WifiPhyState::TX:
+        usage.tx = usage.time;
+        usage.txByType[report->m_txType[node]] = usage.time;
+        report->m_txType[node] = OTHER;
+        break;
+    case WifiPhyState::RX:
+        usage.rx = usage.time;
+        break;
+    case WifiPhyState::CCA_BUSY:
+        usage.ccaBusy = usage.time;
+        break;
+    default:
+        break;
+    }
+    report->Add(node, usage);
+}
+
+void AirtimeReport::TxTrace(AirtimeReport* report, uint32_t node, Ptr<const Packet> packet, WifiMode mode,
+                            WifiPreamble preamble, uint8_t power) {
+    // the PHY reports the TX state of this frame right after this trace
+    report->m_txType[node] = Classify(packet);
+}
+
+void AirtimeReport::RxErrorTrace(AirtimeReport* report, uint32_t node, Ptr<const Packet> packet, double snr) {
+    Usage usage;
+    usage.collisions = 1;
+    report->Add(node, usage);
+}
+
+AirtimeReport::PacketType AirtimeReport::Classify(Ptr<const Packet> packet) {
+    switch (NdnFrame::FromWifi(packet).kind) {
+    case NdnFrame::INTEREST:
+        return INTEREST;
+    case NdnFrame::DATA:
+        return DATA;
+    case NdnFrame::BEACON:
+        return BEACON;
+    default:
+        return OTHER;
+    }
+}
+
+AirtimeReport::Region AirtimeReport::GetRegion(uint32_t node) const {
+    if (m_mobility[node] == nullptr) {
+        return Region(0, 0);
+    }
+    Vector position = m_mobility[node]->GetPosition();
+    return Region(int32_t(std::floor(position.x / m_regionSize)), int32_t(std::floor(position.y / m_regionSize)));
+}
+
+void AirtimeReport::Add(uint32_t node, const Usage& usage) {
+    Region region = GetRegion(node);
+    accumulate(m_nodes[node], usage);
+    accumulate(m_regions[region], usage);
+    accumulate(m_window[region], usage);
+    accumulate(s_totals, usage);
+}
+
+void AirtimeReport::DoSample() {
+    WriteInterval();
+    m_event = Simulator::Schedule(m_interval, &AirtimeReport::DoSample, this);
+}
+
+void AirtimeReport::WriteInterval() {
+    Usage all;
+    double now = Simulator::Now().GetSeconds();
+    auto write = [&](const std::string& name, const Usage& usage) {
+        m_os << now << "," << name << "," << usage.time << "," << usage.tx << "," << usage.rx << ","
+             << usage.ccaBusy << "," << (usage.time > 0 ? (usage.tx + usage.rx + usage.ccaBusy) / usage.time : 0)
+             << "," << usage.collisions;
+        for (double seconds : usage.txByType) {
+            m_os << "," << seconds;
+        }
+        m_os << "\n";
+    };
+    for (const auto& item : m_window) {
+        const Usage& usage = item.second;
+        write(std::to_string(int64_t(item.first.first * m_regionSize)) + ":" +
+                  std::to_string(int64_t(item.first.second * m_regionSize)),
+              usage);
+        accumulate(all, usage);
+    }
+    write("all", all);
+    m_window.clear();
+}
+
+}  // namespace ns3
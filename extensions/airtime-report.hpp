@@ -0,0 +1,115 @@
+#ifndef AIRTIME_REPORT_HPP
+#define AIRTIME_REPORT_HPP
+
+#include "ns3/event-id.h"
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+#include "ns3/wifi-mode.h"
+#include "ns3/wifi-phy-state.h"
+#include "ns3/wifi-preamble.h"
+
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ns3 {
+
+class MobilityModel;
+class Packet;
+
+/**
+ * \brief accounts the channel time every 802.11p PHY spends transmitting,
+ *        receiving and sensing the medium busy
+ *
+ * Connects to the State, Tx and RxError traces of the WifiPhyStateHelper
+ * of every WifiNetDevice. Each reported PHY state period is added to its
+ * node and to the square region of RegionSize meters the node is in when
+ * the PHY reports it. A TX period is further split by the frame being
+ * sent: Interest or Data (read from the NDNLPv2 fragment), beacon (by
+ * BeaconApp::PROTOCOL) or other (MAC control, non-first fragments). An RX
+ * that ends in a decoding failure counts as a collision.
+ *
+ * Every interval one CSV row per region, plus an "all" row, is written to
+ * the given path; at the end the per-node fractions go to path +
+ * ".nodes.csv" and the per-region totals to path + ".regions.csv". The
+ * network totals are also kept for RunReport. A period is attributed to
+ * the interval in which the PHY reports it, which for IDLE and CCA_BUSY is
+ * its end. Unit-disk devices have no PHY states and are not counted.
+ * Nothing is measured when the path is empty.
+ */
+class AirtimeReport {
+  public:
+    enum PacketType { INTEREST, DATA, BEACON, OTHER, N_PACKET_TYPES };
+
+    struct Usage {
+        double time = 0;     ///< seconds covered by reported PHY states
+        double tx = 0;
+        double rx = 0;
+        double ccaBusy = 0;
+        uint64_t collisions = 0;
+        std::array<double, N_PACKET_TYPES> txByType{};
+    };
+
+    AirtimeReport(const std::string& path, Time interval, double regionSize = 200);
+
+    bool IsEnabled() const { return !m_path.empty(); }
+
+    /** \brief call right before Simulator::Run(), after the devices are installed
+     */
+    void Start();
+
+    /** \brief call right after Simulator::Run() and before Simulator::Destroy()
+     */
+    void Finish();
+
+    /** \return the totals over all nodes of the running report, read by RunReport
+     */
+    static const Usage& GetTotals() { return s_totals; }
+
+    static const char* GetPacketTypeName(PacketType type);
+
+  private:
+    using Region = std::pair<int32_t, int32_t>;
+
+    static void StateTrace(AirtimeReport* report, uint32_t node, Time start, Time duration, WifiPhyState state);
+
+    static void TxTrace(AirtimeReport* report, uint32_t node, Ptr<const Packet> packet, WifiMode mode,
+                        WifiPreamble preamble, uint8_t power);
+
+    static void RxErrorTrace(AirtimeReport* report, uint32_t node, Ptr<const Packet> packet, double snr);
+
+    /** \return the type of the NDN, beacon or control frame as passed to the PHY
+     */
+    static PacketType Classify(Ptr<const Packet> packet);
+
+    Region GetRegion(uint32_t node) const;
+
+    void Add(uint32_t node, const Usage& usage);
+
+    void DoSample();
+
+    void WriteInterval();
+
+  private:
+    std::string m_path;
+    Time m_interval;
+    double m_regionSize;
+    Time m_start;
+    std::ofstream m_os;
+    EventId m_event;
+    std::vector<Ptr<MobilityModel>> m_mobility;
+    std::vector<PacketType> m_txType;  ///< per node, type of the frame announced by the last Tx trace
+    std::vector<Usage> m_nodes;
+    std::map<Region, Usage> m_regions;
+    std::map<Region, Usage> m_window;
+
+    static Usage s_totals;
+};
+
+}  // namespace ns3
+
+#endif  // AIRTIME_REPORT_HPP
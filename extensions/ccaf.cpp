@@ -32,15 +32,18 @@ namespace nfd {
 
             CCAF::CCAF(Forwarder& forwarder, const Name& name)
                 : Strategy(forwarder),
-                m_nodes(ns3::NodeContainer::GetGlobal()),
+                m_nodes(ns3::ndn::NodeRegistry::Get()),
                 m_measurements(getMeasurements()),
                 m_retxSuppression(RETX_SUPPRESSION_INITIAL,
                     RetxSuppressionExponential::DEFAULT_MULTIPLIER,
                     RETX_SUPPRESSION_MAX) {
                 ParsedInstanceName parsed = parseInstanceName(name);
-                if (!parsed.parameters.empty()) {
-                    NDN_THROW(std::invalid_argument("CCAF does not accept parameters"));
-                }
+                StrategyParameters params("CCAF", parsed.parameters);
+                m_Pth = params.get("pth", Pth);
+                m_T = params.get("t", T);
+                m_cacheSize = static_cast<int>(params.get("cache-size", CACHE_SIZE));
+                m_predictionGranularity = params.get("prediction-granularity", 0.0);
+                params.checkUnused();
                 if (parsed.version &&
                     *parsed.version != getStrategyName()[-1].toVersion()) {
                     NDN_THROW(std::invalid_argument("CCAF does not support version " +
@@ -58,14 +61,13 @@ namespace nfd {
             void CCAF::afterReceiveInterest(const FaceEndpoint& ingress,
                 const Interest& interest,
                 const shared_ptr<pit::Entry>& pitEntry) {
+                STRATEGY_PROFILE("CCAF");
                 const fib::Entry& fibEntry = this->lookupFib(*pitEntry);
                 const Name prefix = fibEntry.getPrefix();
-                const fib::NextHopList& nexthops = fibEntry.getNextHops();
                 ns3::Ptr<ns3::Node> localNode = getNode(*this);
                 std::set<ns3::Ptr<ns3::Node>> sources = this->getContentSources(interest);
-                std::set<Face*> candidates = this->getCandidateForwarders(nexthops, localNode, sources);
 
-                auto it = this->selectFIB(localNode, interest, candidates, fibEntry);
+                auto it = this->selectEgress(localNode, interest, sources, fibEntry);
                 if (it == nullptr) {
                     // NFD_LOG_DEBUG("No Next Hop!");
                     return;
@@ -90,6 +92,7 @@ namespace nfd {
             void
                 CCAF::beforeSatisfyInterest(const shared_ptr<pit::Entry>& pitEntry,
                     const FaceEndpoint& ingress, const Data& data) {
+                STRATEGY_PROFILE("CCAF");
 
                 // NFD_LOG_DEBUG("beforeSatisfyInterest pitEntry=" << pitEntry->getName()
                 //             << " in=" << ingress << " data=" << data.getName());
@@ -126,6 +129,7 @@ namespace nfd {
             void
                 CCAF::afterContentStoreHit(const shared_ptr<pit::Entry>& pitEntry,
                     const FaceEndpoint& ingress, const Data& data) {
+                STRATEGY_PROFILE("CCAF");
                 // NFD_LOG_DEBUG("afterContentStoreHit pitEntry=" << pitEntry->getName()
                 //             << " in=" << ingress << " data=" << data.getName());
 
@@ -136,6 +140,7 @@ namespace nfd {
             void
                 CCAF::afterReceiveData(const shared_ptr<pit::Entry>& pitEntry,
                     const FaceEndpoint& ingress, const Data& data) {
+                STRATEGY_PROFILE("CCAF");
                 this->beforeSatisfyInterest(pitEntry, ingress, data);
                 // NFD_LOG_DEBUG("afterReceiveData pitEntry=" << pitEntry->getName()
                 //             << " in=" << ingress << " data=" << data.getName());
@@ -173,7 +178,7 @@ namespace nfd {
                     double prob = cachePrediction(node, interest.getName(), time);
 
                     bool isCached = false;
-                    ns3::Ptr<ns3::ndn::L3Protocol> ndn = node->GetObject<ns3::ndn::L3Protocol>();
+                    ns3::ndn::L3Protocol* ndn = m_nodes.GetL3(node->GetId());
                     ndn::Name name = interest.getName();
                     nfd::cs::Cs& cs = ndn->getForwarder()->getCs();
                     for (const auto& entry : cs) {
@@ -183,11 +188,11 @@ namespace nfd {
                         }
                     }
 
-                    if (prob > Pth) {
+                    if (prob > m_Pth) {
                         sources.emplace(node);
                     }
-                    if (time>T) {
-                        if ( (isCached && prob>Pth) || (!isCached && prob<Pth) ) {
+                    if (time>m_T) {
+                        if ( (isCached && prob>m_Pth) || (!isCached && prob<m_Pth) ) {
                             cout<<"Cache Prediction True"<<endl;
                         }
                         else {
@@ -198,8 +203,34 @@ namespace nfd {
                 return sources;
             }
 
+            Face*
+                CCAF::selectEgress(ns3::Ptr<ns3::Node> localNode, const Interest& interest, const std::set<ns3::Ptr<ns3::Node>>& sources, const fib::Entry& fibEntry) {
+                // 相同前缀和内容源集合的决策在一个移动周期内复用, 候选的SISR/SRTT变化超过阈值时重新计算
+                // 每个Interest只查找一次测量表, 不创建表项也不延长寿命, 结果也传给selectFIB
+                const NamespaceInfo* namespaceInfo = m_measurements.findNamespaceInfo(fibEntry, interest);
+                auto now = time::steady_clock::now();
+                return m_decisionCache.select(fibEntry.getPrefix(), sources, now,
+                    [&] (FaceId faceId, double& sisr, double& srtt) { isr::IsrMeasurements::measureFace(namespaceInfo, faceId, now, sisr, srtt); },
+                    [&] (std::vector<DecisionCache::Candidate>* snapshot) {
+                        std::set<Face*> candidates = this->getCandidateForwarders(fibEntry.getNextHops(), localNode, sources);
+                        return this->selectFIB(localNode, candidates, namespaceInfo, snapshot);
+                    },
+                    [this] (FaceId faceId) { return this->getFace(faceId); });
+            }
+
             std::set<Face*>
                 CCAF::getCandidateForwarders(const fib::NextHopList& nexthops, ns3::Ptr<ns3::Node> curNode, std::set<ns3::Ptr<ns3::Node>> srcNodes) {
+                // 安装了信标时只遍历邻居, 不再遍历FIB中的所有Face
+                if (!srcNodes.empty() && this->updateNeighborTable(curNode)) {
+                    // Directly return App Face if it is Producer;
+                    for (auto& nexthop : nexthops) {
+                        if (nexthop.getFace().getId() == 256 + m_nodes.GetN()) {
+                            return std::set<Face*>{&nexthop.getFace()};
+                        }
+                    }
+                    return ns3::ndn::NeighborTable::SelectRelays(m_NT, curNode, srcNodes, Rth,
+                        [&] (uint32_t nodeId) { return this->getFace(256 + nodeId + (nodeId < curNode->GetId())); });
+                }
                 std::set<Face*> inRegionSrcs;
                 std::set<Face*> candidateForwarders;
                 for (auto& srcNode : srcNodes) {
@@ -232,9 +263,23 @@ namespace nfd {
                 return inRegionSrcs.size() > 0 ? inRegionSrcs : candidateForwarders;
             }
 
+            bool
+                CCAF::updateNeighborTable(ns3::Ptr<ns3::Node> localNode) {
+                if (m_neighborTable == nullptr) {
+                    m_neighborTable = ns3::PeekPointer(localNode->GetObject<ns3::ndn::NeighborTable>());
+                    if (m_neighborTable == nullptr) {
+                        return false;
+                    }
+                }
+                m_neighborTable->GetLinks(localNode, Rth, m_NT);
+                return true;
+            }
+
             Face*
-                CCAF::selectFIB(ns3::Ptr<ns3::Node> localNode, const Interest& interest, std::set<Face*> candidateForwarders, const fib::Entry& fibEntry) {
+                CCAF::selectFIB(ns3::Ptr<ns3::Node> localNode, std::set<Face*> candidateForwarders, const NamespaceInfo* namespaceInfo,
+                    std::vector<DecisionCache::Candidate>* snapshot) {
                 std::vector<FaceStats> faceList;
+                auto now = time::steady_clock::now();
                 for (auto& face : candidateForwarders) {
                     if (face->getId() == 256 + m_nodes.GetN()) {
                         return face;
@@ -242,16 +287,12 @@ namespace nfd {
                     uint32_t nodeId = (face->getId() - 257) + (localNode->GetId() + 257 <= face->getId());
                     // double distance = this->calculateDistance(localNode, m_nodes[nodeId]);
                     double distance = this->caculateDR(localNode, m_nodes[nodeId]);
-                    FaceInfo* info = m_measurements.getFaceInfo(fibEntry, interest, face->getId());
-                    if (info == nullptr) {
-                        faceList.push_back({ face, distance, 0, 0 });
-                        // NFD_LOG_DEBUG("Face="<<face->getId()<<" has no Info");
-                    }
-                    else {
-                        double sisr = info->getSmoothedISR();
-                        double srtt = 10 - boost::chrono::duration_cast<boost::chrono::duration<double>>(info->getSrtt()).count(); // 正向化处理SRTT指标
-                        faceList.push_back({ face, distance, sisr, srtt });
-                        // NFD_LOG_DEBUG("Face=" << face->getId() << ", Distance=" << distance << ", SISR=" << sisr << ", SRTT=" << srtt);
+                    double sisr = 0, srtt = 0;
+                    isr::IsrMeasurements::measureFace(namespaceInfo, face->getId(), now, sisr, srtt);
+                    faceList.push_back({ face, distance, sisr, srtt });
+                    // NFD_LOG_DEBUG("Face=" << face->getId() << ", Distance=" << distance << ", SISR=" << sisr << ", SRTT=" << srtt);
+                    if (snapshot != nullptr) {
+                        snapshot->push_back({ face->getId(), sisr, srtt });
                     }
                 }
 
@@ -269,83 +310,27 @@ namespace nfd {
 
             std::vector<CCAF::FaceStats>
                 CCAF::customNormalize(std::vector<FaceStats>& faceList) {
-                double letSum = 0, lapSum = 0, srttSum = 0;
-                std::vector<FaceStats> normalizedFaceList;
-                for (const auto& faceStats : faceList) {
-                    letSum += pow(faceStats.distance, 2);
-                    lapSum += pow(faceStats.sisr, 2);
-                    srttSum += pow(faceStats.srtt, 2);
-                }
-                for (auto& faceStats : faceList) {
-                    Face* face = faceStats.face;
-                    double let = letSum > 0 ? 1.0 / 3.0 * faceStats.distance / sqrt(letSum) : 0;
-                    double lap = lapSum > 0 ? 1.0 / 3.0 * faceStats.sisr / sqrt(lapSum) : 0;
-                    double srtt = srttSum > 0 ? 1.0 / 3.0 * faceStats.srtt / sqrt(srttSum) : 0;
-                    normalizedFaceList.push_back({ face, let, lap, srtt });
-                    // NFD_LOG_DEBUG("Face="<<face->getId()<<", nor_Distance="<<let<<", nor_SISR="<<lap<<", nor_SRTT="<<srtt);
-                }
-                return normalizedFaceList;
+                return vanet::topsisNormalize(faceList);
             }
 
             CCAF::FaceStats
                 CCAF::calculateIdealSolution(std::vector<FaceStats>& faceList) {
-                FaceStats idealSolution(
-                    faceList[0].face, // 使用第一个节点作为默认值
-                    (std::max_element(faceList.begin(), faceList.end(), [](const auto& a, const auto& b) { return a.distance < b.distance; }))
-                    ->distance,
-                    (std::max_element(faceList.begin(), faceList.end(), [](const auto& a, const auto& b) { return a.sisr < b.sisr; }))
-                    ->sisr,
-                    (std::max_element(faceList.begin(), faceList.end(), [](const auto& a, const auto& b) { return a.srtt < b.srtt; }))
-                    ->srtt);
-                // NFD_LOG_DEBUG("Ideal: D="<<idealSolution.distance<<", SISR="<<idealSolution.sisr<<", SRTT="<<idealSolution.srtt);
-                return idealSolution;
+                return vanet::topsisIdealSolution(faceList);
             }
 
             CCAF::FaceStats
                 CCAF::calculateNegativeIdealSolution(std::vector<FaceStats>& faceList) {
-                FaceStats negativeIdealSolution(
-                    faceList[0].face, // 使用第一个节点作为默认值
-                    (std::min_element(faceList.begin(), faceList.end(), [](const auto& a, const auto& b) { return a.distance < b.distance; }))
-                    ->distance,
-                    (std::min_element(faceList.begin(), faceList.end(), [](const auto& a, const auto& b) { return a.sisr < b.sisr; }))
-                    ->sisr,
-                    (std::min_element(faceList.begin(), faceList.end(), [](const auto& a, const auto& b) { return a.srtt < b.srtt; }))
-                    ->srtt);
-                // NFD_LOG_DEBUG("Neg: D=" << negativeIdealSolution.distance << ", SISR=" << negativeIdealSolution.sisr << ", SRTT=" << negativeIdealSolution.srtt);
-                return negativeIdealSolution;
+                return vanet::topsisNegativeIdealSolution(faceList);
             }
 
             double
                 CCAF::calculateCloseness(const CCAF::FaceStats& entry, const CCAF::FaceStats& idealSolution, const CCAF::FaceStats& negativeIdealSolution) {
-                double distanceIdealDeviation = entry.distance - idealSolution.distance;
-                double relativeVelIdealDeviation = entry.sisr - idealSolution.sisr;
-                double LETIdealDeviation = entry.srtt - idealSolution.srtt;
-                double closenessToIdeal = sqrt(pow(distanceIdealDeviation, 2) + pow(relativeVelIdealDeviation, 2) + pow(LETIdealDeviation, 2));
-                // NFD_LOG_DEBUG("disToIdeal="<<distanceIdealDeviation<<", velToIdeal="<<relativeVelIdealDeviation<<", letIdeal="<<LETIdealDeviation<<" clossToIdeal="<<closenessToIdeal);
-
-                double distanceNegDeviation = entry.distance - negativeIdealSolution.distance;
-                double relativeVelNegDeviation = entry.sisr - negativeIdealSolution.sisr;
-                double LETNegDeviation = entry.srtt - negativeIdealSolution.srtt;
-                double closenessToNeg = sqrt(pow(distanceNegDeviation, 2) + pow(relativeVelNegDeviation, 2) + pow(LETNegDeviation, 2));
-                // NFD_LOG_DEBUG("disToNeg="<<distanceNegDeviation<<", velToIdeal="<<relativeVelNegDeviation<<", letIdeal="<<LETNegDeviation<<" clossToIdeal="<<closenessToNeg);
-
-                double closeness = closenessToNeg / (closenessToIdeal + closenessToNeg);
-                // NFD_LOG_DEBUG("node="<<entry.node->GetId()<<", closeness="<<closeness);
-
-                return closeness;
+                return vanet::topsisCloseness(entry, idealSolution, negativeIdealSolution);
             }
 
             CCAF::FaceStats&
                 CCAF::getOptimalDecision(std::vector<CCAF::FaceStats>& faceList) {
-                std::vector<double> closenessValues;
-                FaceStats idealSolution = this->calculateIdealSolution(faceList);
-                FaceStats negIdealSolution = this->calculateNegativeIdealSolution(faceList);
-                for (const auto& entry : faceList) {
-                    double closeness = this->calculateCloseness(entry, idealSolution, negIdealSolution);
-                    closenessValues.push_back(closeness);
-                }
-                size_t optIndex = std::distance(closenessValues.begin(), std::max_element(closenessValues.begin(), closenessValues.end()));
-                FaceStats& optimalDecision = faceList[optIndex];
+                FaceStats& optimalDecision = faceList[vanet::topsisOptimalIndex(faceList)];
                 // NFD_LOG_DEBUG("Optimal Decision = " << optimalDecision.face->getId());
                 return optimalDecision;
             }
@@ -362,15 +347,9 @@ namespace nfd {
             double
                 CCAF::caculateDR(ns3::Ptr<ns3::Node> sendNode, ns3::Ptr<ns3::Node> receiveNode) {
                 double eculid = this->calculateDistance(sendNode, receiveNode);
-                ns3::Ptr<ns3::MobilityModel> mobility = sendNode->GetObject<ns3::MobilityModel>();
-                ns3::Vector3D nodePos = mobility->GetPosition();
-                ns3::Ptr<ns3::MobilityModel> remoteMob = receiveNode->GetObject<ns3::MobilityModel>();
-                ns3::Vector3D remotePos = remoteMob->GetPosition();
-                // ns3::Vector3D direction = remoteMob->GetVelocity();
-                ns3::Vector3D direction = { 1.0, 0.0, 0.0 };
-                double angle = std::atan2(direction.x, direction.y) - std::atan2(remotePos.x - nodePos.x, remotePos.y - nodePos.y);
-                double dr = abs(eculid * cos(angle));
-                return dr;
+                ns3::Vector3D nodePos = sendNode->GetObject<ns3::MobilityModel>()->GetPosition();
+                ns3::Vector3D remotePos = receiveNode->GetObject<ns3::MobilityModel>()->GetPosition();
+                return vanet::roadDistance(nodePos, remotePos, eculid);
             }
 
             double
@@ -378,20 +357,15 @@ namespace nfd {
                 ns3::Ptr<ns3::MobilityModel> mobility1 = sendNode->GetObject<ns3::MobilityModel>();
                 ns3::Ptr<ns3::MobilityModel> mobility2 = revNode->GetObject<ns3::MobilityModel>();
                 if (mobility1->GetDistanceFrom(mobility2) >= Rth) { return 0; }
-                double m = mobility1->GetPosition().x - mobility2->GetPosition().x;
-                double n = mobility1->GetPosition().y - mobility2->GetPosition().y;
-                double p = mobility1->GetVelocity().x - mobility2->GetVelocity().x;
-                double q = mobility1->GetVelocity().y - mobility2->GetVelocity().y;
-                if (p == 0 && q == 0) { return 1e6; } //相对速度为0时，用1e6表示无限大
-                double let = (-(m * p + n * q) + sqrt((pow(p, 2) + pow(q, 2)) * pow(Rth, 2) - pow(n * p - m * q, 2))) / (pow(p, 2) + pow(q, 2));
-                return let;
+                return vanet::linkExpirationTime(mobility1->GetPosition(), mobility1->GetVelocity(),
+                                                 mobility2->GetPosition(), mobility2->GetVelocity(), Rth);
             }
 
             ns3::Ptr<ns3::Node>
                 CCAF::getNode(CCAF& local_strategy) {
                 ns3::Ptr<ns3::Node> localNode;
                 for (const auto& node : m_nodes) {
-                    ns3::Ptr<ns3::ndn::L3Protocol> ndn = node->GetObject<ns3::ndn::L3Protocol>();
+                    ns3::ndn::L3Protocol* ndn = m_nodes.GetL3(node->GetId());
                     ndn::Name prefix("/ustc");
                     //此处有个坑：注册nfd时先是采用BestRouteStrategy2策略，其需要先发送set信息，因此需保证此时已经设置完毕策略
                     nfd::fw::Strategy& strategy = ndn->getForwarder()->getStrategyChoice().findEffectiveStrategy(prefix);
@@ -403,10 +377,11 @@ namespace nfd {
             }
 
             void CCAF::updateCLT(ndn::Name name, double time) {
-                auto it = find_if(m_CLT.begin(), m_CLT.end(), [&](auto& entry) { return entry.first == name; }); 
+                NameInterner::Id nameId = NameInterner::get().intern(name);
+                auto it = find_if(m_CLT.begin(), m_CLT.end(), [&](auto& entry) { return entry.first == nameId; }); 
                 if (it == m_CLT.end()) {
                     CCAF::CLT entry{1, time, 1.0/time, 1.0/m_ReqNums};
-                    std::pair<ndn::Name, CCAF::CLT> pairs(name, entry);
+                    std::pair<NameInterner::Id, CCAF::CLT> pairs(nameId, entry);
                     m_CLT.push_back(pairs);
                     // cout<<"Add new CLT: name="<<name<<", lasttime="<<time<<", lambda="<<1.0/time<<", pop="<<1.0/m_ReqNums<<endl;
                 }
@@ -416,54 +391,65 @@ namespace nfd {
                     ++clt.reqNums;
                     clt.popularity = m_ReqNums == 0 ? 0 : double(clt.reqNums)/ double(m_ReqNums);
                     clt.rate = time>0?  clt.reqNums / time : 0;
-                    // cout << "Update CLT: name=" << it->first << ", lasttime=" << it->second.lastTime << ", lambda=" << it->second.rate <<", reqNums="<<clt.reqNums<<", sumNums="<<m_ReqNums <<", pop=" <<it->second.popularity << endl;
+                    // cout << "Update CLT: name=" << name << ", lasttime=" << it->second.lastTime << ", lambda=" << it->second.rate <<", reqNums="<<clt.reqNums<<", sumNums="<<m_ReqNums <<", pop=" <<it->second.popularity << endl;
                 }
             }
 
             void CCAF::distributeCLT() {
                 m_distributed_CLT = m_CLT;
+                m_predictionCache.clear();
                 sort(m_distributed_CLT.begin(), m_distributed_CLT.end(), [&](const auto& a, const auto& b) { return a.second.lastTime > b.second.lastTime; });
-                ns3::Simulator::Schedule(ns3::Seconds(T), &CCAF::distributeCLT, this);
+                ns3::Simulator::Schedule(ns3::Seconds(m_T), &CCAF::distributeCLT, this);
             }
 
             double CCAF::cachePrediction(ns3::Ptr<ns3::Node> node, const ndn::Name name, double time) {
-                if (time < T) { return 0.0; }
-                ns3::Ptr<ns3::ndn::L3Protocol> ndn = node->GetObject<ns3::ndn::L3Protocol>();
+                if (time < m_T) { return 0.0; }
+                ns3::ndn::L3Protocol* ndn = m_nodes.GetL3(node->GetId());
                 ndn::Name prefix("/ustc");
                 nfd::fw::Strategy& strategy = ndn->getForwarder()->getStrategyChoice().findEffectiveStrategy(prefix);
                 nfd::fw::ccaf::CCAF& CCAF_strategy = dynamic_cast<nfd::fw::ccaf::CCAF&>(strategy);
-                auto clt = CCAF_strategy.getCLT();
-                auto it = std::find_if(clt.begin(), clt.end(), [&](auto entry) { return entry.first == name; });
-                if (it == clt.end()) { return 0.0; }
+                const auto& clt = CCAF_strategy.getCLT();
+                NameInterner::Id nameId = NameInterner::get().find(name);
+                if (nameId == NameInterner::INVALID_ID) { return 0.0; }
+
+                // 同一时间片内对同一Name的预测直接使用缓存结果
+                double granularity = CCAF_strategy.m_predictionGranularity;
+                uint64_t key = (uint64_t(nameId) << 32) | uint32_t(granularity > 0 ? time / granularity : 0);
+                if (granularity > 0) {
+                    auto cached = CCAF_strategy.m_predictionCache.find(key);
+                    if (cached != CCAF_strategy.m_predictionCache.end()) { return cached->second; }
+                }
+
+                auto it = std::find_if(clt.begin(), clt.end(), [&](const auto& entry) { return entry.first == nameId; });
+                if (it == clt.end()) {
+                    if (granularity > 0) { CCAF_strategy.m_predictionCache.emplace(key, 0.0); }
+                    return 0.0;
+                }
                 int order = std::distance(clt.begin(), it)+1;
-                double prob;
-                double rate = it->second.rate;
-                double tau = time - int(time / T)*T;
-                double mu = 0.0, sigma = 0.0;
-                if (order <= CACHE_SIZE) {
-                    double prob_less = rate*exp(-rate*tau);
-                    for (int i=order; i<std::max(int(clt.size()),CACHE_SIZE); i++) {
-                        mu += i<clt.size()? exp(-clt[i].second.rate * tau) : 1;
-                        sigma += i < clt.size() ? exp(-clt[i].second.rate * tau) * (1 - exp(-clt[i].second.rate * tau)) : 0;
-                        prob_less *= i < clt.size() ? 0.5*clt[i].second.rate*exp(-clt[i].second.rate*tau) : 0;
-                    }
-                    prob = 0.5*erfc((CONTENT_NUM-CACHE_SIZE-mu) / sqrt(2) / sigma)+ prob_less;
-                    cout<< "case 1" << ", mu=" << mu << ", sigma=" << sigma <<", prob_less="<<prob_less<<", prob="<<prob<<endl;
+                // CLT由node上的实例按其周期分发
+                double period = CCAF_strategy.m_T;
+                double tau = time - int(time / period)*period;
+                vanet::CachePredictionTerms terms;
+                double prob = vanet::predictCacheHit(clt, order, tau, CCAF_strategy.m_cacheSize, CONTENT_NUM, &terms);
+                if (terms.inCacheRange) {
+                    cout<< "case 1" << ", mu=" << terms.mu << ", sigma=" << terms.sigma <<", prob_less="<<terms.probLess<<", prob="<<prob<<endl;
                 }
                 else{
-                    double sum_rate = 0;
-                    double prob_less = 1.0;
-                    for (auto p : clt) {
-                        sum_rate += p.second.rate;
-                        prob_less *= p.second.rate;
-                    }
-                    prob_less *= pow(0.5, clt.size())*exp(-sum_rate * tau);
-                    prob = exp(-sum_rate*tau) * (exp(rate*tau)-1) + prob_less;
-                    cout << "case 2"<<", sum_rate="<<sum_rate<<", prob_less="<<prob_less<<", prob=" << prob << endl;
+                    cout << "case 2"<<", sum_rate="<<terms.sumRate<<", prob_less="<<terms.probLess<<", prob=" << prob << endl;
                 }
+                if (granularity > 0) { CCAF_strategy.m_predictionCache.emplace(key, prob); }
                 return prob;
             }
 
+            void
+                CCAF::reportTableSizes(std::vector<TableSize>& tables) const {
+                tables.push_back(makeTableSize("CCAF::m_NT", m_NT));
+                tables.push_back(makeTableSize("CCAF::m_CLT", m_CLT));
+                tables.push_back(makeTableSize("CCAF::m_distributed_CLT", m_distributed_CLT));
+                tables.push_back(makeTableSize("CCAF::m_predictionCache", m_predictionCache));
+                tables.push_back({ "CCAF::m_decisionCache", m_decisionCache.size(), m_decisionCache.getBytes() });
+            }
+
         }  // namespace ccaf
     }  // namespace fw
 }  // namespace nfd
\ No newline at end of file
@@ -4,24 +4,25 @@
 #include "ns3/ndnSIM/model/ndn-l3-protocol.hpp"
 #include "ns3/ndnSIM/NFD/daemon/fw/strategy.hpp"
 #include "ns3/ndnSIM/NFD/daemon/fw/retx-suppression-exponential.hpp"
-#include "ccaf-measurements.hpp"
-#include "ns3/node-container.h"
+#include "isr-measurements.hpp"
+#include "decision-cache.hpp"
+#include "name-interner.hpp"
+#include "node-registry.hpp"
+#include "ndn-neighbor-table.hpp"
 #include "ns3/node.h"
 #include "ns3/vector.h"
+#include "strategy-parameters.hpp"
+#include "strategy-profiler.hpp"
+#include "vanet-kernels.hpp"
+#include "table-size-reporter.hpp"
 namespace nfd {
     namespace fw {
         namespace ccaf {
 
-            class CCAF : public Strategy {
-                struct  neighborTableEntry {
-                    ns3::Ptr<ns3::Node> node;
-                    ns3::Vector3D position;
-                    ns3::Vector3D velocity;
-                    double LET;
-                    double linkProb;
-                    neighborTableEntry(ns3::Ptr<ns3::Node> n, ns3::Vector3D pos, ns3::Vector3D vel, double let, double prob) : node(n), position(pos), velocity(vel), LET(let), linkProb(prob) {}
-                };
+            using isr::FaceInfo;
+            using isr::NamespaceInfo;
 
+            class CCAF : public Strategy, public TableSizeReporter {
                 struct CLT {
                     int reqNums = 0;
                     double lastTime;
@@ -30,13 +31,7 @@ namespace nfd {
                     CLT(int n, double tau, double lambda, double pol) : reqNums(n), lastTime(tau), rate(lambda), popularity(pol) { }
                 };
 
-                struct FaceStats {
-                    Face* face;
-                    double distance;
-                    double sisr;
-                    double srtt;
-                    FaceStats(Face* f, double d, double isr, double rtt) : face(f), distance(d), sisr(isr), srtt(rtt) {}
-                };
+                using FaceStats = vanet::FaceStats;
 
             public:
                 explicit CCAF(Forwarder& forwarder, const Name& name = getStrategyName());
@@ -44,6 +39,9 @@ namespace nfd {
                 static const Name&
                     getStrategyName();
 
+                void
+                    reportTableSizes(std::vector<TableSize>& tables) const override;
+
                 void
                     afterReceiveInterest(const FaceEndpoint& ingress, const Interest& interest,
                         const shared_ptr<pit::Entry>& pitEntry) override;
@@ -69,9 +67,18 @@ namespace nfd {
                 std::set<Face*>
                     getCandidateForwarders(const fib::NextHopList& nexthops, ns3::Ptr<ns3::Node> curNode, std::set<ns3::Ptr<ns3::Node>> srcNodes);
 
-                /*在FIB中选择下一跳*/
+                /*用信标维护的邻居表刷新m_NT, 节点未安装信标时返回false*/
+                bool
+                    updateNeighborTable(ns3::Ptr<ns3::Node> localNode);
+
+                /*在FIB中选择下一跳, namespaceInfo由selectEgress查好, snapshot非空时记录每个候选的SISR和SRTT*/
+                Face*
+                    selectFIB(ns3::Ptr<ns3::Node> localNode, std::set<Face*> candidateForwarders, const NamespaceInfo* namespaceInfo,
+                        std::vector<DecisionCache::Candidate>* snapshot = nullptr);
+
+                /*先查决策缓存, 未命中时计算候选转发者并调用selectFIB*/
                 Face*
-                    selectFIB(ns3::Ptr<ns3::Node> localNode, const Interest& interest, std::set<Face*> candidateForwarders, const fib::Entry& fibEntry);
+                    selectEgress(ns3::Ptr<ns3::Node> localNode, const Interest& interest, const std::set<ns3::Ptr<ns3::Node>>& sources, const fib::Entry& fibEntry);
 
                 /*计算节点间距离*/
                 double
@@ -114,7 +121,7 @@ namespace nfd {
                 void
                     distributeCLT();
                 
-                std::vector<std::pair<ndn::Name, CLT>>&
+                std::vector<std::pair<NameInterner::Id, CLT>>&
                     getCLT() { return m_distributed_CLT; };
 
                 double cachePrediction(ns3::Ptr<ns3::Node> node, ndn::Name name, double time);
@@ -125,13 +132,25 @@ namespace nfd {
                 static const double T;
                 static const int CONTENT_NUM;
                 static const int CACHE_SIZE;
-
-                ns3::NodeContainer m_nodes;
-                std::vector<CCAF::neighborTableEntry> m_NT;
-                std::vector<std::pair<ndn::Name, CLT>> m_CLT;
-                std::vector<std::pair<ndn::Name, CLT>> m_distributed_CLT;
+                // 实例名参数pth~, t~, cache-size~可覆盖以上默认值, prediction-granularity~为预测缓存的时间粒度
+                double m_Pth = Pth;
+                double m_T = T;
+                int m_cacheSize = CACHE_SIZE;
+
+                const ns3::ndn::NodeRegistry& m_nodes;
+                std::vector<ns3::ndn::NeighborTable::Link> m_NT;
+                ns3::ndn::NeighborTable* m_neighborTable = nullptr;
+                // 以NameInterner分配的ID代替Name作为CLT的键
+                std::vector<std::pair<NameInterner::Id, CLT>> m_CLT;
+                std::vector<std::pair<NameInterner::Id, CLT>> m_distributed_CLT;
                 int m_ReqNums = 0;
-                CCAFMeasurements m_measurements;
+                /* cachePrediction结果缓存, 键为(Name ID, 时间片), 仅在一次distributeCLT内有效。
+                 * 由被预测节点的策略实例持有, 因为预测的输入是该节点分发的CLT */
+                std::unordered_map<uint64_t, double> m_predictionCache;
+                // 时间粒度(秒), 同一时间片内的预测复用首次结果; 0表示不缓存, 结果与逐次计算相同
+                double m_predictionGranularity = 0;
+                isr::IsrMeasurements m_measurements;
+                DecisionCache m_decisionCache;
 
             PUBLIC_WITH_TESTS_ELSE_PRIVATE: static const time::milliseconds RETX_SUPPRESSION_INITIAL;
                 static const time::milliseconds RETX_SUPPRESSION_MAX;
@@ -0,0 +1,49 @@
+#include "decision-cache.hpp"
+
+namespace nfd {
+namespace fw {
+
+DecisionCache::Options DecisionCache::s_defaultOptions;
+DecisionCache::Counters DecisionCache::s_counters;
+
+size_t DecisionCache::hashSources(const std::set<ns3::Ptr<ns3::Node>>& sources) {
+    // node IDs in set order; the set is ordered by pointer, which is stable within a run
+    size_t hash = sources.size();
+    for (const auto& node : sources) {
+        hash = hash * 1000003 ^ node->GetId();
+    }
+    return hash;
+}
+
+void DecisionCache::insert(const Name& prefix, size_t sourceHash, time::steady_clock::TimePoint now,
+                           FaceId decision, std::vector<Candidate> candidates) {
+    int64_t epoch = getEpoch(now);
+    if (epoch != m_epoch) {
+        m_entries.clear();
+        m_epoch = epoch;
+    }
+    NameInterner::Id prefixId = NameInterner::get().intern(prefix);
+    Entry& entry = m_entries[getKey(prefixId, sourceHash)];
+    entry.prefix = prefixId;
+    entry.sourceHash = sourceHash;
+    entry.decision = decision;
+    entry.candidates = std::move(candidates);
+}
+
+void DecisionCache::verify(FaceId cached, FaceId fresh) {
+    s_counters.verified++;
+    if (cached != fresh) {
+        s_counters.diverged++;
+    }
+}
+
+size_t DecisionCache::getBytes() const {
+    size_t bytes = m_entries.bucket_count() * sizeof(void*);
+    for (const auto& item : m_entries) {
+        bytes += sizeof(item) + 2 * sizeof(void*) + item.second.candidates.capacity() * sizeof(Candidate);
+    }
+    return bytes;
+}
+
+}  // namespace fw
+}  // namespace nfd
@@ -0,0 +1,204 @@
+#ifndef NFD_DAEMON_FW_DECISION_CACHE_HPP
+#define NFD_DAEMON_FW_DECISION_CACHE_HPP
+
+#include "ns3/ndnSIM/NFD/daemon/face/face-common.hpp"
+#include "ns3/node.h"
+#include "ns3/ptr.h"
+#include "name-interner.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+namespace nfd {
+namespace fw {
+
+/** \brief optional cache of the selectFIB decisions of OPT and CCAF
+ *
+ *  Consecutive Interests under one prefix from the same node usually see the
+ *  same content sources and nearly the same measurements, and the TOPSIS
+ *  ranking then picks the same face again. An entry, keyed by (prefix, hash
+ *  of the content-source set), holds the chosen face and the SISR and SRTT of
+ *  every ranked candidate at decision time. It is used only within the
+ *  mobility epoch it was made in, and only while no candidate's SISR or SRTT
+ *  moved by more than the thresholds.
+ *
+ *  Every verifyInterval-th hit is recomputed anyway and compared with the
+ *  cached face; the divergence rate and the hit rate are summed over all
+ *  instances and written to the run report.
+ */
+class DecisionCache {
+  public:
+    struct Options {
+        bool enabled = false;
+        time::nanoseconds epoch = time::milliseconds(100);  ///< mobility epoch
+        double isrThreshold = 0.05;                         ///< absolute change of SISR
+        double srttThreshold = 0.01;                        ///< absolute change of SRTT, in seconds
+        uint32_t verifyInterval = 16;                       ///< 0 never verifies
+    };
+
+    struct Counters {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t verified = 0;
+        uint64_t diverged = 0;
+    };
+
+    /** \brief measurements of one ranked candidate, as fed to TOPSIS
+     */
+    struct Candidate {
+        FaceId face;
+        double sisr;
+        double srtt;
+    };
+
+    /** \brief options of caches constructed afterwards
+     */
+    static void setDefaultOptions(const Options& options) { s_defaultOptions = options; }
+
+    static const Options& getDefaultOptions() { return s_defaultOptions; }
+
+    /** \return counters summed over all instances
+     */
+    static const Counters& getCounters() { return s_counters; }
+
+    static void resetCounters() { s_counters = Counters(); }
+
+    static size_t hashSources(const std::set<ns3::Ptr<ns3::Node>>& sources);
+
+    DecisionCache() : m_options(s_defaultOptions) {}
+
+    bool isEnabled() const { return m_options.enabled; }
+
+    /** \param measure called as measure(faceId, sisr, srtt) to get the current
+     *         measurements of a candidate
+     *  \param[out] shouldVerify set on a hit that the caller should recompute
+     *              and report with verify()
+     *  \return the cached face, face::INVALID_FACEID on a miss
+     */
+    template<typename Measure>
+    FaceId find(const Name& prefix, size_t sourceHash, time::steady_clock::TimePoint now, Measure&& measure,
+                bool& shouldVerify);
+
+    /** \brief the selectEgress of OPT and CCAF: decide through the cache
+     *
+     *  While the cache is disabled this is decide(nullptr). Otherwise a valid
+     *  entry is returned, and on a miss or a hit due for verification
+     *  decide(&snapshot) makes a fresh decision, which is recorded.
+     *
+     *  \param measure as in find()
+     *  \param decide called as decide(std::vector<Candidate>* snapshot), returns
+     *         the chosen Face* or nullptr and fills a non-null snapshot
+     *  \param getFace called as getFace(faceId), the Face* of a cached decision,
+     *         nullptr if the face is gone
+     */
+    template<typename Measure, typename Decide, typename GetFace>
+    auto select(const Name& prefix, const std::set<ns3::Ptr<ns3::Node>>& sources, time::steady_clock::TimePoint now,
+                Measure&& measure, Decide&& decide, GetFace&& getFace) -> decltype(decide(nullptr));
+
+    /** \brief record a fresh decision, replacing the entry of the same key
+     */
+    void insert(const Name& prefix, size_t sourceHash, time::steady_clock::TimePoint now, FaceId decision,
+                std::vector<Candidate> candidates);
+
+    /** \brief compare a verified hit with the fresh decision
+     */
+    void verify(FaceId cached, FaceId fresh);
+
+    size_t size() const { return m_entries.size(); }
+
+    /** \return estimated memory held by the entries, for reportTableSizes
+     */
+    size_t getBytes() const;
+
+  private:
+    struct Entry {
+        NameInterner::Id prefix;
+        size_t sourceHash;
+        FaceId decision;
+        std::vector<Candidate> candidates;
+    };
+
+    int64_t getEpoch(time::steady_clock::TimePoint now) const {
+        return now.time_since_epoch().count() / m_options.epoch.count();
+    }
+
+    static size_t getKey(NameInterner::Id prefix, size_t sourceHash) { return sourceHash * 31 + prefix; }
+
+  private:
+    Options m_options;
+    // entries of the current epoch only, older ones are dropped on the next insert
+    std::unordered_map<size_t, Entry> m_entries;
+    int64_t m_epoch = -1;
+    uint32_t m_hitsSinceVerify = 0;
+
+    static Options s_defaultOptions;
+    static Counters s_counters;
+};
+
+template<typename Measure>
+FaceId DecisionCache::find(const Name& prefix, size_t sourceHash, time::steady_clock::TimePoint now,
+                           Measure&& measure, bool& shouldVerify) {
+    shouldVerify = false;
+    NameInterner::Id prefixId = NameInterner::get().intern(prefix);
+    auto it = m_entries.find(getKey(prefixId, sourceHash));
+    bool isValid = it != m_entries.end() && it->second.prefix == prefixId &&
+                   it->second.sourceHash == sourceHash && m_epoch == getEpoch(now);
+    if (isValid) {
+        for (const Candidate& candidate : it->second.candidates) {
+            double sisr = 0, srtt = 0;
+            measure(candidate.face, sisr, srtt);
+            if (std::abs(sisr - candidate.sisr) > m_options.isrThreshold ||
+                std::abs(srtt - candidate.srtt) > m_options.srttThreshold) {
+                isValid = false;
+                break;
+            }
+        }
+    }
+    if (!isValid) {
+        s_counters.misses++;
+        return face::INVALID_FACEID;
+    }
+
+    s_counters.hits++;
+    if (m_options.verifyInterval > 0 && ++m_hitsSinceVerify >= m_options.verifyInterval) {
+        m_hitsSinceVerify = 0;
+        shouldVerify = true;
+    }
+    return it->second.decision;
+}
+
+template<typename Measure, typename Decide, typename GetFace>
+auto DecisionCache::select(const Name& prefix, const std::set<ns3::Ptr<ns3::Node>>& sources,
+                           time::steady_clock::TimePoint now, Measure&& measure, Decide&& decide,
+                           GetFace&& getFace) -> decltype(decide(nullptr)) {
+    if (!isEnabled()) {
+        return decide(nullptr);
+    }
+
+    size_t sourceHash = hashSources(sources);
+    bool shouldVerify = false;
+    FaceId cached = find(prefix, sourceHash, now, measure, shouldVerify);
+    auto cachedFace = cached == face::INVALID_FACEID ? nullptr : getFace(cached);
+    if (cachedFace != nullptr && !shouldVerify) {
+        return cachedFace;
+    }
+
+    std::vector<Candidate> snapshot;
+    auto fresh = decide(&snapshot);
+    FaceId freshId = fresh == nullptr ? face::INVALID_FACEID : fresh->getId();
+    if (cachedFace != nullptr) {
+        verify(cached, freshId);
+    }
+    if (fresh != nullptr) {
+        insert(prefix, sourceHash, now, freshId, std::move(snapshot));
+    }
+    return fresh;
+}
+
+}  // namespace fw
+}  // namespace nfd
+
+#endif  // NFD_DAEMON_FW_DECISION_CACHE_HPP
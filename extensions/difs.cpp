@@ -6,6 +6,7 @@
 #include "ns3/ndnSIM/model/ndn-l3-protocol.hpp"
 #include "ns3/ndnSIM/apps/ndn-producer.hpp"
 #include "ns3/simulator.h"
+#include "strategy-profiler.hpp"
 
 namespace nfd{
 namespace fw{
@@ -21,7 +22,7 @@ DIFS::DIFS(Forwarder &forwarder, const Name &name)
 	  m_retxSuppression(RETX_SUPPRESSION_INITIAL, RetxSuppressionExponential::DEFAULT_MULTIPLIER,
 						RETX_SUPPRESSION_MAX),
 	  m_forwarder(forwarder),
-	  m_nodes(ns3::NodeContainer::GetGlobal()), m_Rth(200)
+	  m_nodes(ns3::ndn::NodeRegistry::Get()), m_Rth(200)
 {
 	ParsedInstanceName parsed = parseInstanceName(name);
 	if (!parsed.parameters.empty())
@@ -46,6 +47,7 @@ DIFS::getStrategyName()
 void DIFS::afterReceiveInterest(const FaceEndpoint &ingress, const Interest &interest,
 								const shared_ptr<pit::Entry> &pitEntry)
 {
+	STRATEGY_PROFILE("DIFS");
 	const fib::Entry &fibEntry = this->lookupFib(*pitEntry);
 	const fib::NextHopList &nexthops = fibEntry.getNextHops();
 	auto it = nexthops.end();
@@ -90,6 +92,7 @@ void
 DIFS::afterContentStoreHit(const shared_ptr<pit::Entry> &pitEntry,
                                 const FaceEndpoint &ingress, const Data &data)
 {
+    STRATEGY_PROFILE("DIFS");
     // NFD_LOG_DEBUG("afterContentStoreHit pitEntry=" << pitEntry->getName()
     //                 << " in=" << ingress << " data=" << data.getName());
 
@@ -101,6 +104,7 @@ void
 DIFS::afterReceiveData(const shared_ptr<pit::Entry> &pitEntry,
 							const FaceEndpoint &ingress, const Data &data)
 {
+	STRATEGY_PROFILE("DIFS");
 	Interest interest = pitEntry->getInterest();
 	const auto& inface =  (pitEntry->getInRecords().begin()->getFace());
     auto egress = FaceEndpoint(inface,0);
@@ -271,5 +275,10 @@ DIFS::updateNeighborList(ns3::Ptr<ns3::Node> localNode) {
     }
 }
 
+void
+DIFS::reportTableSizes(std::vector<TableSize>& tables) const {
+    tables.push_back(makeTableSize("DIFS::m_NeighborList", m_NeighborList));
+}
+
 } // namespace fw
 } // namespace nfd
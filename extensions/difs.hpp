@@ -4,14 +4,15 @@
 #include "ns3/ndnSIM/NFD/daemon/fw/strategy.hpp"
 #include "ns3/ndnSIM/NFD/daemon/fw/process-nack-traits.hpp"
 #include "ns3/ndnSIM/NFD/daemon/fw/retx-suppression-exponential.hpp"
-#include "ns3/node-container.h"
+#include "node-registry.hpp"
 #include "ns3/node.h"
 #include "ns3/ndnSIM/ndn-cxx/name.hpp"
+#include "table-size-reporter.hpp"
 #include <vector>
 
 namespace nfd{
 namespace fw{
-class DIFS : public Strategy, public ProcessNackTraits<DIFS>
+class DIFS : public Strategy, public TableSizeReporter, public ProcessNackTraits<DIFS>
 {
 struct NeighborEntry {
 	ns3::Ptr<ns3::Node> node;
@@ -36,6 +37,9 @@ public:
 	static const Name &
 	getStrategyName();
 
+	void
+	reportTableSizes(std::vector<TableSize>& tables) const override;
+
 	void
 	afterReceiveInterest(const FaceEndpoint &ingress, const Interest &interest,
 					const shared_ptr<pit::Entry> &pitEntry) override;
@@ -99,7 +103,7 @@ private:
 
 private:
 	Forwarder &m_forwarder;
-	ns3::NodeContainer m_nodes;
+	const ns3::ndn::NodeRegistry& m_nodes;
 	double m_Rth;
     std::vector<NeighborEntry> m_NeighborList;
     // std::vector<DecisionEntry> m_DecisionList;
@@ -24,6 +24,7 @@
  */
 
 #include "generic-link-service-m.hpp"
+#include "vanet-probes.hpp"
 
 #include <cmath>
 
@@ -89,11 +90,14 @@ void GenericLinkServiceM::sendLpPacket(lp::Packet&& pkt,
         NFD_LOG_FACE_WARN("attempted to send packet over MTU limit");
         return;
     }
+    VANET_PROBE2(link_send, this->getFace()->getId(), block.size());
     this->sendPacket(block, endpointId);
 }
 
 void GenericLinkServiceM::doSendInterest(const Interest& interest,
                                          const EndpointId& endpointId) {
+    VANET_PROBE4(interest_send, this->getFace()->getId(), interest.getNonce(),
+                 interest.getName().wireEncode().wire(), interest.getName().wireEncode().size());
     lp::Packet lpPacket(interest.wireEncode());
 
     encodeLpFields(interest, lpPacket);
@@ -103,6 +107,8 @@ void GenericLinkServiceM::doSendInterest(const Interest& interest,
 
 void GenericLinkServiceM::doSendData(const Data& data,
                                      const EndpointId& endpointId) {
+    VANET_PROBE3(data_send, this->getFace()->getId(), data.getName().wireEncode().wire(),
+                 data.getName().wireEncode().size());
     lp::Packet lpPacket(data.wireEncode());
 
     encodeLpFields(data, lpPacket);
@@ -279,6 +285,7 @@ void GenericLinkServiceM::checkCongestionLevel(lp::Packet& pkt) {
 
 void GenericLinkServiceM::doReceivePacket(const Block& packet,
                                           const EndpointId& endpoint) {
+    VANET_PROBE2(link_receive, this->getFace()->getId(), packet.size());
     try {
         lp::Packet pkt(packet);
 
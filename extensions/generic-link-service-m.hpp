@@ -179,6 +179,10 @@ class GenericLinkServiceM FINAL_UNLESS_WITH_TESTS
 
     const Counters& getCounters() const OVERRIDE_WITH_TESTS_ELSE_FINAL;
 
+    /** \brief get number of network-layer packets waiting for more fragments
+     */
+    size_t getReassemblerSize() const;
+
     PROTECTED_WITH_TESTS_ELSE_PRIVATE
         :  // send path
            /** \brief request an IDLE packet to transmit pending service fields
@@ -314,6 +318,10 @@ inline const GenericLinkServiceM::Counters& GenericLinkServiceM::getCounters()
     return *this;
 }
 
+inline size_t GenericLinkServiceM::getReassemblerSize() const {
+    return m_reassembler.size();
+}
+
 }  // namespace face
 }  // namespace nfd
 
@@ -0,0 +1,61 @@
+#include "geo-tag-tracker.hpp"
+
+#include "ndn-geo-tag-helper.hpp"
+#include "node-registry.hpp"
+#include "ns3/assert.h"
+#include "ns3/ndnSIM/model/ndn-l3-protocol.hpp"
+#include "ns3/ndnSIM/ndn-cxx/lp/geo-tag.hpp"
+
+#include <tuple>
+
+namespace nfd {
+namespace fw {
+
+const time::milliseconds GeoTagTracker::MIN_INTERVAL(1);
+
+GeoTagTracker::GeoTagTracker(const Forwarder& forwarder) {
+    const ns3::ndn::NodeRegistry& nodes = ns3::ndn::NodeRegistry::Get();
+    for (const auto& node : nodes) {
+        ns3::ndn::L3Protocol* l3 = nodes.GetL3(node->GetId());
+        if (l3 != nullptr && l3->getForwarder().get() == &forwarder) {
+            ns3::ndn::GeoTagHelper::SetEnabled(node, true);
+            return;
+        }
+    }
+    NS_ASSERT_MSG(false, "GeoTagTracker: no node runs this forwarder");
+}
+
+bool GeoTagTracker::update(FaceId faceId, const ndn::TagHost& packet, Motion& motion) {
+    auto geoTag = packet.getTag<ndn::lp::GeoTag>();
+    if (geoTag == nullptr) {
+        return false;
+    }
+    ns3::Vector position;
+    std::tie(position.x, position.y, position.z) = geoTag->getPos();
+    auto now = time::steady_clock::now();
+
+    auto it = m_samples.find(faceId);
+    if (it == m_samples.end()) {
+        it = m_samples.emplace(faceId, Sample{{position, ns3::Vector()}, now}).first;
+    } else if (now - it->second.time < MIN_INTERVAL) {
+        motion = {position, it->second.motion.velocity};
+        return true;
+    } else {
+        double dt = boost::chrono::duration_cast<boost::chrono::duration<double>>(now - it->second.time).count();
+        const ns3::Vector& last = it->second.motion.position;
+        it->second.motion.velocity =
+            ns3::Vector((position.x - last.x) / dt, (position.y - last.y) / dt, (position.z - last.z) / dt);
+        it->second.motion.position = position;
+        it->second.time = now;
+    }
+    motion = it->second.motion;
+    return true;
+}
+
+size_t GeoTagTracker::getBytes() const {
+    return m_samples.size() * (sizeof(std::pair<const FaceId, Sample>) + 2 * sizeof(void*)) +
+           m_samples.bucket_count() * sizeof(void*);
+}
+
+}  // namespace fw
+}  // namespace nfd
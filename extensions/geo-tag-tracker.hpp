@@ -0,0 +1,65 @@
+#ifndef NFD_DAEMON_FW_GEO_TAG_TRACKER_HPP
+#define NFD_DAEMON_FW_GEO_TAG_TRACKER_HPP
+
+#include "ns3/ndnSIM/NFD/daemon/face/face-common.hpp"
+#include "ns3/ndnSIM/ndn-cxx/tag-host.hpp"
+#include "ns3/vector.h"
+
+#include <unordered_map>
+
+namespace nfd {
+
+class Forwarder;
+
+namespace fw {
+
+/** \brief reads the previous hop's position from the GeoTag of a received
+ *         packet, and estimates its velocity per ingress face
+ *
+ *  A GeoTag holds a position only, so the velocity is the displacement
+ *  between the last two tags received on the same face divided by the time
+ *  between them. It is zero until a face has delivered two tags at least
+ *  MIN_INTERVAL apart.
+ *
+ *  Everything a strategy learns here travels with the packet, so it needs
+ *  no access to the sender's MobilityModel.
+ *
+ *  Constructing a tracker turns on ns3::ndn::GeoTagHelper for the node that
+ *  runs \p forwarder, so nodes whose strategy holds none send no tags.
+ */
+class GeoTagTracker {
+  public:
+    explicit GeoTagTracker(const Forwarder& forwarder);
+
+    struct Motion {
+        ns3::Vector position;
+        ns3::Vector velocity;
+    };
+
+    /** \param[out] motion sender position and estimated velocity
+     *  \return false if \p packet carries no GeoTag, \p motion is then unchanged
+     */
+    bool update(FaceId faceId, const ndn::TagHost& packet, Motion& motion);
+
+    size_t size() const { return m_samples.size(); }
+
+    /** \return estimated memory held by the samples, for reportTableSizes
+     */
+    size_t getBytes() const;
+
+  private:
+    struct Sample {
+        Motion motion;
+        time::steady_clock::TimePoint time;
+    };
+
+    // two tags closer than this are treated as one, the velocity is kept
+    static const time::milliseconds MIN_INTERVAL;
+
+    std::unordered_map<FaceId, Sample> m_samples;
+};
+
+}  // namespace fw
+}  // namespace nfd
+
+#endif  // NFD_DAEMON_FW_GEO_TAG_TRACKER_HPP
@@ -0,0 +1,118 @@
+#include "highway-partitioner.hpp"
+
+#include "ns3/abort.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+#ifdef NS3_MPI
+#include <ns3/mpi-interface.h>
+#endif
+
+NS_LOG_COMPONENT_DEFINE("HighwayPartitioner");
+
+namespace ns3 {
+
+HighwayPartitioner::HighwayPartitioner(const std::string& trace, uint32_t num, uint32_t ranks)
+    : m_systemIds(num, 0) {
+    std::ifstream file(trace);
+    if (!file.is_open()) {
+        NS_FATAL_ERROR("Cannot open mobility trace " << trace);
+    }
+
+    // initial positions: "$node_(<id>) set X_ <x>" and "... Y_ <y>"
+    std::vector<double> xs(num, 0.0), ys(num, 0.0);
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.compare(0, 7, "$node_(") != 0) {
+            continue;
+        }
+        std::istringstream ss(line.substr(7));
+        uint32_t id;
+        std::string close, set, axis;
+        double value;
+        if (!(ss >> id >> close >> set >> axis >> value) || id >= num || set != "set") {
+            continue;
+        }
+        if (axis == "X_") {
+            xs[id] = value;
+        }
+        else if (axis == "Y_") {
+            ys[id] = value;
+        }
+    }
+
+    auto spread = [](const std::vector<double>& v) {
+        if (v.empty()) {
+            return 0.0;
+        }
+        auto range = std::minmax_element(v.begin(), v.end());
+        return *range.second - *range.first;
+    };
+    const std::vector<double>& road = spread(xs) >= spread(ys) ? xs : ys;
+
+    std::vector<double> sorted(road);
+    std::sort(sorted.begin(), sorted.end());
+    for (uint32_t r = 1; r < ranks && !sorted.empty(); r++) {
+        m_borders.push_back(sorted[sorted.size() * r / ranks]);
+    }
+    for (uint32_t id = 0; id < num; id++) {
+        m_systemIds[id] = std::upper_bound(m_borders.begin(), m_borders.end(), road[id]) - m_borders.begin();
+    }
+    NS_LOG_INFO(num << " vehicles on " << ranks << " ranks, " << (&road == &xs ? "x" : "y") << " axis");
+}
+
+uint32_t HighwayPartitioner::GetSystemId(uint32_t nodeId) const {
+    return m_systemIds[nodeId];
+}
+
+NodeContainer HighwayPartitioner::CreateNodes() const {
+    NodeContainer nodes;
+    for (uint32_t systemId : m_systemIds) {
+        nodes.Create(1, systemId);
+    }
+    return nodes;
+}
+
+void HighwayPartitioner::EnableMpi(int* argc, char*** argv) {
+#ifdef NS3_MPI
+    MpiInterface::Enable(argc, argv);
+#else
+    NS_ABORT_MSG("ns-3 was built without MPI support");
+#endif
+}
+
+void HighwayPartitioner::DisableMpi() {
+#ifdef NS3_MPI
+    MpiInterface::Disable();
+#endif
+}
+
+uint32_t HighwayPartitioner::GetRanks() {
+#ifdef NS3_MPI
+    return MpiInterface::GetSize();
+#else
+    return 1;
+#endif
+}
+
+bool HighwayPartitioner::IsLocal(Ptr<Node> node) {
+#ifdef NS3_MPI
+    return node->GetSystemId() == MpiInterface::GetSystemId();
+#else
+    return true;
+#endif
+}
+
+std::string HighwayPartitioner::GetRankPath(const std::string& path) {
+#ifdef NS3_MPI
+    if (!path.empty() && MpiInterface::GetSystemId() != 0) {
+        return path + ".rank" + std::to_string(MpiInterface::GetSystemId());
+    }
+#endif
+    return path;
+}
+
+}  // namespace ns3
@@ -0,0 +1,74 @@
+#ifndef HIGHWAY_PARTITIONER_HPP
+#define HIGHWAY_PARTITIONER_HPP
+
+#include "ns3/node-container.h"
+#include "ns3/node.h"
+
+#include <string>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \brief assigns the vehicles of an ns-2 mobility trace to MPI ranks by road
+ *        segment
+ *
+ * The road axis is the coordinate (x or y) along which the initial
+ * positions spread the most. Segment borders are quantiles of the initial
+ * positions, so every rank owns about the same number of vehicles.
+ *
+ * Ownership is decided once, when the nodes are created. Migration is not
+ * supported: ns-3 keeps a node's system ID for the whole run, so a vehicle
+ * that crosses a border stays on its original rank, and the share of frames
+ * that cross ranks (and the load imbalance) grows as vehicles drift out of
+ * their segment. Every rank installs mobility on every node and
+ * UnitDiskChannel forwards frames to receivers on other ranks over MPI.
+ *
+ * A partitioned run is not known to reproduce the single-process run.
+ * Events with equal timestamps may be ordered differently on different
+ * ranks, and that changes the order of draws from the random streams (loss
+ * and defer jitter). test/calibrate.py --ranks compares the two, but it has
+ * not been run.
+ */
+class HighwayPartitioner {
+  public:
+    HighwayPartitioner(const std::string& trace, uint32_t num, uint32_t ranks);
+
+    /** \brief rank owning node \p nodeId
+     */
+    uint32_t GetSystemId(uint32_t nodeId) const;
+
+    /** \brief ranks - 1 segment borders along the road axis
+     */
+    const std::vector<double>& GetBorders() const { return m_borders; }
+
+    /** \brief create the nodes in ID order, each on the rank of its initial segment
+     */
+    NodeContainer CreateNodes() const;
+
+    /** \brief MpiInterface::Enable, aborting when ns-3 was built without MPI
+     */
+    static void EnableMpi(int* argc, char*** argv);
+
+    static void DisableMpi();
+
+    /** \brief number of MPI ranks, 1 without MPI
+     */
+    static uint32_t GetRanks();
+
+    /** \brief whether \p node is simulated by this rank; true for every node without MPI
+     */
+    static bool IsLocal(Ptr<Node> node);
+
+    /** \brief per-rank output file: \p path on rank 0, <path>.rank<k> on rank k
+     */
+    static std::string GetRankPath(const std::string& path);
+
+  private:
+    std::vector<uint32_t> m_systemIds;
+    std::vector<double> m_borders;
+};
+
+}  // namespace ns3
+
+#endif  // HIGHWAY_PARTITIONER_HPP
@@ -0,0 +1,283 @@
+#include "hop-tracer.hpp"
+
+#include "ndn-frame.hpp"
+
+#include "ns3/log.h"
+#include "ns3/node-list.h"
+#include "ns3/node.h"
+#include "ns3/packet.h"
+#include "ns3/simulator.h"
+#include "ns3/wifi-net-device.h"
+#include "ns3/wifi-phy-state-helper.h"
+#include "ns3/wifi-phy.h"
+#include "ns3/ndnSIM/model/ndn-l3-protocol.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <numeric>
+
+NS_LOG_COMPONENT_DEFINE("HopTracer");
+
+namespace ns3 {
+
+namespace {
+
+const char* PACKET_NAMES[] = {"interest", "data"};
+const char* COMPONENT_NAMES[] = {"strategy", "defer", "mac", "air", "retx_wait"};
+
+/** \brief keeps Interest and Data keys of the same Name apart
+ */
+const uint64_t DATA_SALT = 0x9e3779b97f4a7c15ULL;
+
+bool
+isLocal(const ::nfd::face::Face& face) {
+    return face.getScope() == ::ndn::nfd::FACE_SCOPE_LOCAL;
+}
+
+double
+percentile(std::vector<double>& values, double p) {
+    size_t k = std::min(values.size() - 1, size_t(p * values.size()));
+    std::nth_element(values.begin(), values.begin() + k, values.end());
+    return values[k];
+}
+
+}  // namespace
+
+HopTracer* HopTracer::s_active = nullptr;
+
+HopTracer::HopTracer(const std::string& path, const std::string& strategy, uint32_t sampling)
+    : m_path(path), m_strategy(strategy), m_sampling(sampling) {}
+
+void HopTracer::Start() {
+    if (!IsEnabled()) {
+        return;
+    }
+    uint32_t phys = 0;
+    for (uint32_t i = 0; i < NodeList::GetNNodes(); i++) {
+        Ptr<Node> node = NodeList::GetNode(i);
+        Ptr<ndn::L3Protocol> l3 = node->GetObject<ndn::L3Protocol>();
+        if (l3 != nullptr) {
+            l3->TraceConnectWithoutContext("InInterests", MakeBoundCallback(&HopTracer::InInterest, this, i));
+            l3->TraceConnectWithoutContext("OutInterests", MakeBoundCallback(&HopTracer::OutInterest, this, i));
+            l3->TraceConnectWithoutContext("InData", MakeBoundCallback(&HopTracer::InData, this, i));
+            l3->TraceConnectWithoutContext("OutData", MakeBoundCallback(&HopTracer::OutData, this, i));
+        }
+        for (uint32_t j = 0; j < node->GetNDevices(); j++) {
+            Ptr<WifiNetDevice> device = DynamicCast<WifiNetDevice>(node->GetDevice(j));
+            if (device == nullptr || device->GetPhy() == nullptr) {
+                continue;
+            }
+            device->GetPhy()->GetState()->TraceConnectWithoutContext(
+                "Tx", MakeBoundCallback(&HopTracer::TxTrace, this, i));
+            phys++;
+        }
+    }
+    if (phys == 0) {
+        NS_LOG_WARN("no WifiNetDevice found, mac and air are not measured");
+    }
+    m_traceTx = phys > 0;
+    s_active = this;
+}
+
+void HopTracer::Finish() {
+    if (!IsEnabled()) {
+        return;
+    }
+    s_active = nullptr;
+    for (const auto& item : m_hops) {
+        Abandon(item.second);
+    }
+    m_hops.clear();
+    m_sent.clear();
+
+    std::ofstream os(m_path);
+    if (!os) {
+        NS_LOG_ERROR("cannot write hop trace to " << m_path);
+        return;
+    }
+    os << "strategy,packet,component,samples,mean_ms,p50_ms,p95_ms\n";
+    for (int kind = 0; kind < N_PACKET_KINDS; kind++) {
+        for (int component = 0; component < N_COMPONENTS; component++) {
+            std::vector<double>& values = m_samples[kind][component];
+            if (values.empty()) {
+                continue;
+            }
+            double mean = std::accumulate(values.begin(), values.end(), 0.0) / values.size();
+            os << m_strategy << "," << PACKET_NAMES[kind] << "," << COMPONENT_NAMES[component] << ","
+               << values.size() << "," << mean * 1e3 << "," << percentile(values, 0.5) * 1e3 << ","
+               << percentile(values, 0.95) * 1e3 << "\n";
+        }
+        os << m_strategy << "," << PACKET_NAMES[kind] << ",cancelled," << m_cancelled[kind] << ",,,\n";
+    }
+    NS_LOG_INFO("hop trace written to " << m_path);
+}
+
+void HopTracer::Deferred(const ::ndn::Interest& interest, double delay) {
+    if (s_active == nullptr) {
+        return;
+    }
+    uint64_t key = MakeKey(INTEREST, HashName(interest), interest.getNonce());
+    if (s_active->IsSampled(key)) {
+        s_active->Defer(Simulator::GetContext(), INTEREST, key, delay);
+    }
+}
+
+void HopTracer::Deferred(const ::ndn::Data& data, double delay) {
+    if (s_active == nullptr) {
+        return;
+    }
+    uint64_t key = MakeKey(DATA, HashName(data), 0);
+    if (s_active->IsSampled(key)) {
+        s_active->Defer(Simulator::GetContext(), DATA, key, delay);
+    }
+}
+
+uint64_t HopTracer::MakeKey(PacketKind kind, uint64_t nameHash, uint32_t nonce) {
+    if (kind == DATA) {
+        return nameHash ^ DATA_SALT;
+    }
+    // the FNV-1a prime spreads the nonce over all bits before sampling by modulo
+    return (nameHash ^ nonce) * 0x100000001b3ULL;
+}
+
+uint64_t HopTracer::HashName(const ::ndn::Interest& interest) {
+    const ::ndn::Block& wire = interest.getName().wireEncode();
+    return NdnFrame::HashName(wire.wire(), wire.size());
+}
+
+uint64_t HopTracer::HashName(const ::ndn::Data& data) {
+    const ::ndn::Block& wire = data.getName().wireEncode();
+    return NdnFrame::HashName(wire.wire(), wire.size());
+}
+
+void HopTracer::InInterest(HopTracer* tracer, uint32_t node, const ::ndn::Interest& interest,
+                           const ::nfd::face::Face& face) {
+    uint64_t nameHash = HashName(interest);
+    bool local = isLocal(face);
+    if (local) {
+        // an Interest from the consumer app: a retransmission if its Name is still unsatisfied
+        double now = Simulator::Now().GetSeconds();
+        auto inserted = tracer->m_firstRequest.emplace(HopKey(node, nameHash), now);
+        if (!inserted.second) {
+            tracer->m_samples[INTEREST][RETX_WAIT].push_back(now - inserted.first->second);
+        }
+    }
+    uint64_t key = MakeKey(INTEREST, nameHash, interest.getNonce());
+    if (tracer->IsSampled(key)) {
+        tracer->Receive(node, INTEREST, key, local);
+    }
+}
+
+void HopTracer::OutInterest(HopTracer* tracer, uint32_t node, const ::ndn::Interest& interest,
+                            const ::nfd::face::Face& face) {
+    uint64_t key = MakeKey(INTEREST, HashName(interest), interest.getNonce());
+    if (tracer->IsSampled(key)) {
+        tracer->Send(node, key, isLocal(face));
+    }
+}
+
+void HopTracer::InData(HopTracer* tracer, uint32_t node, const ::ndn::Data& data, const ::nfd::face::Face& face) {
+    uint64_t key = MakeKey(DATA, HashName(data), 0);
+    if (tracer->IsSampled(key)) {
+        tracer->Receive(node, DATA, key, isLocal(face));
+    }
+}
+
+void HopTracer::OutData(HopTracer* tracer, uint32_t node, const ::ndn::Data& data, const ::nfd::face::Face& face) {
+    uint64_t nameHash = HashName(data);
+    bool local = isLocal(face);
+    if (local) {
+        // delivered to the consumer app, later Interests for the Name are new requests
+        tracer->m_firstRequest.erase(HopKey(node, nameHash));
+    }
+    uint64_t key = MakeKey(DATA, nameHash, 0);
+    if (tracer->IsSampled(key)) {
+        tracer->Send(node, key, local);
+    }
+}
+
+void HopTracer::TxTrace(HopTracer* tracer, uint32_t node, Ptr<const Packet> packet, WifiMode mode,
+                        WifiPreamble preamble, uint8_t power) {
+    NdnFrame frame = NdnFrame::FromWifi(packet);
+    if (frame.kind != NdnFrame::INTEREST && frame.kind != NdnFrame::DATA) {
+        return;
+    }
+    PacketKind kind = frame.kind == NdnFrame::INTEREST ? INTEREST : DATA;
+    uint64_t key = MakeKey(kind, frame.nameHash, frame.nonce);
+    if (tracer->IsSampled(key)) {
+        tracer->Transmit(node, kind, key);
+    }
+}
+
+void HopTracer::Receive(uint32_t node, PacketKind kind, uint64_t key, bool local) {
+    double now = Simulator::Now().GetSeconds();
+    if (!local) {
+        // the first node to receive a transmission closes its air time
+        auto tx = m_lastTx.find(key);
+        if (tx != m_lastTx.end() && tx->second.node != node) {
+            m_samples[kind][AIR].push_back(now - tx->second.time);
+            m_lastTx.erase(tx);
+        }
+    }
+    Hop& hop = m_hops[HopKey(node, key)];
+    if (hop.receive >= 0 && now - hop.receive > STALE_S) {
+        // a Data Name requested again, the earlier copy was never sent from here
+        Abandon(hop);
+        hop = Hop();
+    }
+    if (hop.receive < 0) {
+        hop.kind = kind;
+        hop.receive = now;
+    }
+}
+
+void HopTracer::Defer(uint32_t node, PacketKind kind, uint64_t key, double delay) {
+    Hop& hop = m_hops[HopKey(node, key)];
+    hop.kind = kind;
+    hop.defer = delay;
+}
+
+void HopTracer::Send(uint32_t node, uint64_t key, bool local) {
+    auto hop = m_hops.find(HopKey(node, key));
+    if (local) {
+        // handed to an app, nothing more happens to it on this node
+        if (hop != m_hops.end()) {
+            m_hops.erase(hop);
+        }
+        return;
+    }
+    if (hop == m_hops.end()) {
+        return;
+    }
+    // strategy and defer are complete here, only mac waits for the TX start
+    double now = Simulator::Now().GetSeconds();
+    const Hop& h = hop->second;
+    if (h.receive >= 0) {
+        m_samples[h.kind][STRATEGY].push_back(now - h.receive);
+    }
+    if (h.defer >= 0) {
+        m_samples[h.kind][DEFER].push_back(h.defer);
+    }
+    if (m_traceTx) {
+        m_sent[hop->first] = now;
+    }
+    m_hops.erase(hop);
+}
+
+void HopTracer::Transmit(uint32_t node, PacketKind kind, uint64_t key) {
+    double now = Simulator::Now().GetSeconds();
+    auto sent = m_sent.find(HopKey(node, key));
+    if (sent != m_sent.end()) {
+        m_samples[kind][MAC].push_back(now - sent->second);
+        m_sent.erase(sent);
+    }
+    m_lastTx[key] = Transmission{now, node};
+}
+
+void HopTracer::Abandon(const Hop& hop) {
+    if (hop.defer >= 0) {
+        m_cancelled[hop.kind]++;
+    }
+}
+
+}  // namespace ns3
@@ -0,0 +1,161 @@
+#ifndef HOP_TRACER_HPP
+#define HOP_TRACER_HPP
+
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+#include "ns3/wifi-mode.h"
+#include "ns3/wifi-preamble.h"
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace ndn {
+class Data;
+class Interest;
+}  // namespace ndn
+
+namespace nfd {
+namespace face {
+class Face;
+}  // namespace face
+}  // namespace nfd
+
+namespace ns3 {
+
+class Packet;
+
+/**
+ * \brief per-hop latency breakdown of a hash-sampled subset of Interests
+ *        and Data
+ *
+ * An Interest is sampled when the hash of its Name and nonce is divisible
+ * by the sampling factor, a Data when the hash of its Name is, so every
+ * node picks the same packets without coordination. For a sampled packet
+ * each node records
+ *
+ * - receive: ndn::L3Protocol InInterests/InData, from a wireless or app face;
+ * - defer: the delay a strategy scheduled before relaying it, see Deferred();
+ * - send: L3Protocol OutInterests/OutData to a wireless face. The link
+ *   service and transport pass it to the MAC queue in the same event, so
+ *   this is also the MAC enqueue time;
+ * - TX start: the Tx trace of the node's WifiPhyStateHelper;
+ * - receive at the next hop: the first receive on another node.
+ *
+ * These split each hop into strategy (receive to send, of which defer is
+ * the scheduled timer), mac (send to TX start: queueing and contention) and
+ * air (TX start to reception at the next hop: frame duration and
+ * propagation). Strategy and defer are recorded at send, so they are
+ * measured on every device; only mac waits for the TX start.
+ * Retransmission timeouts are taken at the consumer node: for every
+ * retransmission the app issues while its Name is unsatisfied, the time
+ * since the first Interest for that Name. Deferred relays that are
+ * never sent, because they were suppressed or cancelled, are counted.
+ *
+ * Writes one row per (packet, component) labelled with the strategy to the
+ * given path. Unit-disk devices (--fast) have no TX start trace, so mac
+ * and air are only measured on 802.11p, while strategy, defer, retx_wait
+ * and the cancelled count are measured on both. Nothing is traced when
+ * the path is empty.
+ */
+class HopTracer {
+  public:
+    /** \param sampling trace one packet in \p sampling, 1 traces all
+     */
+    HopTracer(const std::string& path, const std::string& strategy, uint32_t sampling);
+
+    bool IsEnabled() const { return !m_path.empty() && m_sampling > 0; }
+
+    /** \brief call right before Simulator::Run(), after the NDN stack is installed
+     */
+    void Start();
+
+    /** \brief call right after Simulator::Run(), writes the decomposition table
+     */
+    void Finish();
+
+    /** \brief called by a strategy on the receiving node when it schedules a
+     *         deferred relay of \p interest after \p delay seconds
+     */
+    static void Deferred(const ::ndn::Interest& interest, double delay);
+
+    static void Deferred(const ::ndn::Data& data, double delay);
+
+  private:
+    enum PacketKind { INTEREST, DATA, N_PACKET_KINDS };
+
+    enum Component { STRATEGY, DEFER, MAC, AIR, RETX_WAIT, N_COMPONENTS };
+
+    /** \brief timestamps of one packet on one node, in seconds, -1 if not seen
+     */
+    struct Hop {
+        PacketKind kind = INTEREST;
+        double receive = -1;
+        double defer = -1;
+    };
+
+    struct Transmission {
+        double time;
+        uint32_t node;
+    };
+
+    using HopKey = std::pair<uint32_t, uint64_t>;  ///< (node, packet key)
+
+    /** \brief a Data Name is in flight again after this many seconds
+     */
+    static constexpr double STALE_S = 1.0;
+
+    static uint64_t MakeKey(PacketKind kind, uint64_t nameHash, uint32_t nonce);
+
+    static uint64_t HashName(const ::ndn::Interest& interest);
+
+    static uint64_t HashName(const ::ndn::Data& data);
+
+    static void InInterest(HopTracer* tracer, uint32_t node, const ::ndn::Interest& interest,
+                           const ::nfd::face::Face& face);
+
+    static void OutInterest(HopTracer* tracer, uint32_t node, const ::ndn::Interest& interest,
+                            const ::nfd::face::Face& face);
+
+    static void InData(HopTracer* tracer, uint32_t node, const ::ndn::Data& data, const ::nfd::face::Face& face);
+
+    static void OutData(HopTracer* tracer, uint32_t node, const ::ndn::Data& data, const ::nfd::face::Face& face);
+
+    static void TxTrace(HopTracer* tracer, uint32_t node, Ptr<const Packet> packet, WifiMode mode,
+                        WifiPreamble preamble, uint8_t power);
+
+    bool IsSampled(uint64_t key) const { return key % m_sampling == 0; }
+
+    void Receive(uint32_t node, PacketKind kind, uint64_t key, bool local);
+
+    void Defer(uint32_t node, PacketKind kind, uint64_t key, double delay);
+
+    void Send(uint32_t node, uint64_t key, bool local);
+
+    void Transmit(uint32_t node, PacketKind kind, uint64_t key);
+
+    /** \brief counts a packet that was deferred but never sent
+     */
+    void Abandon(const Hop& hop);
+
+  private:
+    std::string m_path;
+    std::string m_strategy;
+    uint32_t m_sampling;
+    std::map<HopKey, Hop> m_hops;  ///< received or deferred, not yet sent
+    std::map<HopKey, double> m_sent;  ///< send time of packets waiting for their TX start
+    bool m_traceTx = false;
+    std::unordered_map<uint64_t, Transmission> m_lastTx;
+    std::map<HopKey, double> m_firstRequest;  ///< (consumer node, Name hash) -> first Interest time
+    std::vector<double> m_samples[N_PACKET_KINDS][N_COMPONENTS];
+    uint64_t m_cancelled[N_PACKET_KINDS] = {};
+
+    static HopTracer* s_active;
+};
+
+}  // namespace ns3
+
+#endif  // HOP_TRACER_HPP
@@ -0,0 +1,223 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "isr-measurements.hpp"
+#include "common/global.hpp"
+
+namespace nfd {
+namespace fw {
+namespace isr {
+
+const time::nanoseconds FaceInfo::RTT_NO_MEASUREMENT{-1};
+const time::nanoseconds FaceInfo::RTT_TIMEOUT{-2};
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+FaceInfo*
+NamespaceInfo::getFaceInfo(FaceId faceId)
+{
+  if (faceId >= m_faceInfos.size() || m_faceInfos[faceId] == nullptr) {
+    return nullptr;
+  }
+  if (isExpired(*m_faceInfos[faceId], time::steady_clock::now())) {
+    m_faceInfos[faceId].reset();
+    --m_nFaceInfos;
+    return nullptr;
+  }
+  return m_faceInfos[faceId].get();
+}
+
+FaceInfo&
+NamespaceInfo::getOrCreateFaceInfo(FaceId faceId)
+{
+  // drops an expired FaceInfo, so that a fresh one is created below
+  FaceInfo* info = getFaceInfo(faceId);
+  if (info != nullptr) {
+    return *info;
+  }
+
+  if (faceId >= m_faceInfos.size()) {
+    m_faceInfos.resize(faceId + 1);
+  }
+  m_faceInfos[faceId] = std::make_unique<FaceInfo>(m_rttEstimatorOpts);
+  ++m_nFaceInfos;
+  extendFaceInfoLifetime(*m_faceInfos[faceId], faceId);
+  return *m_faceInfos[faceId];
+}
+
+const FaceInfo*
+NamespaceInfo::findFaceInfo(FaceId faceId, time::steady_clock::TimePoint now) const
+{
+  if (faceId >= m_faceInfos.size() || m_faceInfos[faceId] == nullptr ||
+      isExpired(*m_faceInfos[faceId], now)) {
+    return nullptr;
+  }
+  return m_faceInfos[faceId].get();
+}
+
+void
+NamespaceInfo::extendFaceInfoLifetime(FaceInfo& info, FaceId)
+{
+  info.m_lastUsed = time::steady_clock::now();
+  if (!m_isSweepScheduled) {
+    scheduleSweep();
+  }
+}
+
+bool
+NamespaceInfo::isExpired(const FaceInfo& info, time::steady_clock::TimePoint now)
+{
+  return now - info.m_lastUsed >= IsrMeasurements::MEASUREMENTS_LIFETIME;
+}
+
+void
+NamespaceInfo::scheduleSweep()
+{
+  m_sweepEvent = getScheduler().schedule(IsrMeasurements::MEASUREMENTS_LIFETIME, [this] { sweep(); });
+  m_isSweepScheduled = true;
+}
+
+void
+NamespaceInfo::sweep()
+{
+  m_isSweepScheduled = false;
+  auto now = time::steady_clock::now();
+  for (auto& info : m_faceInfos) {
+    if (info != nullptr && isExpired(*info, now)) {
+      info.reset();
+      --m_nFaceInfos;
+    }
+  }
+  if (m_nFaceInfos > 0) {
+    scheduleSweep();
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+constexpr time::microseconds IsrMeasurements::MEASUREMENTS_LIFETIME;
+
+IsrMeasurements::IsrMeasurements(MeasurementsAccessor& measurements)
+  : m_measurements(measurements)
+  , m_rttEstimatorOpts(make_shared<ndn::util::RttEstimator::Options>())
+{
+}
+
+FaceInfo*
+IsrMeasurements::getFaceInfo(const fib::Entry& fibEntry, const Interest& interest, FaceId faceId)
+{
+  return getOrCreateNamespaceInfo(fibEntry, interest).getFaceInfo(faceId);
+}
+
+FaceInfo&
+IsrMeasurements::getOrCreateFaceInfo(const fib::Entry& fibEntry, const Interest& interest,
+                                     FaceId faceId)
+{
+  return getOrCreateNamespaceInfo(fibEntry, interest).getOrCreateFaceInfo(faceId);
+}
+
+NamespaceInfo*
+IsrMeasurements::getNamespaceInfo(const Name& prefix)
+{
+  measurements::Entry* me = m_measurements.findLongestPrefixMatch(prefix);
+  if (me == nullptr) {
+    return nullptr;
+  }
+
+  NamespaceInfo* info = me->insertStrategyInfo<NamespaceInfo>(m_rttEstimatorOpts).first;
+  BOOST_ASSERT(info != nullptr);
+
+  // Set or update entry lifetime
+  extendLifetime(*me, *info);
+  return info;
+}
+
+NamespaceInfo&
+IsrMeasurements::getOrCreateNamespaceInfo(const fib::Entry& fibEntry, const Interest& interest)
+{
+  measurements::Entry* me = m_measurements.get(fibEntry);
+
+  // If the FIB entry is not under the strategy's namespace, find a part of the prefix
+  // that falls under the strategy's namespace
+  for (size_t prefixLen = fibEntry.getPrefix().size() + 1;
+       me == nullptr && prefixLen <= interest.getName().size(); ++prefixLen) {
+    me = m_measurements.get(interest.getName().getPrefix(prefixLen));
+  }
+
+  // Either the FIB entry or the Interest's name must be under this strategy's namespace
+  BOOST_ASSERT(me != nullptr);
+
+  NamespaceInfo* info = me->insertStrategyInfo<NamespaceInfo>(m_rttEstimatorOpts).first;
+  BOOST_ASSERT(info != nullptr);
+
+  // Set or update entry lifetime
+  extendLifetime(*me, *info);
+  return *info;
+}
+
+const NamespaceInfo*
+IsrMeasurements::findNamespaceInfo(const fib::Entry& fibEntry, const Interest& interest) const
+{
+  measurements::Entry* me = m_measurements.findExactMatch(fibEntry.getPrefix());
+  if (me == nullptr) {
+    // the FIB entry is not under the strategy's namespace,
+    // the info then lives on a longer prefix of the Interest name
+    me = m_measurements.findLongestPrefixMatch(interest.getName(),
+                                               measurements::EntryWithStrategyInfo<NamespaceInfo>());
+  }
+  return me == nullptr ? nullptr : me->getStrategyInfo<NamespaceInfo>();
+}
+
+void
+IsrMeasurements::measureFace(const NamespaceInfo* namespaceInfo, FaceId faceId, time::steady_clock::TimePoint now,
+                             double& sisr, double& srtt)
+{
+  const FaceInfo* info = namespaceInfo == nullptr ? nullptr : namespaceInfo->findFaceInfo(faceId, now);
+  if (info == nullptr) {
+    sisr = 0;
+    srtt = 0;
+    return;
+  }
+  sisr = info->getSmoothedISR();
+  srtt = 10 - boost::chrono::duration_cast<boost::chrono::duration<double>>(info->getSrtt()).count();
+}
+
+void
+IsrMeasurements::extendLifetime(measurements::Entry& me, NamespaceInfo& info)
+{
+  // Measurements::extendLifetime reschedules the entry's cleanup event on every call
+  auto now = time::steady_clock::now();
+  if (info.m_entryExpiry - now > MEASUREMENTS_LIFETIME / 2) {
+    return;
+  }
+  m_measurements.extendLifetime(me, MEASUREMENTS_LIFETIME);
+  info.m_entryExpiry = now + MEASUREMENTS_LIFETIME;
+}
+
+} // namespace isr
+} // namespace fw
+} // namespace nfd
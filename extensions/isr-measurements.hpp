@@ -23,8 +23,8 @@
  * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
  */
 
-#ifndef NFD_DAEMON_FW_OPT_MEASUREMENTS_HPP
-#define NFD_DAEMON_FW_OPT_MEASUREMENTS_HPP
+#ifndef NFD_DAEMON_FW_ISR_MEASUREMENTS_HPP
+#define NFD_DAEMON_FW_ISR_MEASUREMENTS_HPP
 
 #include "fw/strategy-info.hpp"
 #include "fw/forwarder-counters.hpp"
@@ -34,7 +34,7 @@
 
 namespace nfd {
 namespace fw {
-namespace opt {
+namespace isr {
 
 /** \brief Strategy information for each face in a namespace
 */
@@ -101,15 +101,21 @@ private:
   double m_lastISR = 0.0;
   Name m_lastInterestName;
 
-  // Timeout associated with measurement
-  scheduler::ScopedEventId m_measurementExpiration;
+  // Time of last use; the info expires MEASUREMENTS_LIFETIME after it
+  time::steady_clock::TimePoint m_lastUsed;
   friend class NamespaceInfo;
 };
 
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
+class IsrMeasurements;
+
 /** \brief Stores strategy information about each face in this namespace
+ *
+ *  FaceInfos are not removed by a timer of their own. An expired FaceInfo is
+ *  dropped when it is next looked up, or by a sweep that runs at most once per
+ *  MEASUREMENTS_LIFETIME while the namespace has any FaceInfo.
  */
 class NamespaceInfo : public StrategyInfo
 {
@@ -132,24 +138,50 @@ public:
   FaceInfo&
   getOrCreateFaceInfo(FaceId faceId);
 
+  /** \brief read-only lookup, an expired FaceInfo is reported as absent but not removed
+   */
+  const FaceInfo*
+  findFaceInfo(FaceId faceId, time::steady_clock::TimePoint now) const;
+
+  /** \brief mark \p info as used now; does not touch the scheduler
+   */
   void
   extendFaceInfoLifetime(FaceInfo& info, FaceId faceId);
 
 private:
-  std::unordered_map<FaceId, FaceInfo> m_fiMap;
+  static bool
+  isExpired(const FaceInfo& info, time::steady_clock::TimePoint now);
+
+  void
+  scheduleSweep();
+
+  void
+  sweep();
+
+private:
+  // indexed by FaceId; FaceIds are small and dense in a simulation
+  std::vector<unique_ptr<FaceInfo>> m_faceInfos;
+  size_t m_nFaceInfos = 0;
   shared_ptr<const ndn::util::RttEstimator::Options> m_rttEstimatorOpts;
+  scheduler::ScopedEventId m_sweepEvent;
+  bool m_isSweepScheduled = false;
+  // expiry of the measurements entry holding this info, as last set by IsrMeasurements
+  time::steady_clock::TimePoint m_entryExpiry;
+  friend class IsrMeasurements;
 };
 
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
 /** \brief Helper class to retrieve and create strategy measurements
+ *
+ *  Per-face ISR and RTT of a namespace, shared by the OPT and CCAF strategies.
  */
-class OptMeasurements : noncopyable
+class IsrMeasurements : noncopyable
 {
 public:
   explicit
-  OptMeasurements(MeasurementsAccessor& measurements);
+  IsrMeasurements(MeasurementsAccessor& measurements);
 
   FaceInfo*
   getFaceInfo(const fib::Entry& fibEntry, const Interest& interest, FaceId faceId);
@@ -163,9 +195,28 @@ public:
   NamespaceInfo&
   getOrCreateNamespaceInfo(const fib::Entry& fibEntry, const Interest& interest);
 
+  /** \brief find the NamespaceInfo getOrCreateNamespaceInfo would return, without
+   *         creating entries or extending their lifetime
+   *
+   *  Meant to be resolved once per Interest, then queried with NamespaceInfo::findFaceInfo
+   *  for every candidate face.
+   */
+  const NamespaceInfo*
+  findNamespaceInfo(const fib::Entry& fibEntry, const Interest& interest) const;
+
+  /** \brief SISR and SRTT of \p faceId as ranked by OPT and CCAF, both 0 without measurements
+   *
+   *  SRTT is turned into a benefit criterion, 10 - SRTT in seconds.
+   */
+  static void
+  measureFace(const NamespaceInfo* namespaceInfo, FaceId faceId, time::steady_clock::TimePoint now,
+              double& sisr, double& srtt);
+
 private:
+  /** \brief extend the lifetime of \p me once less than half of it remains
+   */
   void
-  extendLifetime(measurements::Entry& me);
+  extendLifetime(measurements::Entry& me, NamespaceInfo& info);
 
 public:
   static constexpr time::microseconds MEASUREMENTS_LIFETIME = 5_min;
@@ -175,8 +226,8 @@ private:
   shared_ptr<const ndn::util::RttEstimator::Options> m_rttEstimatorOpts;
 };
 
-} // namespace opt
+} // namespace isr
 } // namespace fw
 } // namespace nfd
 
-#endif // NFD_DAEMON_FW_OPT_MEASUREMENTS_HPP
+#endif // NFD_DAEMON_FW_ISR_MEASUREMENTS_HPP
@@ -0,0 +1,188 @@
+#include "memory-report.hpp"
+
+#include "generic-link-service-m.hpp"
+#include "name-interner.hpp"
+#include "ndn-neighbor-table.hpp"
+#include "node-registry.hpp"
+#include "run-report.hpp"
+#include "table-size-reporter.hpp"
+
+#include "ns3/log.h"
+#include "ns3/node-list.h"
+#include "ns3/simulator.h"
+#include "ns3/ndnSIM/model/ndn-l3-protocol.hpp"
+#include "ns3/ndnSIM/NFD/daemon/fw/forwarder.hpp"
+#include "ns3/ndnSIM/NFD/daemon/table/cs.hpp"
+
+#include <unistd.h>
+
+#include <set>
+
+NS_LOG_COMPONENT_DEFINE("MemoryReport");
+
+namespace ns3 {
+
+namespace {
+
+/** \return current resident set size of this process in KiB, 0 if unknown
+ */
+uint64_t
+getCurrentRss() {
+    std::ifstream statm("/proc/self/statm");
+    uint64_t size = 0, resident = 0;
+    if (!(statm >> size >> resident)) {
+        return 0;
+    }
+    return resident * sysconf(_SC_PAGESIZE) / 1024;
+}
+
+}  // namespace
+
+MemoryReport::MemoryReport(const std::string& path, Time interval) : m_path(path), m_interval(interval) {}
+
+void MemoryReport::Start() {
+    if (!IsEnabled()) {
+        return;
+    }
+    m_os.open(m_path);
+    if (!m_os) {
+        NS_LOG_ERROR("cannot write memory report to " << m_path);
+        m_path.clear();
+        return;
+    }
+    m_os << "time_s,subsystem,entries,bytes,max_node_entries\n";
+    m_event = Simulator::ScheduleNow(&MemoryReport::DoSample, this);
+}
+
+void MemoryReport::Finish() {
+    if (!IsEnabled()) {
+        return;
+    }
+    Simulator::Cancel(m_event);
+    Write(Collect());
+
+    std::ofstream os(m_path + ".peak.csv");
+    os << "subsystem,peak_entries,peak_bytes,peak_max_node_entries,peak_time_s\n";
+    for (const auto& item : m_peaks) {
+        const Peak& peak = item.second;
+        os << item.first << "," << peak.usage.entries << "," << peak.usage.bytes << ","
+           << peak.usage.maxNodeEntries << "," << peak.time << "\n";
+    }
+    NS_LOG_INFO("memory report written to " << m_path);
+}
+
+void MemoryReport::DoSample() {
+    Write(Collect());
+    if (!m_interval.IsStrictlyPositive()) {
+        return;
+    }
+    m_event = Simulator::Schedule(m_interval, &MemoryReport::DoSample, this);
+}
+
+MemoryReport::Sample MemoryReport::Collect() const {
+    Sample sample;
+    auto add = [&sample](const std::string& subsystem, uint64_t entries, uint64_t bytes) {
+        Usage& usage = sample[subsystem];
+        usage.entries += entries;
+        usage.bytes += bytes;
+        usage.maxNodeEntries = std::max(usage.maxNodeEntries, entries);
+    };
+
+    std::vector<::nfd::fw::TableSizeReporter::TableSize> tables;
+    for (NodeList::Iterator it = NodeList::Begin(); it != NodeList::End(); ++it) {
+        Ptr<ndn::L3Protocol> l3 = (*it)->GetObject<ndn::L3Protocol>();
+        if (l3 == nullptr) {
+            continue;
+        }
+        ::nfd::Forwarder& forwarder = *l3->getForwarder();
+
+        Ptr<ndn::NeighborTable> neighbors = (*it)->GetObject<ndn::NeighborTable>();
+        if (neighbors != nullptr) {
+            add("neighbor_table", neighbors->GetN(), neighbors->GetBytes());
+        }
+
+        uint64_t fragments = 0;
+        for (const ::nfd::face::Face& face : forwarder.getFaceTable()) {
+            auto linkService = dynamic_cast<const ::nfd::face::GenericLinkServiceM*>(face.getLinkService());
+            if (linkService != nullptr) {
+                fragments += linkService->getReassemblerSize();
+            }
+        }
+        add("faces", forwarder.getFaceTable().size(),
+            forwarder.getFaceTable().size() * (sizeof(::nfd::face::Face) + sizeof(::nfd::face::GenericLinkServiceM)));
+        add("link_service.reassembly", fragments, fragments * ::ndn::MAX_NDN_PACKET_SIZE);
+
+        add("name_tree", forwarder.getNameTree().size(),
+            forwarder.getNameTree().size() * sizeof(::nfd::name_tree::Entry));
+
+        uint64_t pitBytes = 0;
+        for (const ::nfd::pit::Entry& entry : forwarder.getPit()) {
+            pitBytes += sizeof(::nfd::pit::Entry) + entry.getInterest().wireEncode().size() +
+                        entry.getInRecords().size() * sizeof(::nfd::pit::InRecord) +
+                        entry.getOutRecords().size() * sizeof(::nfd::pit::OutRecord);
+        }
+        add("pit", forwarder.getPit().size(), pitBytes);
+
+        uint64_t csBytes = 0;
+        for (const ::nfd::cs::Entry& entry : forwarder.getCs()) {
+            csBytes += sizeof(::nfd::cs::Entry) + entry.getData().wireEncode().size();
+        }
+        add("cs", forwarder.getCs().size(), csBytes);
+
+        add("measurements", forwarder.getMeasurements().size(),
+            forwarder.getMeasurements().size() * sizeof(::nfd::measurements::Entry));
+
+        uint64_t nexthops = 0;
+        for (const ::nfd::fib::Entry& entry : forwarder.getFib()) {
+            nexthops += entry.getNextHops().size();
+        }
+        add("fib.entries", forwarder.getFib().size(), forwarder.getFib().size() * sizeof(::nfd::fib::Entry));
+        add("fib.nexthops", nexthops, nexthops * sizeof(::nfd::fib::NextHop));
+
+        // several namespaces may share one strategy instance
+        std::set<const ::nfd::fw::Strategy*> strategies;
+        for (const auto& entry : forwarder.getStrategyChoice()) {
+            const ::nfd::fw::Strategy* strategy = &entry.getStrategy();
+            if (!strategies.insert(strategy).second) {
+                continue;
+            }
+            auto reporter = dynamic_cast<const ::nfd::fw::TableSizeReporter*>(strategy);
+            if (reporter == nullptr) {
+                continue;
+            }
+            tables.clear();
+            reporter->reportTableSizes(tables);
+            for (const auto& table : tables) {
+                add("strategy." + table.name, table.entries, table.bytes);
+            }
+        }
+    }
+
+    const ndn::NodeRegistry& registry = ndn::NodeRegistry::Get();
+    add("node_registry", registry.GetN(), registry.GetBytes());
+    const ::nfd::fw::NameInterner& interner = ::nfd::fw::NameInterner::get();
+    add("name_interner", interner.size(), interner.getBytes());
+
+    Usage& process = sample["process.rss"];
+    process.bytes = getCurrentRss() * 1024;
+    Usage& peak = sample["process.peak_rss"];
+    peak.bytes = RunReport::GetPeakRss() * 1024;
+    return sample;
+}
+
+void MemoryReport::Write(const Sample& sample) {
+    double now = Simulator::Now().GetSeconds();
+    for (const auto& item : sample) {
+        const Usage& usage = item.second;
+        m_os << now << "," << item.first << "," << usage.entries << "," << usage.bytes << ","
+             << usage.maxNodeEntries << "\n";
+        Peak& peak = m_peaks[item.first];
+        if (usage.bytes >= peak.usage.bytes) {
+            peak.usage = usage;
+            peak.time = now;
+        }
+    }
+    m_os.flush();
+}
+
+}  // namespace ns3
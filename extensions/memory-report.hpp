@@ -0,0 +1,73 @@
+#ifndef MEMORY_REPORT_HPP
+#define MEMORY_REPORT_HPP
+
+#include "ns3/event-id.h"
+#include "ns3/nstime.h"
+
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <string>
+
+namespace ns3 {
+
+/**
+ * \brief samples memory use per subsystem during a simulation run
+ *
+ * Every interval, and once more at shutdown, walks all nodes and counts the
+ * entries of faces, link-service reassembly buffers, name tree, PIT, CS,
+ * Measurements, FIB nexthops, beacon neighbor tables, the shared
+ * ndn::NodeRegistry and nfd::fw::NameInterner, and every strategy table
+ * exposed through nfd::fw::TableSizeReporter. Byte figures are estimates from sizeof and
+ * wire sizes, meant for spotting tables that grow super-linearly with the
+ * number of vehicles, not for exact accounting.
+ *
+ * Writes one CSV row per (sample, subsystem) to the given path and the peak
+ * of every subsystem to path + ".peak.csv". Nothing is sampled when the path
+ * is empty.
+ */
+class MemoryReport {
+  public:
+    MemoryReport(const std::string& path, Time interval);
+
+    bool IsEnabled() const { return !m_path.empty(); }
+
+    /** \brief call right before Simulator::Run(), schedules the periodic samples
+     */
+    void Start();
+
+    /** \brief call right after Simulator::Run() and before Simulator::Destroy()
+     */
+    void Finish();
+
+  private:
+    struct Usage {
+        uint64_t entries = 0;
+        uint64_t bytes = 0;
+        uint64_t maxNodeEntries = 0;  ///< largest per-node entry count
+    };
+
+    struct Peak {
+        Usage usage;
+        double time = 0;
+    };
+
+    using Sample = std::map<std::string, Usage>;
+
+    void DoSample();
+
+    Sample Collect() const;
+
+    void Write(const Sample& sample);
+
+  private:
+    std::string m_path;
+    Time m_interval;
+    std::ofstream m_os;
+    std::map<std::string, Peak> m_peaks;
+    EventId m_event;
+};
+
+}  // namespace ns3
+
+#endif  // MEMORY_REPORT_HPP
@@ -1,5 +1,6 @@
 #include "mupf.hpp"
 #include "common/logger.hpp"
+#include "ndn-fib-helper-m.hpp"
 #include "ndn-wifi-net-device-transport.hpp"
 #include "ns3/mobility-model.h"
 #include "ns3/ndnSIM/NFD/daemon/fw/algorithm.hpp"
@@ -10,6 +11,8 @@
 #include "ns3/node.h"
 #include "ns3/node-container.h"
 #include "ns3/ptr.h"
+#include "strategy-profiler.hpp"
+#include "vanet-kernels.hpp"
 #include <cmath>
 #include <ndn-cxx/lp/empty-value.hpp>
 #include <ndn-cxx/lp/prefix-announcement-header.hpp>
@@ -34,14 +37,16 @@ const time::milliseconds MUPF::RETX_SUPPRESSION_MAX(250);
 MUPF::MUPF(Forwarder& forwarder, const Name& name)
     : Strategy(forwarder),
       ProcessNackTraits(this),
-      m_nodes(ns3::NodeContainer::GetGlobal()),
+      m_nodes(ns3::ndn::NodeRegistry::Get()),
       m_retxSuppression(RETX_SUPPRESSION_INITIAL,
                         RetxSuppressionExponential::DEFAULT_MULTIPLIER,
                         RETX_SUPPRESSION_MAX) {
     ParsedInstanceName parsed = parseInstanceName(name);
-    if (!parsed.parameters.empty()) {
-        NDN_THROW(std::invalid_argument("MUPF does not accept parameters"));
-    }
+    StrategyParameters params("MUPF", parsed.parameters);
+    m_mu = params.get("mu", Mu);
+    m_phi = params.get("phi", Phi);
+    m_omega = params.get("omega", Omega);
+    params.checkUnused();
     if (parsed.version &&
         *parsed.version != getStrategyName()[-1].toVersion()) {
         NDN_THROW(std::invalid_argument("MUPF does not support version " +
@@ -60,6 +65,7 @@ void MUPF::afterReceiveInterest(const FaceEndpoint& ingress,
                                const Interest& interest,
                                const shared_ptr<pit::Entry>& pitEntry)
 {
+    STRATEGY_PROFILE("MUPF");
     const fib::Entry& fibEntry = this->lookupFib(*pitEntry);
     const Name prefix = fibEntry.getPrefix();
     const fib::NextHopList& nexthops = fibEntry.getNextHops();
@@ -84,6 +90,7 @@ void MUPF::afterReceiveInterest(const FaceEndpoint& ingress,
 void
 MUPF::beforeSatisfyInterest(const shared_ptr<pit::Entry>& pitEntry,
                         const FaceEndpoint& ingress, const Data& data) {
+    STRATEGY_PROFILE("MUPF");
 
     // NFD_LOG_DEBUG("beforeSatisfyInterest pitEntry=" << pitEntry->getName()
     //             << " in=" << ingress << " data=" << data.getName());
@@ -119,6 +126,7 @@ void
 MUPF::afterContentStoreHit(const shared_ptr<pit::Entry>& pitEntry,
                                const FaceEndpoint& ingress, const Data& data)
 {
+STRATEGY_PROFILE("MUPF");
 //   NFD_LOG_DEBUG("afterContentStoreHit pitEntry=" << pitEntry->getName()
 //                 << " in=" << ingress << " data=" << data.getName());
   this->sendData(pitEntry, data, ingress);
@@ -129,6 +137,7 @@ void
 MUPF::afterReceiveData(const shared_ptr<pit::Entry>& pitEntry,
                            const FaceEndpoint& ingress, const Data& data)
 {
+    STRATEGY_PROFILE("MUPF");
     this->beforeSatisfyInterest(pitEntry, ingress, data);
 	this->sendDataToAll(pitEntry, ingress, data);
     NFD_LOG_DEBUG("do Send Data="<<data.getName()<<", from="<<ingress);
@@ -151,6 +160,18 @@ MUPF::contentDiscovery(const FaceEndpoint& ingress, const Interest& interest, co
         // NFD_LOG_DEBUG("Set Requester ID="<<interest.getTag<lp::CongestionMarkTag>()->get());
     }
 
+    // 安装了信标时只向邻居表中范围内的邻居转发
+    if (this->updateNeighborTable(localNode)) {
+        ns3::Vector localPos = m_nodes.GetMobility(localNode->GetId())->GetPosition();
+        for (const auto& neighbor : m_NT) {
+            uint32_t othNodeId = neighbor.nodeId;
+            Face* face = this->getFace(256 + othNodeId + (othNodeId < localNode->GetId()));
+            if (face == nullptr || ingress.face.getId() == face->getId() || ns3::CalculateDistance(localPos, neighbor.position) > Rth) { continue; }
+            this->sendInterest(pitEntry, FaceEndpoint(*face, 0), interest);
+        }
+        NFD_LOG_DEBUG("do Send Interest=" << interest << " Broadcast from=" << ingress);
+        return;
+    }
     for (const auto& nexthop : nexthops) {
         uint32_t othNodeId = (nexthop.getFace().getId() - 257) + (localNode->GetId() + 257 <= nexthop.getFace().getId());
         ns3::Ptr<ns3::Node>othNode = m_nodes[othNodeId];
@@ -163,10 +184,10 @@ MUPF::contentDiscovery(const FaceEndpoint& ingress, const Interest& interest, co
 
 void
 MUPF::unicastPathBuilding(const ndn::Name prefix, ns3::Ptr<ns3::Node> srcNode, ns3::Ptr<ns3::Node> providerNode) {
-    // 巨坑！保存路径，以防止路径环路
-    if (m_path.empty()) {
-        m_path.emplace(providerNode, std::set<ns3::Ptr<ns3::Node>>{srcNode});
-    }
+    // 重建路径时先删除旧路径上的路由
+    this->removePathRoutes(providerNode);
+    // 巨坑！保存路径，以防止路径环路; 每次建路都从请求者重新记录
+    m_path[providerNode] = {srcNode};
     // if (m_path[providerNode].count(providerNode)) {
     //     NFD_LOG_DEBUG("Path Build for Provider="<<providerNode->GetId()<<" Finished.");
     //     return;
@@ -180,7 +201,7 @@ MUPF::unicastPathBuilding(const ndn::Name prefix, ns3::Ptr<ns3::Node> srcNode, n
             double dis = this->calculateDistance(node, srcNode, providerNode);
             double dir = this->calculateDirection(node, srcNode, providerNode);
             double den = this->calculateDensity(node);
-            double score = Mu*dis + Phi*dir + Omega*den;
+            double score = m_mu*dis + m_phi*dir + m_omega*den;
             weightTableEntry entry = {node, dis, dir, den, score};
             weightTable.push_back(entry);
         }
@@ -189,10 +210,11 @@ MUPF::unicastPathBuilding(const ndn::Name prefix, ns3::Ptr<ns3::Node> srcNode, n
             return;
         }
         ns3::Ptr<ns3::Node> selectNode = std::max_element(weightTable.begin(), weightTable.end(), [](const auto& a, const auto& b) { return a.Score<b.Score;})->node;
-        ns3::Ptr<ns3::ndn::L3Protocol> ndn = srcNode->GetObject<ns3::ndn::L3Protocol>();
+        ns3::ndn::L3Protocol* ndn = m_nodes.GetL3(srcNode->GetId());
         uint32_t faceId = (selectNode->GetId()+256) + (selectNode->GetId() < srcNode->GetId());
         shared_ptr<Face> face = ndn->getFaceById(faceId);
-        ns3::ndn::FibHelper::AddRoute(srcNode, prefix, face, 1);
+        ns3::ndn::FibHelperM::AddRoute(srcNode, prefix, face, 1, this);
+        m_pathRoutes[providerNode].push_back({srcNode, prefix, face});
         // NFD_LOG_DEBUG("Add Route: Node="<<srcNode->GetId()<<", Prefix="<<prefix<<", Face="<<faceId);
         srcNode = selectNode;
 
@@ -201,16 +223,34 @@ MUPF::unicastPathBuilding(const ndn::Name prefix, ns3::Ptr<ns3::Node> srcNode, n
         auto it = pair->second.insert(selectNode);
         NS_ASSERT(it.second);
     }
-    ns3::Ptr<ns3::ndn::L3Protocol> ndn = srcNode->GetObject<ns3::ndn::L3Protocol>();
+    ns3::ndn::L3Protocol* ndn = m_nodes.GetL3(srcNode->GetId());
     uint32_t faceId = (providerNode->GetId()+256) + (providerNode->GetId() < srcNode->GetId());
     shared_ptr<Face> face = ndn->getFaceById(faceId);
-    ns3::ndn::FibHelper::AddRoute(srcNode, prefix, face, 1);
+    ns3::ndn::FibHelperM::AddRoute(srcNode, prefix, face, 1, this);
+    m_pathRoutes[providerNode].push_back({srcNode, prefix, face});
     m_path[providerNode].emplace(srcNode);
     m_hadContentDiscovery[providerNode] = true;
+    // 路径上的FIB表项应与经RIB(CHILD_INHERIT)安装时相同
+    for (const auto& route : m_pathRoutes[providerNode]) {
+        NS_ASSERT(ns3::ndn::FibHelperM::IsInherited(route.node, route.prefix));
+    }
     // NFD_LOG_DEBUG("Add Route: Node="<<srcNode->GetId()<<", Prefix="<<prefix<<", Face="<<faceId);
     // NFD_LOG_DEBUG("Path Build Succeeful!");
 }
 
+void
+MUPF::removePathRoutes(ns3::Ptr<ns3::Node> providerNode) {
+    auto it = m_pathRoutes.find(providerNode);
+    if (it == m_pathRoutes.end()) {
+        return;
+    }
+    for (const auto& route : it->second) {
+        ns3::ndn::FibHelperM::RemoveRoute(route.node, route.prefix, *route.face, this);
+    }
+    m_pathRoutes.erase(it);
+    m_hadContentDiscovery.erase(providerNode);
+}
+
 nfd::fib::NextHop
 MUPF::selectFIB(const fib::NextHopList& nexthops) {
     const auto transport = nexthops.begin()->getFace().getTransport();
@@ -219,6 +259,24 @@ MUPF::selectFIB(const fib::NextHopList& nexthops) {
     if (selectedHop.getFace().getId() == 256+m_nodes.GetN()) {return selectedHop;}
     ns3::Ptr<ns3::Node> localNode = wifiTrans->GetNode();
     double highestValue = 0.0;
+    // 安装了信标时从邻居表读取下一跳的位置和速度, 不在表中的下一跳视为不可达
+    if (this->findNeighborTable(localNode)) {
+        ns3::MobilityModel* mobility = m_nodes.GetMobility(localNode->GetId());
+        ns3::Time now = ns3::Simulator::Now();
+        for (const auto& nexthop : nexthops) {
+            uint32_t faceId = nexthop.getFace().getId();
+            uint32_t othNodeId = (faceId - 257) + (localNode->GetId() + 257 <= faceId);
+            const ns3::ndn::NeighborTable::Entry* entry = m_neighborTable->Find(othNodeId);
+            if (entry == nullptr) { continue; }
+            double let = this->calculateLET(mobility->GetPosition(), mobility->GetVelocity(), entry->GetPosition(now), entry->velocity);
+            double final_value = Alpha*let + Beta*this->calculateLAP(let, 2.0);
+            if (final_value > highestValue) {
+                highestValue = final_value;
+                selectedHop = nexthop;
+            }
+        }
+        return selectedHop;
+    }
     for (const auto& nexthop : nexthops) { 
         uint32_t faceId = nexthop.getFace().getId();
         uint32_t othNodeId = (faceId - 257) + (localNode->GetId() + 257 <= faceId);
@@ -275,21 +333,12 @@ MUPF::calculateDirection(ns3::Ptr<ns3::Node> node, ns3::Ptr<ns3::Node> srcNode,
 
 double
 MUPF::calculateDensity(ns3::Ptr<ns3::Node> node){
-    int num_avg = 0;
-    double num_con=0.0; // 网络平均连接度
-    for (const auto& node1 :  m_nodes) {
-        int num_neighbor = 0;
-        for (const auto& node2 : m_nodes) {
-            double d = ns3::CalculateDistance(node1->GetObject<ns3::MobilityModel>()->GetPosition(), node2->GetObject<ns3::MobilityModel>()->GetPosition());
-            num_neighbor += (d<Rth);
-        }
-        num_neighbor -= 1; // 去掉自身
-        if (node1 == node) { num_avg = num_neighbor;}
-        num_con += num_neighbor;
+    std::vector<ns3::Vector> positions;
+    positions.reserve(m_nodes.GetN());
+    for (const auto& other : m_nodes) {
+        positions.push_back(m_nodes.GetMobility(other->GetId())->GetPosition());
     }
-    num_con = num_con / m_nodes.GetN();
-    double td = num_avg / num_con;
-    return std::min(td, 1.0);
+    return vanet::trafficDensity(positions, node->GetId(), Rth);
 }
 
 double
@@ -297,22 +346,37 @@ MUPF::calculateLET(ns3::Ptr<ns3::Node> sendNode, ns3::Ptr<ns3::Node> revNode) {
     if (!isInRegion(sendNode, revNode)) { return 0;}
     ns3::Ptr<ns3::MobilityModel> mobility1 = sendNode->GetObject<ns3::MobilityModel>();
 	ns3::Ptr<ns3::MobilityModel> mobility2 = revNode->GetObject<ns3::MobilityModel>();
-    double m = mobility1->GetPosition().x - mobility2->GetPosition().x;
-    double n = mobility1->GetPosition().y - mobility2->GetPosition().y;
-    double p = mobility1->GetVelocity().x - mobility2->GetVelocity().x;
-    double q = mobility1->GetVelocity().y - mobility2->GetVelocity().y;
-    if (p==0 && q==0) {return 1e6;} //相对速度为0时，用1e6表示无限大
-    double let = (-(m*p+n*q)+sqrt((pow(p,2)+pow(q,2))*pow(Rth,2) - pow(n*p-m*q, 2)) ) / (pow(p,2)+pow(q,2));
-    return let;
+    return vanet::linkExpirationTime(mobility1->GetPosition(), mobility1->GetVelocity(),
+                                     mobility2->GetPosition(), mobility2->GetVelocity(), Rth);
 }
 
 double
 MUPF::calculateLAP(double t, double delta_t) {
-    if (t==0) {return 0;}
-    double lambda = 10;
-    double L = (1.0-exp(-2*lambda*t)) * (1.0/(2*lambda*t)) + 0.5*lambda*t*exp(-2*lambda*t);
-    double prob = delta_t <= t ?  (1.0-(1.0-L)/t * delta_t) : L/(log(delta_t-t+1)+1);
-    return prob;
+    return vanet::linkAvailabilityProbability(t, delta_t);
+}
+
+bool
+MUPF::findNeighborTable(ns3::Ptr<ns3::Node> localNode) {
+    if (m_neighborTable == nullptr) {
+        m_neighborTable = ns3::PeekPointer(localNode->GetObject<ns3::ndn::NeighborTable>());
+    }
+    return m_neighborTable != nullptr;
+}
+
+bool
+MUPF::updateNeighborTable(ns3::Ptr<ns3::Node> localNode) {
+    if (!this->findNeighborTable(localNode)) {
+        return false;
+    }
+    m_neighborTable->GetLinks(localNode, Rth, m_NT);
+    return true;
+}
+
+double
+MUPF::calculateLET(const ns3::Vector& sendPos, const ns3::Vector& sendVel, const ns3::Vector& revPos, const ns3::Vector& revVel) {
+    // 与calculateLET(sendNode, revNode)一致, 超出通信范围时LET为0
+    if (ns3::CalculateDistance(sendPos, revPos) > Rth) { return 0;}
+    return vanet::linkExpirationTime(sendPos, sendVel, revPos, revVel, Rth);
 }
 
 bool
@@ -327,7 +391,7 @@ ns3::Ptr<ns3::Node>
 MUPF::getNode(MUPF& local_strategy) {
     ns3::Ptr<ns3::Node> localNode;
     for(auto& node : m_nodes) {
-        ns3::Ptr<ns3::ndn::L3Protocol> ndn = node->GetObject<ns3::ndn::L3Protocol>();
+        ns3::ndn::L3Protocol* ndn = m_nodes.GetL3(node->GetId());
         ndn::Name prefix("/");
         nfd::fw::Strategy& strategy = ndn->getForwarder()->getStrategyChoice().findEffectiveStrategy(prefix);
         nfd::fw::MUPF& mupf_strategy = dynamic_cast<nfd::fw::MUPF&>(strategy);
@@ -338,5 +402,22 @@ MUPF::getNode(MUPF& local_strategy) {
     return localNode;
 }
 
+void
+MUPF::reportTableSizes(std::vector<TableSize>& tables) const {
+    tables.push_back(makeTableSize("MUPF::m_hadContentDiscovery", m_hadContentDiscovery));
+    tables.push_back(makeTableSize("MUPF::m_WT", m_WT));
+    tables.push_back(makeTableSize("MUPF::m_NT", m_NT));
+    TableSize path = makeTableSize("MUPF::m_path", m_path);
+    for (const auto& entry : m_path) {
+        path.bytes += estimateBytes(entry.second);
+    }
+    tables.push_back(path);
+    TableSize pathRoutes = makeTableSize("MUPF::m_pathRoutes", m_pathRoutes);
+    for (const auto& entry : m_pathRoutes) {
+        pathRoutes.bytes += estimateBytes(entry.second);
+    }
+    tables.push_back(pathRoutes);
+}
+
 }  // namespace fw
 }  // namespace nfd
\ No newline at end of file
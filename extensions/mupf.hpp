@@ -4,15 +4,18 @@
 #include "ns3/ndnSIM/NFD/daemon/fw/strategy.hpp"
 #include "ns3/ndnSIM/NFD/daemon/fw/process-nack-traits.hpp"
 #include "ns3/ndnSIM/NFD/daemon/fw/retx-suppression-exponential.hpp"
-#include "ns3/node-container.h"
+#include "node-registry.hpp"
+#include "strategy-parameters.hpp"
+#include "ndn-neighbor-table.hpp"
 #include "ns3/node.h"
 #include "ns3/vector.h"
+#include "table-size-reporter.hpp"
 namespace nfd
 {
 namespace fw
 {
 
-class MUPF : public Strategy, public ProcessNackTraits<MUPF>
+class MUPF : public Strategy, public TableSizeReporter, public ProcessNackTraits<MUPF>
 {
 struct  weightTableEntry {
 	ns3::Ptr<ns3::Node> node;
@@ -23,21 +26,15 @@ struct  weightTableEntry {
 	weightTableEntry(ns3::Ptr<ns3::Node> n, double distance, double direction, double density, double score) : node(n), Dis(distance), Dir(direction), TD(density), Score(score) {}
 };
 
-struct  neighborTableEntry {
-	ns3::Ptr<ns3::Node> node;
-    ns3::Vector3D position;
-    ns3::Vector3D velocity;
-    double LET;
-    double linkProb;
-	neighborTableEntry(ns3::Ptr<ns3::Node> n, ns3::Vector3D pos, ns3::Vector3D vel, double let, double prob) : node(n), position(pos), velocity(vel), LET(let), linkProb(prob) {}
-};
-
 public:
 	explicit MUPF(Forwarder &forwarder, const Name &name = getStrategyName());
 
 	static const Name &
 	getStrategyName();
 
+	void
+	reportTableSizes(std::vector<TableSize>& tables) const override;
+
 	void
 	afterReceiveInterest(const FaceEndpoint &ingress, const Interest &interest,
 						 const shared_ptr<pit::Entry> &pitEntry) override;
@@ -60,6 +57,10 @@ public:
     void
     unicastPathBuilding(const ndn::Name prefix, ns3::Ptr<ns3::Node> srcNode, ns3::Ptr<ns3::Node> providerNode);
 
+    /*删除到Provider的路径上已添加的路由，在路径重建时调用*/
+    void
+    removePathRoutes(ns3::Ptr<ns3::Node> providerNode);
+
     /*在FIB中选择下一跳*/
     nfd::fib::NextHop
     selectFIB(const fib::NextHopList& nexthops);
@@ -84,6 +85,10 @@ public:
 	double
 	calculateLET(ns3::Ptr<ns3::Node> sendNode, ns3::Ptr<ns3::Node> revNode);
 
+	/*由位置和速度计算LET, 用于邻居表*/
+	double
+	calculateLET(const ns3::Vector& sendPos, const ns3::Vector& sendVel, const ns3::Vector& revPos, const ns3::Vector& revVel);
+
     /*计算链路可用概率*/
     double
     calculateLAP(double t, double delta_t);
@@ -92,6 +97,14 @@ public:
     bool
     isInRegion(ns3::Ptr<ns3::Node> sendNode, ns3::Ptr<ns3::Node> recvNode);
 
+    /*查找信标维护的邻居表, 节点未安装信标时返回false*/
+    bool
+    findNeighborTable(ns3::Ptr<ns3::Node> localNode);
+
+    /*用邻居表刷新m_NT, 节点未安装信标时返回false*/
+    bool
+    updateNeighborTable(ns3::Ptr<ns3::Node> localNode);
+
     /* 得到当前node
      * 通过判断this指针与哪个node的strategy指向相同对象，来判别当前的node
     */
@@ -104,14 +117,27 @@ private:
     static const double Mu;
     static const double Phi;
     static const double Omega;
+    // 实例名参数mu~, phi~, omega~可覆盖以上权重
+    double m_mu = Mu;
+    double m_phi = Phi;
+    double m_omega = Omega;
     static const double Alpha;
     static const double Beta;
 
-    ns3::NodeContainer m_nodes;
+    const ns3::ndn::NodeRegistry& m_nodes;
     std::unordered_map<ns3::Ptr<ns3::Node>, bool> m_hadContentDiscovery;
 	std::vector<MUPF::weightTableEntry> m_WT;
-	std::vector<MUPF::neighborTableEntry> m_NT;
+	std::vector<ns3::ndn::NeighborTable::Link> m_NT;
+	ns3::ndn::NeighborTable* m_neighborTable = nullptr;
     std::unordered_map<ns3::Ptr<ns3::Node>,  std::set<ns3::Ptr<ns3::Node>>> m_path;
+    // 每条路径上添加的路由(节点, 前缀, Face), 用于重建路径时删除旧路由
+    // FibHelperM按实例计数, 其他请求者仍在使用的中继路由不会被删除
+    struct pathRoute {
+        ns3::Ptr<ns3::Node> node;
+        ndn::Name prefix;
+        shared_ptr<Face> face;
+    };
+    std::unordered_map<ns3::Ptr<ns3::Node>, std::vector<pathRoute>> m_pathRoutes;
 
 	PUBLIC_WITH_TESTS_ELSE_PRIVATE : static const time::milliseconds RETX_SUPPRESSION_INITIAL;
 	static const time::milliseconds RETX_SUPPRESSION_MAX;
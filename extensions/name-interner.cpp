@@ -0,0 +1,40 @@
+#include "name-interner.hpp"
+
+namespace nfd {
+namespace fw {
+
+constexpr NameInterner::Id NameInterner::INVALID_ID;
+
+NameInterner& NameInterner::get() {
+    static NameInterner interner;
+    return interner;
+}
+
+NameInterner::Id NameInterner::intern(const Name& name) {
+    auto it = m_ids.find(name);
+    if (it != m_ids.end()) {
+        return it->second;
+    }
+    Id id = m_names.size();
+    it = m_ids.emplace(name, id).first;
+    m_names.push_back(&it->first);
+    m_hashes.push_back(m_ids.hash_function()(name));
+    return id;
+}
+
+NameInterner::Id NameInterner::find(const Name& name) const {
+    auto it = m_ids.find(name);
+    return it != m_ids.end() ? it->second : INVALID_ID;
+}
+
+size_t NameInterner::getBytes() const {
+    size_t bytes = m_names.capacity() * sizeof(const Name*) + m_hashes.capacity() * sizeof(size_t) +
+                   m_ids.bucket_count() * sizeof(void*);
+    for (const auto& item : m_ids) {
+        bytes += sizeof(item) + 2 * sizeof(void*) + item.first.wireEncode().size();
+    }
+    return bytes;
+}
+
+}  // namespace fw
+}  // namespace nfd
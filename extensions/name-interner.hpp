@@ -0,0 +1,62 @@
+#ifndef NFD_DAEMON_FW_NAME_INTERNER_HPP
+#define NFD_DAEMON_FW_NAME_INTERNER_HPP
+
+#include "ns3/ndnSIM/ndn-cxx/name.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace nfd {
+namespace fw {
+
+/** \brief maps Names to dense 32-bit IDs, shared by all strategy instances
+ *
+ *  Strategy tables that are searched by Name (wait tables, CLT, PRFS
+ *  Interest table) store the ID instead, so a lookup compares integers
+ *  rather than Names component by component, and an entry holds 4 bytes
+ *  instead of a Name. Interning a Name costs one hash and one comparison;
+ *  the hash is kept with the entry and never recomputed.
+ *
+ *  IDs are assigned in order of first appearance and stay valid for the
+ *  whole run. The set of Names in a simulation is bounded by the catalog
+ *  under the simulation prefix, so entries are never removed.
+ */
+class NameInterner {
+  public:
+    using Id = uint32_t;
+
+    static constexpr Id INVALID_ID = ~Id(0);
+
+    static NameInterner& get();
+
+    /** \return ID of \p name, assigning the next free one on first use
+     */
+    Id intern(const Name& name);
+
+    /** \return ID of \p name, INVALID_ID if it has never been interned
+     */
+    Id find(const Name& name) const;
+
+    const Name& getName(Id id) const { return *m_names[id]; }
+
+    size_t getHash(Id id) const { return m_hashes[id]; }
+
+    size_t size() const { return m_names.size(); }
+
+    /** \return estimated memory held by the interner, for MemoryReport
+     */
+    size_t getBytes() const;
+
+  private:
+    std::unordered_map<Name, Id> m_ids;
+    // indexed by Id; the Names are the keys of m_ids, whose nodes never move
+    std::vector<const Name*> m_names;
+    std::vector<size_t> m_hashes;
+};
+
+}  // namespace fw
+}  // namespace nfd
+
+#endif  // NFD_DAEMON_FW_NAME_INTERNER_HPP
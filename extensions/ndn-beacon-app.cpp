@@ -0,0 +1,194 @@
+#include "ndn-beacon-app.hpp"
+
+#include "ns3/log.h"
+#include "ns3/mobility-model.h"
+#include "ns3/node.h"
+#include "ns3/packet.h"
+#include "ns3/simulator.h"
+
+#include <cstring>
+
+NS_LOG_COMPONENT_DEFINE("ndn.BeaconApp");
+
+namespace ns3 {
+namespace ndn {
+
+NS_OBJECT_ENSURE_REGISTERED(BeaconHeader);
+NS_OBJECT_ENSURE_REGISTERED(BeaconApp);
+
+namespace {
+
+void
+writeFloat(Buffer::Iterator& i, double value) {
+    float f = static_cast<float>(value);
+    uint32_t bits;
+    std::memcpy(&bits, &f, sizeof(bits));
+    i.WriteHtonU32(bits);
+}
+
+double
+readFloat(Buffer::Iterator& i) {
+    uint32_t bits = i.ReadNtohU32();
+    float f;
+    std::memcpy(&f, &bits, sizeof(f));
+    return f;
+}
+
+}  // namespace
+
+TypeId BeaconHeader::GetTypeId() {
+    static TypeId tid = TypeId("ns3::ndn::BeaconHeader").SetParent<Header>().AddConstructor<BeaconHeader>();
+    return tid;
+}
+
+BeaconHeader::BeaconHeader()
+    : m_nodeId(0) {
+}
+
+TypeId BeaconHeader::GetInstanceTypeId() const {
+    return GetTypeId();
+}
+
+uint32_t BeaconHeader::GetSerializedSize() const {
+    return 4 + 4 * 4;
+}
+
+void BeaconHeader::Serialize(Buffer::Iterator start) const {
+    Buffer::Iterator i = start;
+    i.WriteHtonU32(m_nodeId);
+    writeFloat(i, m_position.x);
+    writeFloat(i, m_position.y);
+    writeFloat(i, m_velocity.x);
+    writeFloat(i, m_velocity.y);
+}
+
+uint32_t BeaconHeader::Deserialize(Buffer::Iterator start) {
+    Buffer::Iterator i = start;
+    m_nodeId = i.ReadNtohU32();
+    m_position.x = readFloat(i);
+    m_position.y = readFloat(i);
+    m_position.z = 0;
+    m_velocity.x = readFloat(i);
+    m_velocity.y = readFloat(i);
+    m_velocity.z = 0;
+    return GetSerializedSize();
+}
+
+void BeaconHeader::Print(std::ostream& os) const {
+    os << "node=" << m_nodeId << " pos=" << m_position << " vel=" << m_velocity;
+}
+
+BeaconApp::Counters BeaconApp::s_counters;
+
+TypeId BeaconApp::GetTypeId() {
+    static TypeId tid =
+        TypeId("ns3::ndn::BeaconApp")
+            .SetParent<Application>()
+            .AddConstructor<BeaconApp>()
+            .AddAttribute("Interval", "Time between two beacons of a node",
+                          TimeValue(MilliSeconds(100)),
+                          MakeTimeAccessor(&BeaconApp::m_interval),
+                          MakeTimeChecker())
+            .AddAttribute("Jitter", "Upper bound of the uniform delay added to every beacon",
+                          TimeValue(MilliSeconds(10)),
+                          MakeTimeAccessor(&BeaconApp::m_jitter),
+                          MakeTimeChecker())
+            .AddAttribute("MaxAge", "Neighbors not heard for this long are dropped; 0 uses 3 intervals",
+                          TimeValue(Seconds(0)),
+                          MakeTimeAccessor(&BeaconApp::m_maxAge),
+                          MakeTimeChecker())
+            .AddAttribute("DataRate", "PHY rate used for the airtime estimate",
+                          DataRateValue(DataRate("6Mbps")),
+                          MakeDataRateAccessor(&BeaconApp::m_dataRate),
+                          MakeDataRateChecker())
+            .AddAttribute("PhyOverhead", "Preamble and PLCP header time added to every beacon",
+                          TimeValue(MicroSeconds(40)),
+                          MakeTimeAccessor(&BeaconApp::m_phyOverhead),
+                          MakeTimeChecker());
+    return tid;
+}
+
+BeaconApp::BeaconApp()
+    : m_random(CreateObject<UniformRandomVariable>()) {
+}
+
+void BeaconApp::DoDispose() {
+    Simulator::Cancel(m_sendEvent);
+    m_table = nullptr;
+    Application::DoDispose();
+}
+
+Time BeaconApp::GetBeaconAirtime() const {
+    uint32_t bytes = BeaconHeader().GetSerializedSize() + MAC_OVERHEAD;
+    return m_phyOverhead + m_dataRate.CalculateBytesTxTime(bytes);
+}
+
+void BeaconApp::StartApplication() {
+    Ptr<Node> node = GetNode();
+    m_table = node->GetObject<NeighborTable>();
+    if (m_table == nullptr) {
+        m_table = CreateObject<NeighborTable>();
+        node->AggregateObject(m_table);
+    }
+    m_table->SetMaxAge(m_maxAge.IsStrictlyPositive() ? m_maxAge : m_interval * 3);
+
+    for (uint32_t i = 0; i < node->GetNDevices(); i++) {
+        node->RegisterProtocolHandler(MakeCallback(&BeaconApp::Receive, this), PROTOCOL, node->GetDevice(i));
+    }
+    // spread the first beacons over one interval
+    m_sendEvent = Simulator::Schedule(Seconds(m_random->GetValue(0, m_interval.GetSeconds())), &BeaconApp::SendBeacon,
+                                      this);
+}
+
+void BeaconApp::StopApplication() {
+    Simulator::Cancel(m_sendEvent);
+    GetNode()->UnregisterProtocolHandler(MakeCallback(&BeaconApp::Receive, this));
+}
+
+void BeaconApp::ScheduleNext() {
+    Time delay = m_interval + Seconds(m_random->GetValue(0, m_jitter.GetSeconds()));
+    m_sendEvent = Simulator::Schedule(delay, &BeaconApp::SendBeacon, this);
+}
+
+void BeaconApp::SendBeacon() {
+    Ptr<Node> node = GetNode();
+    Ptr<MobilityModel> mobility = node->GetObject<MobilityModel>();
+    BeaconHeader header;
+    header.m_nodeId = node->GetId();
+    if (mobility != nullptr) {
+        header.m_position = mobility->GetPosition();
+        header.m_velocity = mobility->GetVelocity();
+    }
+
+    Time airtime = GetBeaconAirtime();
+    for (uint32_t i = 0; i < node->GetNDevices(); i++) {
+        Ptr<NetDevice> device = node->GetDevice(i);
+        if (!device->IsBroadcast()) {
+            continue;
+        }
+        Ptr<Packet> packet = Create<Packet>();
+        packet->AddHeader(header);
+        if (device->Send(packet, device->GetBroadcast(), PROTOCOL)) {
+            s_counters.sent++;
+            s_counters.bytes += header.GetSerializedSize() + MAC_OVERHEAD;
+            s_counters.airtime += airtime.GetSeconds();
+        }
+    }
+    m_table->Purge();
+    ScheduleNext();
+}
+
+void BeaconApp::Receive(Ptr<NetDevice> device, Ptr<const Packet> packet, uint16_t protocol, const Address& from,
+                        const Address& to, NetDevice::PacketType packetType) {
+    BeaconHeader header;
+    packet->PeekHeader(header);
+    if (header.m_nodeId == GetNode()->GetId()) {
+        return;
+    }
+    s_counters.received++;
+    m_table->Update({header.m_nodeId, header.m_position, header.m_velocity, Simulator::Now()});
+    NS_LOG_LOGIC("node " << GetNode()->GetId() << " heard " << header);
+}
+
+}  // namespace ndn
+}  // namespace ns3
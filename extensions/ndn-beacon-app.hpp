@@ -0,0 +1,116 @@
+#ifndef NDN_BEACON_APP_HPP
+#define NDN_BEACON_APP_HPP
+
+#include "ndn-neighbor-table.hpp"
+
+#include "ns3/application.h"
+#include "ns3/data-rate.h"
+#include "ns3/event-id.h"
+#include "ns3/header.h"
+#include "ns3/net-device.h"
+#include "ns3/random-variable-stream.h"
+
+#include <cstdint>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * \brief fixed-size hello carried by ndn::BeaconApp
+ *
+ * 20 bytes: node ID, 2D position and velocity as 32-bit floats. The z
+ * components are not sent.
+ */
+class BeaconHeader : public Header {
+  public:
+    static TypeId GetTypeId();
+
+    BeaconHeader();
+
+    virtual TypeId GetInstanceTypeId() const;
+    virtual uint32_t GetSerializedSize() const;
+    virtual void Serialize(Buffer::Iterator start) const;
+    virtual uint32_t Deserialize(Buffer::Iterator start);
+    virtual void Print(std::ostream& os) const;
+
+    uint32_t m_nodeId;
+    Vector m_position;
+    Vector m_velocity;
+};
+
+/**
+ * \brief broadcasts a BeaconHeader on every NetDevice of the node at a fixed
+ *        rate and fills the node's ndn::NeighborTable from the beacons it hears
+ *
+ * Beacons bypass NDN: they are sent with their own EtherType (PROTOCOL), so
+ * the NDN transports, which register for L3Protocol::ETHERNET_FRAME_TYPE,
+ * never see them. Each send is delayed by a uniform jitter to keep the
+ * nodes from beaconing in lockstep.
+ *
+ * The airtime of every beacon is estimated as PhyOverhead plus the frame,
+ * including MAC_OVERHEAD bytes of 802.11 header, LLC/SNAP and FCS, at
+ * DataRate. The totals over all nodes are available from GetCounters() and
+ * are written to the run report, so the beacon interval can be tuned
+ * against the channel time it costs.
+ */
+class BeaconApp : public Application {
+  public:
+    /// IEEE 802 local experimental EtherType 1
+    static const uint16_t PROTOCOL = 0x88B5;
+
+    /// 802.11 data header (24) + LLC/SNAP (8) + FCS (4)
+    static const uint32_t MAC_OVERHEAD = 36;
+
+    struct Counters {
+        uint64_t sent = 0;
+        uint64_t received = 0;
+        uint64_t bytes = 0;    ///< including MAC_OVERHEAD
+        double airtime = 0;    ///< seconds, summed over all senders
+    };
+
+    static TypeId GetTypeId();
+
+    BeaconApp();
+
+    /** \return counters summed over all BeaconApp instances
+     */
+    static const Counters& GetCounters() { return s_counters; }
+
+    static void ResetCounters() { s_counters = Counters(); }
+
+    /** \return estimated airtime of one beacon
+     */
+    Time GetBeaconAirtime() const;
+
+  protected:
+    virtual void DoDispose();
+
+  private:
+    virtual void StartApplication();
+    virtual void StopApplication();
+
+    void SendBeacon();
+
+    void ScheduleNext();
+
+    void Receive(Ptr<NetDevice> device, Ptr<const Packet> packet, uint16_t protocol, const Address& from,
+                 const Address& to, NetDevice::PacketType packetType);
+
+  private:
+    Time m_interval;
+    Time m_jitter;
+    Time m_maxAge;
+    DataRate m_dataRate;
+    Time m_phyOverhead;
+
+    Ptr<UniformRandomVariable> m_random;
+    Ptr<NeighborTable> m_table;
+    EventId m_sendEvent;
+
+    static Counters s_counters;
+};
+
+}  // namespace ndn
+}  // namespace ns3
+
+#endif  // NDN_BEACON_APP_HPP
@@ -0,0 +1,167 @@
+#include "ndn-fib-helper-m.hpp"
+
+#include "ns3/log.h"
+#include "ns3/ndnSIM/model/ndn-l3-protocol.hpp"
+#include "ns3/ndnSIM/NFD/daemon/fw/forwarder.hpp"
+
+#include <algorithm>
+#include <map>
+#include <utility>
+
+NS_LOG_COMPONENT_DEFINE("ndn.FibHelperM");
+
+namespace ns3 {
+namespace ndn {
+
+namespace {
+
+// one nexthop added by FibHelperM, with the references each owner holds on it
+struct OwnRoute {
+    uint64_t cost = 0;
+    std::map<const void*, uint32_t> refs;
+};
+
+// routes added by FibHelperM to one FIB entry
+struct OwnRoutes {
+    bool createdEntry = false;
+    std::map<::nfd::FaceId, OwnRoute> routes;
+};
+
+std::map<std::pair<uint32_t, Name>, OwnRoutes>&
+ownRoutes() {
+    static std::map<std::pair<uint32_t, Name>, OwnRoutes> routes;
+    return routes;
+}
+
+::nfd::Fib&
+getFib(Ptr<Node> node) {
+    Ptr<L3Protocol> l3 = L3Protocol::getL3Protocol(node);
+    NS_ASSERT_MSG(l3 != nullptr, "Cannot find NDN stack on node " << node->GetId());
+    return l3->getForwarder()->getFib();
+}
+
+// nexthop of the parent entry on face, nullptr if the parent has none
+const ::nfd::fib::NextHop*
+findParentNextHop(::nfd::Fib& fib, const Name& prefix, const Face& face) {
+    if (prefix.empty()) {
+        return nullptr;
+    }
+    const ::nfd::fib::Entry& parent = fib.findLongestPrefixMatch(prefix.getPrefix(-1));
+    auto it = std::find_if(parent.getNextHops().begin(), parent.getNextHops().end(),
+                           [&](const ::nfd::fib::NextHop& nexthop) { return &nexthop.getFace() == &face; });
+    return it == parent.getNextHops().end() ? nullptr : &*it;
+}
+
+}  // namespace
+
+void FibHelperM::AddRoute(Ptr<Node> node, const Name& prefix, shared_ptr<Face> face, int32_t metric,
+                          const void* owner) {
+    NS_ASSERT(face != nullptr);
+    NS_ASSERT(metric >= 0);
+
+    ::nfd::Fib& fib = getFib(node);
+    auto inserted = fib.insert(prefix);
+    ::nfd::fib::Entry* entry = inserted.first;
+    OwnRoutes& own = ownRoutes()[{node->GetId(), prefix}];
+    if (inserted.second) {
+        own.createdEntry = true;
+        if (!prefix.empty()) {
+            // CHILD_INHERIT: the new entry starts with the parent's nexthops
+            const ::nfd::fib::Entry& parent = fib.findLongestPrefixMatch(prefix.getPrefix(-1));
+            for (const auto& nexthop : parent.getNextHops()) {
+                fib.addOrUpdateNextHop(*entry, nexthop.getFace(), nexthop.getCost());
+            }
+        }
+    }
+    fib.addOrUpdateNextHop(*entry, *face, metric);
+    OwnRoute& route = own.routes[face->getId()];
+    route.cost = metric;
+    route.refs[owner]++;
+    NS_LOG_LOGIC("Node " << node->GetId() << ": added Face #" << face->getId() << " to FIB entry " << prefix);
+}
+
+bool FibHelperM::RemoveRoute(Ptr<Node> node, const Name& prefix, const Face& face, const void* owner) {
+    auto own = ownRoutes().find({node->GetId(), prefix});
+    if (own == ownRoutes().end()) {
+        return false;
+    }
+    auto route = own->second.routes.find(face.getId());
+    if (route == own->second.routes.end()) {
+        return false;
+    }
+    auto ref = route->second.refs.find(owner);
+    if (ref == route->second.refs.end()) {
+        return false;
+    }
+    if (--ref->second == 0) {
+        route->second.refs.erase(ref);
+    }
+    if (!route->second.refs.empty()) {
+        // another owner still routes through this nexthop
+        return true;
+    }
+    own->second.routes.erase(route);
+
+    ::nfd::Fib& fib = getFib(node);
+    ::nfd::fib::Entry* entry = fib.findExactMatch(prefix);
+    NS_ASSERT_MSG(entry != nullptr, "FIB entry " << prefix << " removed behind FibHelperM");
+    if (own->second.routes.empty() && own->second.createdEntry) {
+        fib.erase(*entry);
+        ownRoutes().erase(own);
+    }
+    else if (const ::nfd::fib::NextHop* inherited = findParentNextHop(fib, prefix, face)) {
+        fib.addOrUpdateNextHop(*entry, face, inherited->getCost());
+    }
+    else {
+        fib.removeNextHop(*entry, face);
+    }
+    NS_LOG_LOGIC("Node " << node->GetId() << ": removed Face #" << face.getId() << " from FIB entry " << prefix);
+    return true;
+}
+
+bool FibHelperM::IsInherited(Ptr<Node> node, const Name& prefix) {
+    ::nfd::Fib& fib = getFib(node);
+    const ::nfd::fib::Entry* entry = fib.findExactMatch(prefix);
+    auto own = ownRoutes().find({node->GetId(), prefix});
+    if (own == ownRoutes().end()) {
+        return true;
+    }
+    if (entry == nullptr) {
+        return false;
+    }
+
+    for (const auto& route : own->second.routes) {
+        auto nexthop = std::find_if(entry->getNextHops().begin(), entry->getNextHops().end(),
+                                    [&](const ::nfd::fib::NextHop& nh) { return nh.getFace().getId() == route.first; });
+        if (nexthop == entry->getNextHops().end() || nexthop->getCost() != route.second.cost) {
+            return false;
+        }
+    }
+    for (const auto& nexthop : entry->getNextHops()) {
+        if (own->second.routes.count(nexthop.getFace().getId()) != 0) {
+            continue;
+        }
+        const ::nfd::fib::NextHop* inherited = findParentNextHop(fib, prefix, nexthop.getFace());
+        if (inherited == nullptr) {
+            // only the RIB may have put other nexthops into an entry it created
+            if (own->second.createdEntry) {
+                return false;
+            }
+        }
+        else if (inherited->getCost() != nexthop.getCost()) {
+            return false;
+        }
+    }
+    if (!prefix.empty()) {
+        const ::nfd::fib::Entry& parent = fib.findLongestPrefixMatch(prefix.getPrefix(-1));
+        for (const auto& nexthop : parent.getNextHops()) {
+            if (!entry->hasNextHop(nexthop.getFace())) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+}  // namespace ndn
+}  // namespace ns3
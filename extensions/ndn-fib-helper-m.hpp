@@ -0,0 +1,71 @@
+#ifndef NDN_FIB_HELPER_M_HPP
+#define NDN_FIB_HELPER_M_HPP
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+#include "ns3/node.h"
+#include "ns3/ptr.h"
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-helpers
+ * @brief Helper class to manipulate NFD's FIB directly
+ *
+ * ndn::FibHelper goes through the FIB management module: every route is
+ * encoded into a ControlCommand, dispatched to the manager and validated.
+ * FibHelperM writes into nfd::Fib in place, so installing a route costs one
+ * FIB lookup and one nexthop update. Routes added here are not visible to
+ * management or to the RIB.
+ *
+ * To give the same FIB as ndn::FibHelper, which registers routes with
+ * CHILD_INHERIT, a FIB entry created here starts with the nexthops of its
+ * longest-prefix parent, and removing a route falls back to the parent's
+ * nexthop on that face. The parent is copied when the entry is created, so
+ * the parent routes (e.g. "/" from the face callbacks) must be registered
+ * before the first route is added here.
+ *
+ * Only routes that change during the run belong here (MUPF's path routes).
+ * The "/" routes of the face callbacks stay on ndn::FibHelper, one command
+ * per face: they are the parent that RIB-registered prefixes such as the
+ * producers' inherit from, so the RIB has to know them, and NFD has no
+ * command that registers several faces at once.
+ */
+class FibHelperM {
+  public:
+    /**
+     * @brief Add a nexthop on @p face to the FIB entry of @p prefix, creating the entry if needed
+     *
+     * Every call takes one reference for @p owner on the nexthop. If it is
+     * already there, only its cost is updated.
+     */
+    static void AddRoute(Ptr<Node> node, const Name& prefix, shared_ptr<Face> face, int32_t metric,
+                         const void* owner = nullptr);
+
+    /**
+     * @brief Release one reference of @p owner on the route on @p face to @p prefix
+     *
+     * The nexthop itself goes only when no owner references it anymore. It
+     * then falls back to the parent's cost if the parent entry also has it.
+     * The FIB entry is erased once its last route is removed, if it was
+     * created by AddRoute.
+     *
+     * @return false if @p owner held no reference on such a route
+     */
+    static bool RemoveRoute(Ptr<Node> node, const Name& prefix, const Face& face,
+                            const void* owner = nullptr);
+
+    /**
+     * @brief Check the FIB entry of @p prefix against what the RIB would have installed
+     *
+     * The routes added here must be nexthops with their own cost, and every
+     * other nexthop of the parent entry must be inherited with the parent's
+     * cost. For an entry created here nothing else may be present.
+     */
+    static bool IsInherited(Ptr<Node> node, const Name& prefix);
+};
+
+}  // namespace ndn
+}  // namespace ns3
+
+#endif  // NDN_FIB_HELPER_M_HPP
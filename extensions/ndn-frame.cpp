@@ -0,0 +1,115 @@
+#include "ndn-frame.hpp"
+
+#include "ndn-beacon-app.hpp"
+
+#include "ns3/llc-snap-header.h"
+#include "ns3/packet.h"
+#include "ns3/wifi-mac-header.h"
+#include "ns3/ndnSIM/model/ndn-l3-protocol.hpp"
+#include "ns3/ndnSIM/ndn-cxx/encoding/tlv.hpp"
+#include "ns3/ndnSIM/ndn-cxx/lp/tlv.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace ns3 {
+
+namespace {
+
+/** \brief NDNLPv2 headers, the Name and the Interest fields up to the nonce
+ *         fit well within this
+ */
+const uint32_t PEEK_BYTES = 512;
+
+bool
+readTlv(const uint8_t*& begin, const uint8_t* end, uint64_t& type, uint64_t& length) {
+    return ::ndn::tlv::readVarNumber(begin, end, type) && ::ndn::tlv::readVarNumber(begin, end, length) &&
+           length <= uint64_t(end - begin);
+}
+
+}  // namespace
+
+NdnFrame NdnFrame::FromWifi(Ptr<const Packet> frame) {
+    NdnFrame result;
+    Ptr<Packet> copy = frame->Copy();
+    WifiMacHeader mac;
+    copy->RemoveHeader(mac);
+    if (!mac.IsData()) {
+        return result;
+    }
+    LlcSnapHeader llc;
+    copy->RemoveHeader(llc);
+    if (llc.GetType() == ndn::BeaconApp::PROTOCOL) {
+        result.kind = BEACON;
+        return result;
+    }
+    if (llc.GetType() != ndn::L3Protocol::ETHERNET_FRAME_TYPE) {
+        return result;
+    }
+    uint8_t buffer[PEEK_BYTES];
+    uint32_t size = copy->CopyData(buffer, std::min(copy->GetSize(), PEEK_BYTES));
+    return FromNdn(buffer, buffer + size);
+}
+
+NdnFrame NdnFrame::FromNdn(const uint8_t* begin, const uint8_t* end) {
+    NdnFrame result;
+    uint64_t type, length;
+    if (!::ndn::tlv::readVarNumber(begin, end, type) || !::ndn::tlv::readVarNumber(begin, end, length)) {
+        return result;
+    }
+    if (type == ::ndn::lp::tlv::LpPacket) {
+        // walk the LpPacket header fields up to the fragment
+        while (begin < end) {
+            if (!readTlv(begin, end, type, length)) {
+                return result;
+            }
+            if (type == ::ndn::lp::tlv::Fragment) {
+                return FromNdn(begin, begin + length);
+            }
+            // later fragments of a packet do not start with its TLV type
+            if (type == ::ndn::lp::tlv::FragIndex &&
+                std::any_of(begin, begin + length, [](uint8_t b) { return b != 0; })) {
+                return result;
+            }
+            begin += length;
+        }
+        return result;
+    }
+    if (type != ::ndn::tlv::Interest && type != ::ndn::tlv::Data) {
+        return result;
+    }
+    Kind kind = type == ::ndn::tlv::Interest ? INTEREST : DATA;
+    // the Name is the first element of both
+    const uint8_t* name = begin;
+    if (!readTlv(begin, end, type, length) || type != ::ndn::tlv::Name) {
+        return result;
+    }
+    begin += length;
+    result.nameHash = HashName(name, begin - name);
+    if (kind == DATA) {
+        result.kind = DATA;
+        return result;
+    }
+    while (begin < end) {
+        if (!readTlv(begin, end, type, length)) {
+            return result;
+        }
+        if (type == ::ndn::tlv::Nonce && length == sizeof(result.nonce)) {
+            std::memcpy(&result.nonce, begin, sizeof(result.nonce));
+            result.kind = INTEREST;
+            return result;
+        }
+        begin += length;
+    }
+    return result;
+}
+
+uint64_t NdnFrame::HashName(const uint8_t* wire, size_t size) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < size; i++) {
+        hash = (hash ^ wire[i]) * 1099511628211ULL;
+    }
+    return hash;
+}
+
+}  // namespace ns3
@@ -0,0 +1,45 @@
+#ifndef NDN_FRAME_HPP
+#define NDN_FRAME_HPP
+
+#include "ns3/ptr.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ns3 {
+
+class Packet;
+
+/**
+ * \brief type, name hash and nonce of the NDN packet in a frame, read from
+ *        its first bytes without decoding the whole packet
+ *
+ * Used by the tracers that sit below NFD and only see ns-3 packets. The
+ * NDNLPv2 header fields are skipped up to the fragment; a fragment other
+ * than the first of a packet does not start with the packet's TLV type and
+ * is reported as OTHER.
+ */
+struct NdnFrame {
+    enum Kind { OTHER, INTEREST, DATA, BEACON };
+
+    Kind kind = OTHER;
+    uint64_t nameHash = 0;  ///< HashName of the Name TLV, 0 unless INTEREST or DATA
+    uint32_t nonce = 0;     ///< as returned by Interest::getNonce(), 0 unless INTEREST
+
+    /** \brief parses \p frame as passed to the WifiPhy: 802.11 MAC header,
+     *         LLC/SNAP, then a beacon or an NDN packet
+     */
+    static NdnFrame FromWifi(Ptr<const Packet> frame);
+
+    /** \brief parses an NDNLPv2 packet or a bare Interest or Data
+     */
+    static NdnFrame FromNdn(const uint8_t* begin, const uint8_t* end);
+
+    /** \brief FNV-1a over a wire-encoded Name TLV, including type and length
+     */
+    static uint64_t HashName(const uint8_t* wire, size_t size);
+};
+
+}  // namespace ns3
+
+#endif  // NDN_FRAME_HPP
@@ -0,0 +1,63 @@
+#include "ndn-geo-tag-helper.hpp"
+
+#include "ns3/mobility-model.h"
+#include "ns3/object.h"
+
+namespace ns3 {
+namespace ndn {
+
+namespace {
+
+// per-node switch, aggregated to the node so that it goes away with it
+class GeoTagSwitch : public Object {
+  public:
+    static TypeId GetTypeId() {
+        static TypeId tid = TypeId("ns3::ndn::GeoTagSwitch").SetParent<Object>().SetGroupName("Ndn");
+        return tid;
+    }
+
+    bool enabled = false;
+};
+
+GeoTagSwitch* getSwitch(Ptr<Node> node) {
+    Ptr<GeoTagSwitch> geoTagSwitch = node->GetObject<GeoTagSwitch>();
+    if (geoTagSwitch == nullptr) {
+        geoTagSwitch = CreateObject<GeoTagSwitch>();
+        node->AggregateObject(geoTagSwitch);
+    }
+    return PeekPointer(geoTagSwitch);
+}
+
+}  // namespace
+
+GeoTagHelper::Provider GeoTagHelper::CreateProvider(Ptr<Node> node) {
+    // the link service is owned by the node, so raw pointers do not create a reference cycle
+    Node* owner = PeekPointer(node);
+    const GeoTagSwitch* geoTagSwitch = getSwitch(node);
+    MobilityModel* mobility = nullptr;
+    return [owner, geoTagSwitch, mobility]() mutable -> shared_ptr<::ndn::lp::GeoTag> {
+        if (!geoTagSwitch->enabled) {
+            return nullptr;
+        }
+        if (mobility == nullptr) {
+            mobility = PeekPointer(owner->GetObject<MobilityModel>());
+            if (mobility == nullptr) {
+                return nullptr;
+            }
+        }
+        Vector position = mobility->GetPosition();
+        return make_shared<::ndn::lp::GeoTag>(std::make_tuple(position.x, position.y, position.z));
+    };
+}
+
+void GeoTagHelper::SetEnabled(Ptr<Node> node, bool enabled) {
+    getSwitch(node)->enabled = enabled;
+}
+
+bool GeoTagHelper::IsEnabled(Ptr<Node> node) {
+    Ptr<GeoTagSwitch> geoTagSwitch = node->GetObject<GeoTagSwitch>();
+    return geoTagSwitch != nullptr && geoTagSwitch->enabled;
+}
+
+}  // namespace ndn
+}  // namespace ns3
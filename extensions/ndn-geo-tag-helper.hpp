@@ -0,0 +1,61 @@
+#ifndef NDN_GEO_TAG_HELPER_HPP
+#define NDN_GEO_TAG_HELPER_HPP
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+#include "ns3/ndnSIM/ndn-cxx/lp/geo-tag.hpp"
+#include "ns3/node.h"
+#include "ns3/ptr.h"
+
+#include <functional>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-helpers
+ * @brief Helper class to stamp outgoing packets with the sender's position
+ *
+ * The provider is installed as GenericLinkServiceM::Options::enableGeoTags by
+ * WifiApStaDeviceBroadcastCallback. Every Interest and Data sent on such a face then
+ * carries lp::GeoTagField with the current position of the sending node, and
+ * the receiving link service attaches it to the packet as lp::GeoTag.
+ *
+ * GeoTag has room for a position only; receivers estimate velocity from
+ * successive tags with nfd::fw::GeoTagTracker. Strategies that need the
+ * exact sender velocity (LISIC, LSIF) still read it from the sender's
+ * MobilityModel, so they do not run without the global node view.
+ *
+ * A tag makes every frame bigger, which changes airtime and collisions, so
+ * the providers of a node send nothing until SetEnabled(node, true).
+ * Constructing a GeoTagTracker does that for the node of its forwarder,
+ * i.e. a node sends tags only while it runs a strategy that reads them
+ * (DASB, LISIC and VNDN). The switch is per node and aggregated to it, so
+ * nodes running different strategies do not affect each other. The
+ * providers are installed at face creation anyway, because the strategy is
+ * chosen later (in zygote runs, only after the fork).
+ */
+class GeoTagHelper {
+  public:
+    using Provider = std::function<shared_ptr<::ndn::lp::GeoTag>()>;
+
+    /**
+     * @brief Create a provider that reads the MobilityModel of @p node on every call
+     *
+     * The MobilityModel is looked up on first use, so the provider may be
+     * created before mobility is installed. It returns nullptr while the node
+     * has none, and no GeoTag is sent.
+     */
+    static Provider CreateProvider(Ptr<Node> node);
+
+    /**
+     * @brief Turn sending of GeoTags on or off for the providers of @p node
+     */
+    static void SetEnabled(Ptr<Node> node, bool enabled);
+
+    static bool IsEnabled(Ptr<Node> node);
+};
+
+}  // namespace ndn
+}  // namespace ns3
+
+#endif  // NDN_GEO_TAG_HELPER_HPP
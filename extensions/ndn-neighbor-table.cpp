@@ -0,0 +1,85 @@
+#include "ndn-neighbor-table.hpp"
+
+#include "vanet-kernels.hpp"
+
+#include "ns3/log.h"
+#include "ns3/mobility-model.h"
+
+NS_LOG_COMPONENT_DEFINE("ndn.NeighborTable");
+
+namespace ns3 {
+namespace ndn {
+
+NS_OBJECT_ENSURE_REGISTERED(NeighborTable);
+
+TypeId NeighborTable::GetTypeId() {
+    static TypeId tid =
+        TypeId("ns3::ndn::NeighborTable")
+            .SetParent<Object>()
+            .AddConstructor<NeighborTable>()
+            .AddAttribute("MaxAge",
+                          "Entries not refreshed by a beacon for this long are dropped",
+                          TimeValue(MilliSeconds(300)),
+                          MakeTimeAccessor(&NeighborTable::m_maxAge),
+                          MakeTimeChecker());
+    return tid;
+}
+
+NeighborTable::NeighborTable()
+    : m_maxAge(MilliSeconds(300)) {
+}
+
+Vector NeighborTable::Entry::GetPosition(Time now) const {
+    double dt = (now - lastHeard).GetSeconds();
+    return Vector(position.x + velocity.x * dt, position.y + velocity.y * dt, position.z + velocity.z * dt);
+}
+
+void NeighborTable::Update(const Entry& entry) {
+    m_entries[entry.nodeId] = entry;
+}
+
+const NeighborTable::Entry* NeighborTable::Find(uint32_t nodeId) const {
+    auto it = m_entries.find(nodeId);
+    if (it == m_entries.end() || IsExpired(it->second, Simulator::Now())) {
+        return nullptr;
+    }
+    return &it->second;
+}
+
+void NeighborTable::GetLinks(const Ptr<Node>& node, double range, std::vector<Link>& links) const {
+    MobilityModel* mobility = NodeRegistry::Get().GetMobility(node->GetId());
+    Vector position = mobility->GetPosition();
+    Vector velocity = mobility->GetVelocity();
+    links.clear();
+    ForEach([&](const Entry& entry) {
+        Vector neighborPos = entry.GetPosition(Simulator::Now());
+        double let = CalculateDistance(position, neighborPos) > range
+                         ? 0
+                         : ::nfd::fw::vanet::linkExpirationTime(position, velocity, neighborPos, entry.velocity, range);
+        links.push_back({entry.nodeId, neighborPos, entry.velocity, let,
+                         ::nfd::fw::vanet::linkAvailabilityProbability(let, LAP_INTERVAL)});
+    });
+}
+
+size_t NeighborTable::Purge() {
+    Time now = Simulator::Now();
+    size_t nErased = 0;
+    for (auto it = m_entries.begin(); it != m_entries.end();) {
+        if (IsExpired(it->second, now)) {
+            it = m_entries.erase(it);
+            nErased++;
+        } else {
+            ++it;
+        }
+    }
+    NS_LOG_LOGIC("purged " << nErased << " neighbors, " << m_entries.size() << " left");
+    return nErased;
+}
+
+size_t NeighborTable::GetBytes() const {
+    return m_entries.size() * (sizeof(std::pair<const uint32_t, Entry>) + 2 * sizeof(void*)) +
+           m_entries.bucket_count() * sizeof(void*);
+}
+
+}  // namespace ndn
+}  // namespace ns3
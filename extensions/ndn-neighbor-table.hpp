@@ -0,0 +1,164 @@
+#ifndef NDN_NEIGHBOR_TABLE_HPP
+#define NDN_NEIGHBOR_TABLE_HPP
+
+#include "node-registry.hpp"
+
+#include "ns3/node.h"
+#include "ns3/nstime.h"
+#include "ns3/object.h"
+#include "ns3/simulator.h"
+#include "ns3/vector.h"
+
+#include <cstdint>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * \brief one-hop neighbors of a node, learned from the beacons of ndn::BeaconApp
+ *
+ * Aggregated to the node by the BeaconApp installed on it. Entries are keyed
+ * by node ID and hold the position and velocity the neighbor announced and
+ * the time the beacon was heard. An entry older than MaxAge is ignored by
+ * Find, ForEach and GetLinks and removed by the next Purge, so a strategy
+ * that walks the table touches its current neighbors only.
+ *
+ * GetLinks and SelectRelays are the neighbor-table steps shared by OPT, CCAF
+ * and MUPF.
+ */
+class NeighborTable : public Object {
+  public:
+    struct Entry {
+        uint32_t nodeId;
+        Vector position;  ///< as announced, at lastHeard
+        Vector velocity;
+        Time lastHeard;
+
+        /** \return announced position moved along the announced velocity to \p now
+         */
+        Vector GetPosition(Time now) const;
+    };
+
+    /** \brief a current neighbor as seen from the local node
+     */
+    struct Link {
+        uint32_t nodeId;
+        Vector position;  ///< extrapolated to now
+        Vector velocity;
+        double let;       ///< link expiration time, 0 if out of range now
+        double lap;       ///< link availability probability over LAP_INTERVAL
+    };
+
+    /// prediction interval of Link::lap, in seconds
+    static constexpr double LAP_INTERVAL = 2.0;
+
+    static TypeId GetTypeId();
+
+    NeighborTable();
+
+    /** \brief insert or refresh the entry of entry.nodeId
+     */
+    void Update(const Entry& entry);
+
+    /** \return entry of \p nodeId, nullptr if unknown or older than MaxAge
+     */
+    const Entry* Find(uint32_t nodeId) const;
+
+    /** \brief call \p f on every entry not older than MaxAge
+     */
+    template<typename F>
+    void ForEach(F&& f) const;
+
+    /** \brief remove the entries older than MaxAge
+     *  \return number of removed entries
+     */
+    size_t Purge();
+
+    /** \return number of stored entries, including aged ones not yet purged
+     */
+    size_t GetN() const { return m_entries.size(); }
+
+    Time GetMaxAge() const { return m_maxAge; }
+
+    void SetMaxAge(Time maxAge) { m_maxAge = maxAge; }
+
+    /** \brief replace \p links with the current neighbors as seen from \p node
+     *  \param range communication range for the LET
+     */
+    void GetLinks(const Ptr<Node>& node, double range, std::vector<Link>& links) const;
+
+    /** \brief next hops toward the content sources: greedy geographic
+     *         forwarding of OPT and CCAF over \p links
+     *
+     *  A source within \p range of \p node is reached directly, and only if it
+     *  is in \p links. For a farther source, every neighbor within range that is
+     *  not farther from the source than \p node is a candidate. The sources
+     *  reached directly take precedence over the candidates.
+     *
+     *  \param faceOf called as faceOf(nodeId), the face toward a neighbor or
+     *         nullptr, which skips that neighbor
+     */
+    template<typename FaceOf>
+    static auto SelectRelays(const std::vector<Link>& links, const Ptr<Node>& node,
+                             const std::set<Ptr<Node>>& sources, double range, FaceOf&& faceOf)
+        -> std::set<decltype(faceOf(uint32_t()))>;
+
+    /** \return estimated memory held by the entries, for MemoryReport
+     */
+    size_t GetBytes() const;
+
+  private:
+    bool IsExpired(const Entry& entry, Time now) const { return now - entry.lastHeard > m_maxAge; }
+
+  private:
+    std::unordered_map<uint32_t, Entry> m_entries;
+    Time m_maxAge;
+};
+
+template<typename F>
+void NeighborTable::ForEach(F&& f) const {
+    Time now = Simulator::Now();
+    for (const auto& item : m_entries) {
+        if (!IsExpired(item.second, now)) {
+            f(item.second);
+        }
+    }
+}
+
+template<typename FaceOf>
+auto NeighborTable::SelectRelays(const std::vector<Link>& links, const Ptr<Node>& node,
+                                 const std::set<Ptr<Node>>& sources, double range, FaceOf&& faceOf)
+    -> std::set<decltype(faceOf(uint32_t()))> {
+    const NodeRegistry& nodes = NodeRegistry::Get();
+    std::set<decltype(faceOf(uint32_t()))> inRegionSrcs;
+    std::set<decltype(faceOf(uint32_t()))> candidateForwarders;
+    Vector curPos = nodes.GetMobility(node->GetId())->GetPosition();
+    for (const auto& srcNode : sources) {
+        Vector srcPos = nodes.GetMobility(srcNode->GetId())->GetPosition();
+        double d_sd = CalculateDistance(curPos, srcPos);
+        for (const Link& neighbor : links) {
+            auto face = faceOf(neighbor.nodeId);
+            if (face == nullptr) {
+                continue;
+            }
+            if (d_sd < range) {
+                if (neighbor.nodeId == srcNode->GetId()) {
+                    inRegionSrcs.emplace(face);
+                }
+            }
+            else if (CalculateDistance(curPos, neighbor.position) < range &&
+                     CalculateDistance(neighbor.position, srcPos) <= d_sd) {
+                candidateForwarders.emplace(face);
+            }
+        }
+    }
+    return inRegionSrcs.size() > 0 ? inRegionSrcs : candidateForwarders;
+}
+
+}  // namespace ndn
+}  // namespace ns3
+
+#endif  // NDN_NEIGHBOR_TABLE_HPP
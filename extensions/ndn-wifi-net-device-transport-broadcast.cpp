@@ -20,6 +20,7 @@
  **/
 
 #include "ndn-wifi-net-device-transport-broadcast.hpp"
+#include "vanet-probes.hpp"
 
 #include <ns3/ndnSIM/ndn-cxx/data.hpp>
 #include <ns3/ndnSIM/ndn-cxx/encoding/block.hpp>
@@ -38,7 +39,7 @@ namespace ns3 {
 namespace ndn {
 
 WifiNetDeviceTransportBroadcast::WifiNetDeviceTransportBroadcast(
-    Ptr<Node> node, const Ptr<WifiNetDevice>& netDevice,
+    Ptr<Node> node, const Ptr<NetDevice>& netDevice,
     const std::string& localUri, const std::string& remoteUri,
     ::ndn::nfd::FaceScope scope, ::ndn::nfd::FacePersistency persistency,
     ::ndn::nfd::LinkType linkType)
@@ -124,6 +125,7 @@ void WifiNetDeviceTransportBroadcast::doSend(const Block& packet,
     // m_netDevice->GetMac();
 
     // send the NS3 packet
+    VANET_PROBE2(transport_send, m_node->GetId(), ns3Packet->GetSize());
     m_netDevice->Send(ns3Packet, remote_addr,  // m_netDevice->GetBroadcast(),
                       L3Protocol::ETHERNET_FRAME_TYPE);
 }
@@ -132,6 +134,7 @@ void WifiNetDeviceTransportBroadcast::doSend(const Block& packet,
 void WifiNetDeviceTransportBroadcast::receiveFromNetDevice(
     Ptr<NetDevice> device, Ptr<const ns3::Packet> p, uint16_t protocol,
     const Address& from, const Address& to, NetDevice::PacketType packetType) {
+    VANET_PROBE2(transport_receive, m_node->GetId(), p->GetSize());
 
     // Convert NS3 packet to NFD packet
     Ptr<ns3::Packet> packet = p->Copy();
@@ -23,7 +23,7 @@
 #include "ns3/ndnSIM/model/ndn-common.hpp"
 #include "ns3/ndnSIM/NFD/daemon/face/transport.hpp"
 
-#include "ns3/wifi-net-device.h"
+#include "ns3/net-device.h"
 #include "ns3/log.h"
 #include "ns3/packet.h"
 #include "ns3/node.h"
@@ -42,7 +42,7 @@ namespace ndn {
 class WifiNetDeviceTransport : public nfd::face::Transport
 {
 public:
-  WifiNetDeviceTransport(Ptr<Node> node, const Ptr<WifiNetDevice>& netDevice,
+  WifiNetDeviceTransport(Ptr<Node> node, const Ptr<NetDevice>& netDevice,
                      const std::string& localUri,
                      const std::string& remoteUri,
                      ::ndn::nfd::FaceScope scope = ::ndn::nfd::FACE_SCOPE_NON_LOCAL,
@@ -74,7 +74,7 @@ private:
                        const Address& from, const Address& to,
                        NetDevice::PacketType packetType);
 
-  Ptr<WifiNetDevice> m_netDevice; ///< \brief Smart pointer to NetDevice
+  Ptr<NetDevice> m_netDevice; ///< \brief Smart pointer to NetDevice
   Ptr<Node> m_node;
   ns3::Mac48Address local_addr;
   ns3::Mac48Address remote_addr;
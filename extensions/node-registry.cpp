@@ -0,0 +1,63 @@
+#include "node-registry.hpp"
+
+#include "ns3/node-list.h"
+#include "ns3/simulator.h"
+#include "ns3/ndnSIM/model/ndn-l3-protocol.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+NodeRegistry& NodeRegistry::GetInstance() {
+    static NodeRegistry registry;
+    return registry;
+}
+
+const NodeRegistry& NodeRegistry::Get() {
+    NodeRegistry& registry = GetInstance();
+    if (registry.m_nodes.size() != NodeList::GetNNodes()) {
+        registry.Update();
+    }
+    return registry;
+}
+
+void NodeRegistry::Update() {
+    for (uint32_t id = m_nodes.size(); id < NodeList::GetNNodes(); id++) {
+        m_nodes.push_back(NodeList::GetNode(id));
+    }
+    m_mobility.resize(m_nodes.size(), nullptr);
+    m_l3.resize(m_nodes.size(), nullptr);
+
+    if (!m_isDestroyScheduled) {
+        Simulator::ScheduleDestroy(&NodeRegistry::Clear, this);
+        m_isDestroyScheduled = true;
+    }
+}
+
+void NodeRegistry::Clear() {
+    m_nodes.clear();
+    m_mobility.clear();
+    m_l3.clear();
+    m_isDestroyScheduled = false;
+}
+
+MobilityModel* NodeRegistry::GetMobility(uint32_t id) const {
+    if (m_mobility[id] == nullptr) {
+        m_mobility[id] = PeekPointer(m_nodes[id]->GetObject<MobilityModel>());
+    }
+    return m_mobility[id];
+}
+
+L3Protocol* NodeRegistry::GetL3(uint32_t id) const {
+    if (m_l3[id] == nullptr) {
+        m_l3[id] = PeekPointer(m_nodes[id]->GetObject<L3Protocol>());
+    }
+    return m_l3[id];
+}
+
+size_t NodeRegistry::GetBytes() const {
+    return m_nodes.capacity() * sizeof(Ptr<Node>) + m_mobility.capacity() * sizeof(MobilityModel*) +
+           m_l3.capacity() * sizeof(L3Protocol*);
+}
+
+}  // namespace ndn
+}  // namespace ns3
@@ -0,0 +1,84 @@
+#ifndef NODE_REGISTRY_HPP
+#define NODE_REGISTRY_HPP
+
+#include "ns3/mobility-model.h"
+#include "ns3/node.h"
+#include "ns3/ptr.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+class L3Protocol;
+
+/**
+ * \brief process-wide, read-only view of all nodes of the simulation
+ *
+ * Strategies used to copy NodeContainer::GetGlobal() in their constructor,
+ * i.e. N reference-counted pointers per node. The registry holds the node
+ * handles once, indexed by node ID, together with the MobilityModel and
+ * L3Protocol of every node, looked up on first use. Strategies keep a
+ * reference obtained from Get(); iterating it does not touch refcounts.
+ *
+ * The registry picks up nodes created after it was first used, and drops
+ * its handles in a Simulator::ScheduleDestroy event. Destroy events run in
+ * the order they were scheduled, and NodeList schedules its own when the
+ * first node is created, i.e. before the registry can be used. So
+ * Simulator::Destroy first disposes of all nodes (and their MobilityModel
+ * and L3Protocol), and only then does the registry release its last
+ * references to the disposed nodes. Nothing may look nodes up through the
+ * registry from within Simulator::Destroy.
+ */
+class NodeRegistry {
+  public:
+    using Iterator = std::vector<Ptr<Node>>::const_iterator;
+
+    /** \brief the registry, synchronised with NodeList
+     */
+    static const NodeRegistry& Get();
+
+    uint32_t GetN() const { return m_nodes.size(); }
+
+    const Ptr<Node>& Get(uint32_t id) const { return m_nodes[id]; }
+
+    const Ptr<Node>& operator[](uint32_t id) const { return m_nodes[id]; }
+
+    Iterator begin() const { return m_nodes.begin(); }
+
+    Iterator end() const { return m_nodes.end(); }
+
+    /** \return MobilityModel aggregated to node \p id, nullptr if none
+     */
+    MobilityModel* GetMobility(uint32_t id) const;
+
+    /** \return L3Protocol aggregated to node \p id, nullptr if the stack is not installed yet
+     */
+    L3Protocol* GetL3(uint32_t id) const;
+
+    /** \return estimated memory held by the registry, for MemoryReport
+     */
+    size_t GetBytes() const;
+
+  private:
+    NodeRegistry() = default;
+
+    static NodeRegistry& GetInstance();
+
+    void Update();
+
+    void Clear();
+
+  private:
+    std::vector<Ptr<Node>> m_nodes;
+    // raw pointers, the objects are owned by the nodes above
+    mutable std::vector<MobilityModel*> m_mobility;
+    mutable std::vector<L3Protocol*> m_l3;
+    bool m_isDestroyScheduled = false;
+};
+
+}  // namespace ndn
+}  // namespace ns3
+
+#endif  // NODE_REGISTRY_HPP
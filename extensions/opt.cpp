@@ -12,6 +12,7 @@
 #include "ns3/node.h"
 #include "ns3/node-container.h"
 #include "ns3/ptr.h"
+#include "strategy-profiler.hpp"
 #include <cmath>
 #include <chrono>
 
@@ -28,7 +29,7 @@ const time::milliseconds OPT::RETX_SUPPRESSION_MAX(250);
 
 OPT::OPT(Forwarder& forwarder, const Name& name)
     : Strategy(forwarder),
-    m_nodes(ns3::NodeContainer::GetGlobal()),
+    m_nodes(ns3::ndn::NodeRegistry::Get()),
     m_measurements(getMeasurements()),
     m_retxSuppression(RETX_SUPPRESSION_INITIAL,
                         RetxSuppressionExponential::DEFAULT_MULTIPLIER,
@@ -54,14 +55,13 @@ void OPT::afterReceiveInterest(const FaceEndpoint& ingress,
                                const Interest& interest,
                                const shared_ptr<pit::Entry>& pitEntry)
 {
+    STRATEGY_PROFILE("OPT");
     const fib::Entry& fibEntry = this->lookupFib(*pitEntry);
     const Name prefix = fibEntry.getPrefix();
-    const fib::NextHopList& nexthops = fibEntry.getNextHops();
     ns3::Ptr<ns3::Node> localNode = getNode(*this);
     std::set<ns3::Ptr<ns3::Node>> sources = this->getContentSources(interest);
-    std::set<Face*> candidates = this->getCandidateForwarders(nexthops, localNode, sources);
 
-    auto it = this->selectFIB(localNode, interest, candidates, fibEntry);
+    auto it = this->selectEgress(localNode, interest, sources, fibEntry);
     if (it == nullptr) {
         // NFD_LOG_DEBUG("No Next Hop!");
         return;
@@ -80,6 +80,7 @@ void OPT::afterReceiveInterest(const FaceEndpoint& ingress,
 void
 OPT::beforeSatisfyInterest(const shared_ptr<pit::Entry>& pitEntry,
                         const FaceEndpoint& ingress, const Data& data) {
+    STRATEGY_PROFILE("OPT");
 
     // NFD_LOG_DEBUG("beforeSatisfyInterest pitEntry=" << pitEntry->getName()
     //             << " in=" << ingress << " data=" << data.getName());
@@ -117,6 +118,7 @@ void
 OPT::afterContentStoreHit(const shared_ptr<pit::Entry>& pitEntry,
                                const FaceEndpoint& ingress, const Data& data)
 {
+    STRATEGY_PROFILE("OPT");
     // NFD_LOG_DEBUG("afterContentStoreHit pitEntry=" << pitEntry->getName()
     //             << " in=" << ingress << " data=" << data.getName());
 
@@ -128,6 +130,7 @@ void
 OPT::afterReceiveData(const shared_ptr<pit::Entry>& pitEntry,
                            const FaceEndpoint& ingress, const Data& data)
 {
+  	STRATEGY_PROFILE("OPT");
   	this->beforeSatisfyInterest(pitEntry, ingress, data);
     // NFD_LOG_DEBUG("afterReceiveData pitEntry=" << pitEntry->getName()
     //             << " in=" << ingress << " data=" << data.getName());
@@ -160,7 +163,7 @@ OPT::getContentSources(const Interest &interest)
         if (isProducer(node)) {
             sources.emplace(node);
         }
-        ns3::Ptr<ns3::ndn::L3Protocol> ndn = node->GetObject<ns3::ndn::L3Protocol>();
+        ns3::ndn::L3Protocol* ndn = m_nodes.GetL3(node->GetId());
         ndn::Name name = interest.getName();
         nfd::cs::Cs &cs = ndn->getForwarder()->getCs();
         for (const auto& entry : cs) {
@@ -188,9 +191,36 @@ OPT::getContentSources(const Interest &interest)
     return sources;
 }
 
+Face*
+OPT::selectEgress(ns3::Ptr<ns3::Node> localNode, const Interest &interest, const std::set<ns3::Ptr<ns3::Node>> &sources, const fib::Entry &fibEntry)
+{
+    // 相同前缀和内容源集合的决策在一个移动周期内复用, 候选的SISR/SRTT变化超过阈值时重新计算
+    // 每个Interest只查找一次测量表, 不创建表项也不延长寿命, 结果也传给selectFIB
+    const NamespaceInfo *namespaceInfo = m_measurements.findNamespaceInfo(fibEntry, interest);
+    auto now = time::steady_clock::now();
+    return m_decisionCache.select(fibEntry.getPrefix(), sources, now,
+        [&] (FaceId faceId, double &sisr, double &srtt) { isr::IsrMeasurements::measureFace(namespaceInfo, faceId, now, sisr, srtt); },
+        [&] (std::vector<DecisionCache::Candidate> *snapshot) {
+            std::set<Face*> candidates = this->getCandidateForwarders(fibEntry.getNextHops(), localNode, sources);
+            return this->selectFIB(localNode, candidates, namespaceInfo, snapshot);
+        },
+        [this] (FaceId faceId) { return this->getFace(faceId); });
+}
+
 std::set<Face*>
 OPT::getCandidateForwarders(const fib::NextHopList &nexthops, ns3::Ptr<ns3::Node> curNode, std::set<ns3::Ptr<ns3::Node>> srcNodes)
 {
+    // 安装了信标时只遍历邻居, 不再遍历FIB中的所有Face
+    if (!srcNodes.empty() && this->updateNeighborTable(curNode)) {
+        // Directly return App Face if it is Producer;
+        for (auto &nexthop : nexthops) {
+            if (nexthop.getFace().getId() == 256+m_nodes.GetN()) {
+                return std::set<Face *>{&nexthop.getFace()};
+            }
+        }
+        return ns3::ndn::NeighborTable::SelectRelays(m_NT, curNode, srcNodes, Rth,
+            [&] (uint32_t nodeId) { return this->getFace(256 + nodeId + (nodeId < curNode->GetId())); });
+    }
     std::set<Face*> inRegionSrcs;
     std::set<Face*> candidateForwarders;
     for (auto &srcNode : srcNodes)
@@ -226,10 +256,25 @@ OPT::getCandidateForwarders(const fib::NextHopList &nexthops, ns3::Ptr<ns3::Node
     return inRegionSrcs.size()>0? inRegionSrcs : candidateForwarders;
 }
 
+bool
+OPT::updateNeighborTable(ns3::Ptr<ns3::Node> localNode)
+{
+    if (m_neighborTable == nullptr) {
+        m_neighborTable = ns3::PeekPointer(localNode->GetObject<ns3::ndn::NeighborTable>());
+        if (m_neighborTable == nullptr) {
+            return false;
+        }
+    }
+    m_neighborTable->GetLinks(localNode, Rth, m_NT);
+    return true;
+}
+
 Face*
-OPT::selectFIB(ns3::Ptr<ns3::Node> localNode, const Interest &interest, std::set<Face*> candidateForwarders, const fib::Entry &fibEntry)
+OPT::selectFIB(ns3::Ptr<ns3::Node> localNode, std::set<Face*> candidateForwarders, const NamespaceInfo *namespaceInfo,
+               std::vector<DecisionCache::Candidate> *snapshot)
 {   
     std::vector<FaceStats> faceList;
+    auto now = time::steady_clock::now();
     for (auto& face : candidateForwarders) {
         if (face->getId() == 256 + m_nodes.GetN()) {
             return face;
@@ -237,18 +282,12 @@ OPT::selectFIB(ns3::Ptr<ns3::Node> localNode, const Interest &interest, std::set
         uint32_t nodeId = (face->getId() - 257) + (localNode->GetId() + 257 <= face->getId());
         // double distance = this->calculateDistance(localNode, m_nodes[nodeId]);
         double distance = this->caculateDR(localNode, m_nodes[nodeId]);
-        FaceInfo *info = m_measurements.getFaceInfo(fibEntry, interest, face->getId());
-        if (info == nullptr)
-        {
-            faceList.push_back({face, distance, 0, 0});
-            // NFD_LOG_DEBUG("Face="<<face->getId()<<" has no Info");
-        }
-        else
-        {
-            double sisr = info->getSmoothedISR();
-            double srtt = 10 - boost::chrono::duration_cast<boost::chrono::duration<double>>(info->getSrtt()).count(); // 正向化处理SRTT指标
-            faceList.push_back({face, distance, sisr, srtt});
-            // NFD_LOG_DEBUG("Face=" << face->getId() << ", Distance=" << distance << ", SISR=" << sisr << ", SRTT=" << srtt);
+        double sisr = 0, srtt = 0;
+        isr::IsrMeasurements::measureFace(namespaceInfo, face->getId(), now, sisr, srtt);
+        faceList.push_back({face, distance, sisr, srtt});
+        // NFD_LOG_DEBUG("Face=" << face->getId() << ", Distance=" << distance << ", SISR=" << sisr << ", SRTT=" << srtt);
+        if (snapshot != nullptr) {
+            snapshot->push_back({face->getId(), sisr, srtt});
         }
     }
 
@@ -266,92 +305,29 @@ OPT::selectFIB(ns3::Ptr<ns3::Node> localNode, const Interest &interest, std::set
 
 std::vector<OPT::FaceStats>
 OPT::customNormalize(std::vector<FaceStats>& faceList) {
-    double letSum=0, lapSum=0, srttSum=0;
-    std::vector<FaceStats> normalizedFaceList;
-    for (const auto& faceStats: faceList) {
-        letSum += pow(faceStats.distance, 2);
-        lapSum += pow(faceStats.sisr, 2);
-        srttSum += pow(faceStats.srtt, 2);
-    }
-    for (auto& faceStats : faceList) {
-        Face* face = faceStats.face;
-        double let =  letSum>0 ? 1.0/3.0 * faceStats.distance / sqrt(letSum) : 0;
-        double lap = lapSum>0?  1.0/3.0 * faceStats.sisr / sqrt(lapSum) : 0;
-        double srtt = srttSum>0?  1.0/3.0 * faceStats.srtt / sqrt(srttSum) : 0;
-        normalizedFaceList.push_back({face, let, lap, srtt});
-        // NFD_LOG_DEBUG("Face="<<face->getId()<<", nor_Distance="<<let<<", nor_SISR="<<lap<<", nor_SRTT="<<srtt);
-    }
-    return normalizedFaceList;
+    return vanet::topsisNormalize(faceList);
 }
 
 OPT::FaceStats
 OPT::calculateIdealSolution(std::vector<FaceStats> &faceList) {
-    FaceStats idealSolution(
-        faceList[0].face, // 使用第一个节点作为默认值
-        (std::max_element(faceList.begin(), faceList.end(), [](const auto &a, const auto &b)
-                          { return a.distance < b.distance; }))
-            ->distance,
-        (std::max_element(faceList.begin(), faceList.end(), [](const auto &a, const auto &b)
-                          { return a.sisr < b.sisr; }))
-            ->sisr,
-        (std::max_element(faceList.begin(), faceList.end(), [](const auto &a, const auto &b)
-                          { return a.srtt < b.srtt; }))
-            ->srtt);
-    // NFD_LOG_DEBUG("Ideal: D="<<idealSolution.distance<<", SISR="<<idealSolution.sisr<<", SRTT="<<idealSolution.srtt);
-    return idealSolution;
+    return vanet::topsisIdealSolution(faceList);
 }
 
 OPT::FaceStats
 OPT::calculateNegativeIdealSolution(std::vector<FaceStats> &faceList) {
-    FaceStats negativeIdealSolution(
-        faceList[0].face, // 使用第一个节点作为默认值
-        (std::min_element(faceList.begin(), faceList.end(), [](const auto &a, const auto &b)
-                          { return a.distance < b.distance; }))
-            ->distance,
-        (std::min_element(faceList.begin(), faceList.end(), [](const auto &a, const auto &b)
-                          { return a.sisr < b.sisr; }))
-            ->sisr,
-        (std::min_element(faceList.begin(), faceList.end(), [](const auto &a, const auto &b)
-                          { return a.srtt < b.srtt; }))
-            ->srtt);
-    // NFD_LOG_DEBUG("Neg: D=" << negativeIdealSolution.distance << ", SISR=" << negativeIdealSolution.sisr << ", SRTT=" << negativeIdealSolution.srtt);
-    return negativeIdealSolution;
+    return vanet::topsisNegativeIdealSolution(faceList);
 }
 
 double
 OPT::calculateCloseness(const OPT::FaceStats &entry, const OPT::FaceStats &idealSolution, const OPT::FaceStats &negativeIdealSolution)
 {
-    double distanceIdealDeviation = entry.distance - idealSolution.distance;
-    double relativeVelIdealDeviation = entry.sisr - idealSolution.sisr;
-    double LETIdealDeviation = entry.srtt - idealSolution.srtt;
-    double closenessToIdeal = sqrt(pow(distanceIdealDeviation, 2) + pow(relativeVelIdealDeviation, 2) + pow(LETIdealDeviation, 2));
-    // NFD_LOG_DEBUG("disToIdeal="<<distanceIdealDeviation<<", velToIdeal="<<relativeVelIdealDeviation<<", letIdeal="<<LETIdealDeviation<<" clossToIdeal="<<closenessToIdeal);
-
-    double distanceNegDeviation = entry.distance - negativeIdealSolution.distance;
-    double relativeVelNegDeviation = entry.sisr - negativeIdealSolution.sisr;
-    double LETNegDeviation = entry.srtt - negativeIdealSolution.srtt;
-    double closenessToNeg = sqrt(pow(distanceNegDeviation, 2) + pow(relativeVelNegDeviation, 2) + pow(LETNegDeviation, 2));
-    // NFD_LOG_DEBUG("disToNeg="<<distanceNegDeviation<<", velToIdeal="<<relativeVelNegDeviation<<", letIdeal="<<LETNegDeviation<<" clossToIdeal="<<closenessToNeg);
-
-    double closeness = closenessToNeg / (closenessToIdeal + closenessToNeg);
-    // NFD_LOG_DEBUG("node="<<entry.node->GetId()<<", closeness="<<closeness);
-
-    return closeness;
+    return vanet::topsisCloseness(entry, idealSolution, negativeIdealSolution);
 }
 
 OPT::FaceStats&
 OPT::getOptimalDecision(std::vector<OPT::FaceStats> &faceList)
 {
-    std::vector<double> closenessValues;
-    FaceStats idealSolution = this->calculateIdealSolution(faceList);
-    FaceStats negIdealSolution = this->calculateNegativeIdealSolution(faceList);
-    for (const auto &entry : faceList)
-    {
-        double closeness = this->calculateCloseness(entry, idealSolution, negIdealSolution);
-        closenessValues.push_back(closeness);
-    }
-    size_t optIndex = std::distance(closenessValues.begin(), std::max_element(closenessValues.begin(), closenessValues.end()));
-    FaceStats& optimalDecision = faceList[optIndex];
+    FaceStats& optimalDecision = faceList[vanet::topsisOptimalIndex(faceList)];
         // NFD_LOG_DEBUG("Optimal Decision = " << optimalDecision.face->getId());
     return optimalDecision;
 }
@@ -369,15 +345,9 @@ double
 OPT::caculateDR(ns3::Ptr<ns3::Node> sendNode, ns3::Ptr<ns3::Node> receiveNode)
 {
     double eculid = this->calculateDistance(sendNode, receiveNode);
-    ns3::Ptr<ns3::MobilityModel> mobility = sendNode->GetObject<ns3::MobilityModel>();
-    ns3::Vector3D nodePos = mobility->GetPosition();
-    ns3::Ptr<ns3::MobilityModel> remoteMob = receiveNode->GetObject<ns3::MobilityModel>();
-    ns3::Vector3D remotePos = remoteMob->GetPosition();
-    // ns3::Vector3D direction = remoteMob->GetVelocity();
-    ns3::Vector3D direction = {1.0, 0.0, 0.0};
-    double angle = std::atan2(direction.x, direction.y) - std::atan2(remotePos.x - nodePos.x, remotePos.y - nodePos.y);
-    double dr = abs(eculid * cos(angle));
-    return dr;
+    ns3::Vector3D nodePos = sendNode->GetObject<ns3::MobilityModel>()->GetPosition();
+    ns3::Vector3D remotePos = receiveNode->GetObject<ns3::MobilityModel>()->GetPosition();
+    return vanet::roadDistance(nodePos, remotePos, eculid);
 }
 
 double
@@ -385,13 +355,8 @@ OPT::calculateLET(ns3::Ptr<ns3::Node> sendNode, ns3::Ptr<ns3::Node> revNode) {
     ns3::Ptr<ns3::MobilityModel> mobility1 = sendNode->GetObject<ns3::MobilityModel>();
 	ns3::Ptr<ns3::MobilityModel> mobility2 = revNode->GetObject<ns3::MobilityModel>();
     if (mobility1->GetDistanceFrom(mobility2) >= Rth) {return 0;}
-    double m = mobility1->GetPosition().x - mobility2->GetPosition().x;
-    double n = mobility1->GetPosition().y - mobility2->GetPosition().y;
-    double p = mobility1->GetVelocity().x - mobility2->GetVelocity().x;
-    double q = mobility1->GetVelocity().y - mobility2->GetVelocity().y;
-    if (p==0 && q==0) {return 1e6;} //相对速度为0时，用1e6表示无限大
-    double let = (-(m*p+n*q)+sqrt((pow(p,2)+pow(q,2))*pow(Rth,2) - pow(n*p-m*q, 2)) ) / (pow(p,2)+pow(q,2));
-    return let;
+    return vanet::linkExpirationTime(mobility1->GetPosition(), mobility1->GetVelocity(),
+                                     mobility2->GetPosition(), mobility2->GetVelocity(), Rth);
 }
 
 ns3::Ptr<ns3::Node>
@@ -399,7 +364,7 @@ OPT::getNode(OPT& local_strategy) {
     ns3::Ptr<ns3::Node> localNode;
     for (const auto &node : m_nodes)
     {
-        ns3::Ptr<ns3::ndn::L3Protocol> ndn = node->GetObject<ns3::ndn::L3Protocol>();
+        ns3::ndn::L3Protocol* ndn = m_nodes.GetL3(node->GetId());
         ndn::Name prefix("/ustc");
         //此处有个坑：注册nfd时先是采用BestRouteStrategy2策略，其需要先发送set信息，因此需保证此时已经设置完毕策略
         nfd::fw::Strategy &strategy = ndn->getForwarder()->getStrategyChoice().findEffectiveStrategy(prefix);
@@ -411,6 +376,12 @@ OPT::getNode(OPT& local_strategy) {
     }
 }
 
+void
+OPT::reportTableSizes(std::vector<TableSize>& tables) const {
+    tables.push_back(makeTableSize("OPT::m_NT", m_NT));
+    tables.push_back({"OPT::m_decisionCache", m_decisionCache.size(), m_decisionCache.getBytes()});
+}
+
 }  // namespace opt
 }  // namespace fw
 }  // namespace nfd
\ No newline at end of file
@@ -4,33 +4,24 @@
 #include "ns3/ndnSIM/model/ndn-l3-protocol.hpp"
 #include "ns3/ndnSIM/NFD/daemon/fw/strategy.hpp"
 #include "ns3/ndnSIM/NFD/daemon/fw/retx-suppression-exponential.hpp"
-#include "opt-measurements.hpp"
-#include "ns3/node-container.h"
+#include "isr-measurements.hpp"
+#include "decision-cache.hpp"
+#include "node-registry.hpp"
+#include "ndn-neighbor-table.hpp"
 #include "ns3/node.h"
 #include "ns3/vector.h"
+#include "vanet-kernels.hpp"
+#include "table-size-reporter.hpp"
 namespace nfd {
 namespace fw {
 namespace opt {
 
-class OPT : public Strategy
-{
-struct  neighborTableEntry {
-	ns3::Ptr<ns3::Node> node;
-    ns3::Vector3D position;
-    ns3::Vector3D velocity;
-    double LET;
-    double linkProb;
-	neighborTableEntry(ns3::Ptr<ns3::Node> n, ns3::Vector3D pos, ns3::Vector3D vel, double let, double prob) : node(n), position(pos), velocity(vel), LET(let), linkProb(prob) {}
-};
+using isr::FaceInfo;
+using isr::NamespaceInfo;
 
-struct FaceStats
+class OPT : public Strategy, public TableSizeReporter
 {
-  Face* face;
-  double distance;
-  double sisr;
-  double srtt;
-  FaceStats(Face* f, double d, double isr, double rtt) : face(f), distance(d), sisr(isr), srtt(rtt) {}
-};
+using FaceStats = vanet::FaceStats;
 
 public:
 	explicit OPT(Forwarder &forwarder, const Name &name = getStrategyName());
@@ -38,6 +29,9 @@ public:
 	static const Name &
 	getStrategyName();
 
+	void
+	reportTableSizes(std::vector<TableSize>& tables) const override;
+
 	void
 	afterReceiveInterest(const FaceEndpoint &ingress, const Interest &interest,
 						 const shared_ptr<pit::Entry> &pitEntry) override;
@@ -63,9 +57,18 @@ public:
     std::set<Face*>
     getCandidateForwarders(const fib::NextHopList &nexthops, ns3::Ptr<ns3::Node> curNode, std::set<ns3::Ptr<ns3::Node>> srcNodes);
 
-    /*在FIB中选择下一跳*/
+    /*用信标维护的邻居表刷新m_NT, 节点未安装信标时返回false*/
+    bool
+    updateNeighborTable(ns3::Ptr<ns3::Node> localNode);
+
+    /*在FIB中选择下一跳, namespaceInfo由selectEgress查好, snapshot非空时记录每个候选的SISR和SRTT*/
+    Face*
+    selectFIB(ns3::Ptr<ns3::Node> localNode, std::set<Face *> candidateForwarders, const NamespaceInfo *namespaceInfo,
+              std::vector<DecisionCache::Candidate> *snapshot = nullptr);
+
+    /*先查决策缓存, 未命中时计算候选转发者并调用selectFIB*/
     Face*
-    selectFIB(ns3::Ptr<ns3::Node> localNode, const Interest &interest, std::set<Face *> candidateForwarders, const fib::Entry &fibEntry);
+    selectEgress(ns3::Ptr<ns3::Node> localNode, const Interest &interest, const std::set<ns3::Ptr<ns3::Node>> &sources, const fib::Entry &fibEntry);
 
     /*计算节点间距离*/				
     double
@@ -106,9 +109,11 @@ public:
 private:
 	static const double Rth;
 
-	ns3::NodeContainer m_nodes;
-	std::vector<OPT::neighborTableEntry> m_NT;
-    OptMeasurements m_measurements;
+	const ns3::ndn::NodeRegistry& m_nodes;
+	std::vector<ns3::ndn::NeighborTable::Link> m_NT;
+	ns3::ndn::NeighborTable* m_neighborTable = nullptr;
+    isr::IsrMeasurements m_measurements;
+    DecisionCache m_decisionCache;
 
 	PUBLIC_WITH_TESTS_ELSE_PRIVATE : static const time::milliseconds RETX_SUPPRESSION_INITIAL;
 	static const time::milliseconds RETX_SUPPRESSION_MAX;
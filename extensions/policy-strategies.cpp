@@ -0,0 +1,70 @@
+#include "policy-strategy.hpp"
+
+namespace nfd {
+namespace fw {
+
+/* DASB/LISIC/VNDN/LSIF的策略组合, 以原来的策略名注册, 取代原先的手写实现.
+ * 实例名参数不变, 如DASB/%FD%01/defer-max~0.004 */
+
+struct VndnPolicy {
+    static constexpr char NAME[] = "VNDN";
+    static constexpr double RANGE = 200.0;
+    using Motion = policy::TaggedPosition;
+    using Candidates = policy::FirstEligible;
+    using Relay = policy::AlwaysRelay;
+    using Defer = policy::InverseDistanceDefer;
+    using Suppression = policy::DuplicateSuppression;
+    using DataReturn = policy::ReversePath;
+};
+
+struct DasbPolicy {
+    static constexpr char NAME[] = "DASB";
+    static constexpr double RANGE = 200.0;
+    using Motion = policy::TaggedPosition;
+    using Candidates = policy::FirstEligible;
+    using Relay = policy::AlwaysRelay;
+    using Defer = policy::RangeEdgeDefer;
+    using Suppression = policy::AngleSuppression;
+    using DataReturn = policy::DeferredBroadcast;
+};
+
+struct LisicPolicy {
+    static constexpr char NAME[] = "LISIC";
+    static constexpr double RANGE = 200.0;
+    using Motion = policy::TaggedPosition;
+    using Candidates = policy::FirstEligible;
+    using Relay = policy::AlwaysRelay;
+    using Defer = policy::LinkLifetimeDefer;
+    using Suppression = policy::DuplicateSuppression;
+    using DataReturn = policy::ReversePath;
+};
+
+struct LsifPolicy {
+    static constexpr char NAME[] = "LSIF";
+    static constexpr double RANGE = 200.0;
+    using Motion = policy::ModelMotion;
+    using Candidates = policy::FirstEligible;
+    using Relay = policy::MinLinkLifetime;
+    using Defer = policy::NoDefer;
+    using Suppression = policy::DuplicateSuppression;
+    using DataReturn = policy::UncheckedReversePath;
+};
+
+using VNDN = PolicyStrategy<VndnPolicy>;
+using DASB = PolicyStrategy<DasbPolicy>;
+using LISIC = PolicyStrategy<LisicPolicy>;
+using LSIF = PolicyStrategy<LsifPolicy>;
+
+// 日志成员的特化须在注册(隐式实例化)之前
+NFD_LOG_MEMBER_INIT_SPECIALIZED(PolicyStrategy<VndnPolicy>, VNDN);
+NFD_LOG_MEMBER_INIT_SPECIALIZED(PolicyStrategy<DasbPolicy>, DASB);
+NFD_LOG_MEMBER_INIT_SPECIALIZED(PolicyStrategy<LisicPolicy>, LISIC);
+NFD_LOG_MEMBER_INIT_SPECIALIZED(PolicyStrategy<LsifPolicy>, LSIF);
+
+NFD_REGISTER_STRATEGY(VNDN);
+NFD_REGISTER_STRATEGY(DASB);
+NFD_REGISTER_STRATEGY(LISIC);
+NFD_REGISTER_STRATEGY(LSIF);
+
+} // namespace fw
+} // namespace nfd
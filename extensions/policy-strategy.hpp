@@ -0,0 +1,503 @@
+#ifndef NFD_DAEMON_FW_POLICY_STRATEGY_HPP
+#define NFD_DAEMON_FW_POLICY_STRATEGY_HPP
+
+#include "ns3/ndnSIM/NFD/daemon/fw/strategy.hpp"
+#include "ns3/ndnSIM/NFD/daemon/fw/algorithm.hpp"
+#include "common/logger.hpp"
+#include "geo-tag-tracker.hpp"
+#include "hop-tracer.hpp"
+#include "name-interner.hpp"
+#include "ndn-wifi-net-device-transport-broadcast.hpp"
+#include "node-registry.hpp"
+#include "strategy-parameters.hpp"
+#include "strategy-profiler.hpp"
+#include "table-size-reporter.hpp"
+#include "vanet-kernels.hpp"
+#include "vanet-probes.hpp"
+
+#include "ns3/mobility-model.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/simulator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace nfd {
+namespace fw {
+namespace policy {
+
+/* 策略组件只做判断和计算, 收发和等待表由PolicyStrategy完成.
+ * 组件的阈值从实例名参数读取, 键名和缺省值沿用原先各策略的实现, 无参数的组件parse为空.
+ * 等待时间的随机扰动取自ns-3随机数流, 随RngSeed/RngRun复现 */
+
+/* 组件的输入: 上一跳和本节点的位置/速度 */
+struct Context {
+    GeoTagTracker::Motion sender;
+    GeoTagTracker::Motion receiver;
+    double range;
+
+    double distance() const { return ns3::CalculateDistance(sender.position, receiver.position); }
+};
+
+/* 上一跳运动信息: 位置优先取自GeoTag, 速度与没有GeoTag时的位置取自对端移动模型 (DASB/LISIC/VNDN) */
+struct TaggedPosition {
+    static constexpr bool USES_GEO_TAGS = true;
+};
+
+/* 上一跳运动信息: 全部取自对端移动模型, 不发送GeoTag (LSIF) */
+struct ModelMotion {
+    static constexpr bool USES_GEO_TAGS = false;
+};
+
+/* 候选过滤: 取第一个合格的下一跳, 广播face上即唯一的无线face */
+struct FirstEligible {
+    static fib::NextHopList::const_iterator
+    select(const fib::NextHopList& nexthops, const FaceEndpoint& ingress, const Interest& interest,
+           const shared_ptr<pit::Entry>& pitEntry) {
+        return std::find_if(nexthops.begin(), nexthops.end(), [&](const auto& nexthop) {
+            return isNextHopEligible(ingress.face, interest, nexthop, pitEntry);
+        });
+    }
+};
+
+/* 转发判据: 总是参与转发 */
+struct AlwaysRelay {
+    void parse(StrategyParameters&) {}
+
+    bool accept(const Context&) const { return true; }
+};
+
+/* 转发判据: 与上一跳的LET不小于let-alpha时才转发 (LSIF) */
+struct MinLinkLifetime {
+    double minLet = 10.0;
+
+    void parse(StrategyParameters& params) { minLet = params.get("let-alpha", minLet); }
+
+    bool accept(const Context& c) const {
+        return vanet::linkExpirationTime(c.sender.position, c.sender.velocity,
+                                         c.receiver.position, c.receiver.velocity, c.range) >= minLet;
+    }
+};
+
+/* 等待时间: 不等待, 立即转发 */
+struct NoDefer {
+    static constexpr bool IS_DEFERRED = false;
+
+    void parse(StrategyParameters&) {}
+
+    double compute(const Context&, ns3::UniformRandomVariable&) const { return 0; }
+};
+
+/* 等待时间: 与距离成反比 (VNDN) */
+struct InverseDistanceDefer {
+    static constexpr bool IS_DEFERRED = true;
+
+    void parse(StrategyParameters&) {}
+
+    double compute(const Context& c, ns3::UniformRandomVariable& random) const {
+        double T_random = random.GetValue(0, 0.1);
+        return 1 / (c.distance() + 0.0001) * (1 + T_random);
+    }
+};
+
+/* 等待时间: 越靠近通信范围边缘越短, 最长defer-max (DASB) */
+struct RangeEdgeDefer {
+    static constexpr bool IS_DEFERRED = true;
+    double maxDefer = 2e-3;
+
+    void parse(StrategyParameters& params) { maxDefer = params.get("defer-max", maxDefer); }
+
+    double compute(const Context& c, ns3::UniformRandomVariable& random) const {
+        double T_random = random.GetValue(0, 0.1); // 不加随机会出现m_phy->m_event !=0 的bug
+        return std::abs(c.range - c.distance()) * maxDefer / c.range * (1 + T_random);
+    }
+};
+
+/* 等待时间: 与LET成反比, 超出范围时LET为0 (LISIC) */
+struct LinkLifetimeDefer {
+    static constexpr bool IS_DEFERRED = true;
+    double alpha = 1.0e9; // Time scale factor
+
+    void parse(StrategyParameters& params) { alpha = params.get("alpha", alpha); }
+
+    double compute(const Context& c, ns3::UniformRandomVariable& random) const {
+        double let = c.distance() > c.range ? 0 :
+                     vanet::linkExpirationTime(c.sender.position, c.sender.velocity,
+                                               c.receiver.position, c.receiver.velocity, c.range);
+        double T_random = random.GetValue(0, 0.1);
+        return alpha * std::pow(2 * c.range / 3 / 1e8, 2) / let * (1 + T_random) + c.range / 3 / 1e8;
+    }
+};
+
+/* 抑制规则: 等待期间收到相同的包即取消转发 */
+struct DuplicateSuppression {
+    static constexpr bool USES_POSITION = false;
+
+    void parse(StrategyParameters&) {}
+
+    bool shouldSuppress(const ns3::Vector&, const Context&) const { return true; }
+};
+
+/* 抑制规则: 新发送者位于以先前发送者为顶点、指向本节点的扇形内时取消转发 (DASB) */
+struct AngleSuppression {
+    static constexpr bool USES_POSITION = true;
+    double angle = M_PI / 4;
+
+    void parse(StrategyParameters& params) { angle = params.get("suppression-angle", angle); }
+
+    bool shouldSuppress(const ns3::Vector& prePosition, const Context& c) const {
+        return vanet::isInSuppressRegion(prePosition, c.sender.position, c.receiver.position, angle);
+    }
+};
+
+/* Data返回: 沿PIT入记录直接返回, 没有出记录(本节点未转发过该Interest)时丢弃 (LISIC/VNDN) */
+struct ReversePath {
+    static constexpr bool IS_DEFERRED = false;
+    static constexpr bool NEEDS_OUT_RECORD = true;
+};
+
+/* Data返回: 沿PIT入记录直接返回, 不检查出记录 (LSIF) */
+struct UncheckedReversePath {
+    static constexpr bool IS_DEFERRED = false;
+    static constexpr bool NEEDS_OUT_RECORD = false;
+};
+
+/* Data返回: 与Interest一样等待后广播, 使用同一组等待时间和抑制规则 (DASB) */
+struct DeferredBroadcast {
+    static constexpr bool IS_DEFERRED = true;
+    static constexpr bool NEEDS_OUT_RECORD = true;
+};
+
+} // namespace policy
+
+/** \brief broadcast VANET strategy assembled at compile time from policies
+ *
+ *  \p Policy is a struct with
+ *  - `static constexpr char NAME[]`, the strategy name component and logger name
+ *  - `static constexpr double RANGE`, the transmission range
+ *  - member types Motion, Candidates, Relay, Defer, Suppression and
+ *    DataReturn, each one of the components in nfd::fw::policy or any struct
+ *    with the same members
+ *
+ *  DASB, LISIC, VNDN and LSIF are instantiations of this template,
+ *  registered under their own names in policy-strategies.cpp. The skeleton
+ *  they share lives here once: parameter parsing, direct delivery to and
+ *  from the app face, the (Name, Nonce) wait tables, defer scheduling,
+ *  suppression of duplicates, afterContentStoreHit and the Data return.
+ *  Relay, Defer and Suppression are held by value and read their thresholds
+ *  from the instance name. Components are called directly and through
+ *  `if constexpr`, so every combination is compiled and inlined on its own,
+ *  with no virtual call or std::function per packet.
+ *
+ *  The components were carried over from the former hand-written classes
+ *  with the same keys, defaults, formulas and motion sources. That parity
+ *  was checked by reading the two side by side, not by comparing runs.
+ *  Known differences: an Interest without an eligible next hop is dropped
+ *  (LISIC and LSIF dereferenced end() there), the app-face log line reads
+ *  "do Send Interest=", and the defer jitter comes from one ns-3
+ *  UniformRandomVariable per instance. Before, every packet seeded its own
+ *  mt19937 from std::random_device, and no run could be repeated.
+ */
+template<typename Policy>
+class PolicyStrategy : public Strategy, public TableSizeReporter {
+  public:
+    using Motion = typename Policy::Motion;
+    using Candidates = typename Policy::Candidates;
+    using Relay = typename Policy::Relay;
+    using Defer = typename Policy::Defer;
+    using Suppression = typename Policy::Suppression;
+    using DataReturn = typename Policy::DataReturn;
+
+    static_assert(!DataReturn::IS_DEFERRED || Defer::IS_DEFERRED,
+                  "a deferred Data return needs a defer-time policy");
+
+    explicit PolicyStrategy(Forwarder& forwarder, const Name& name = getStrategyName());
+
+    static const Name& getStrategyName();
+
+    void reportTableSizes(std::vector<TableSize>& tables) const override;
+
+    void afterReceiveInterest(const FaceEndpoint& ingress, const Interest& interest,
+                              const shared_ptr<pit::Entry>& pitEntry) override;
+
+    void afterReceiveLoopedInterest(const FaceEndpoint& ingress, const Interest& interest,
+                                    pit::Entry& pitEntry) override;
+
+    void afterContentStoreHit(const shared_ptr<pit::Entry>& pitEntry, const FaceEndpoint& ingress,
+                              const Data& data) override;
+
+    void afterReceiveData(const shared_ptr<pit::Entry>& pitEntry, const FaceEndpoint& ingress,
+                          const Data& data) override;
+
+  private:
+    struct WaitEntry {
+        NameInterner::Id nameId;
+        uint32_t nonce;
+        ns3::Vector prePosition;
+        ns3::EventId eventId;
+    };
+
+    using WaitTable = std::vector<WaitEntry>;
+
+    void doSendInterest(const shared_ptr<pit::Entry>& pitEntry, const FaceEndpoint& egress,
+                        const FaceEndpoint& ingress, const Interest& interest);
+
+    void doSendData(const shared_ptr<pit::Entry>& pitEntry, const Data& data, const FaceEndpoint& egress);
+
+    /** \return true if the pending send in \p it was cancelled
+     */
+    bool suppress(typename WaitTable::iterator it, WaitTable& table, const FaceEndpoint& ingress,
+                  const ndn::TagHost& packet);
+
+    policy::Context makeContext(const FaceEndpoint& ingress, const ndn::TagHost& packet);
+
+    FaceId getAppFaceId() const { return 256 + m_nodes.GetN(); }
+
+    static typename WaitTable::iterator findEntry(const Name& name, uint32_t nonce, WaitTable& table);
+
+  private:
+    const ns3::ndn::NodeRegistry& m_nodes;
+    // 只有Motion使用GeoTag时才创建, 否则不开启GeoTagHelper
+    std::optional<GeoTagTracker> m_geoTags;
+    Relay m_relay;
+    Defer m_defer;
+    Suppression m_suppression;
+    WaitTable m_waitTableInt;
+    WaitTable m_waitTableDat;
+    // 流号由ns-3自动分配, 取值随RngSeed/RngRun确定
+    ns3::Ptr<ns3::UniformRandomVariable> m_random;
+
+    NFD_LOG_MEMBER_DECL();
+};
+
+template<typename Policy>
+PolicyStrategy<Policy>::PolicyStrategy(Forwarder& forwarder, const Name& name)
+    : Strategy(forwarder),
+      m_nodes(ns3::ndn::NodeRegistry::Get()),
+      m_random(ns3::CreateObject<ns3::UniformRandomVariable>()) {
+    if constexpr (Motion::USES_GEO_TAGS) {
+        m_geoTags.emplace(forwarder);
+    }
+    ParsedInstanceName parsed = parseInstanceName(name);
+    StrategyParameters params(Policy::NAME, parsed.parameters);
+    m_relay.parse(params);
+    m_defer.parse(params);
+    m_suppression.parse(params);
+    params.checkUnused();
+    if (parsed.version && *parsed.version != getStrategyName()[-1].toVersion()) {
+        NDN_THROW(std::invalid_argument(std::string(Policy::NAME) + " does not support version " +
+                                        to_string(*parsed.version)));
+    }
+    this->setInstanceName(makeInstanceName(name, getStrategyName()));
+}
+
+template<typename Policy>
+const Name& PolicyStrategy<Policy>::getStrategyName() {
+    static Name strategyName(std::string("/localhost/nfd/strategy/") + Policy::NAME + "/%FD%01");
+    return strategyName;
+}
+
+template<typename Policy>
+void PolicyStrategy<Policy>::afterReceiveInterest(const FaceEndpoint& ingress, const Interest& interest,
+                                                  const shared_ptr<pit::Entry>& pitEntry) {
+    STRATEGY_PROFILE(Policy::NAME);
+    const fib::NextHopList& nexthops = this->lookupFib(*pitEntry).getNextHops();
+    auto it = Candidates::select(nexthops, ingress, interest, pitEntry);
+    if (it == nexthops.end()) {
+        return;
+    }
+
+    auto egress = FaceEndpoint(it->getFace(), 0);
+    // 如果是Consumer端或Producer端，则直接转发给应用层，无需等待
+    if (ingress.face.getId() == getAppFaceId() || egress.face.getId() == getAppFaceId()) {
+        NFD_LOG_INFO("do Send Interest=" << interest << " from=" << ingress << " to=" << egress);
+        this->sendInterest(pitEntry, egress, interest);
+        return;
+    }
+
+    if constexpr (Defer::IS_DEFERRED) {
+        // pitEntry到达TTL被删除时不会触发afterReceiveLoopedInterest(), 此时WT中可能还有等待转发的表项
+        auto entry = findEntry(interest.getName(), interest.getNonce(), m_waitTableInt);
+        if (entry != m_waitTableInt.end()) {
+            if (this->suppress(entry, m_waitTableInt, ingress, interest)) {
+                // 取消发送后删除对应的PIT表项
+                this->setExpiryTimer(pitEntry, 0_ms);
+            }
+            return;
+        }
+    }
+
+    policy::Context context = this->makeContext(ingress, interest);
+    if (!m_relay.accept(context)) {
+        this->setExpiryTimer(pitEntry, 0_ms);
+        return;
+    }
+    if constexpr (!Defer::IS_DEFERRED) {
+        NFD_LOG_INFO("do Send Interest=" << interest << " from=" << ingress << " to=" << egress);
+        this->sendInterest(pitEntry, egress, interest);
+        return;
+    }
+    double deferTime = m_defer.compute(context, *m_random);
+    auto eventId = ns3::Simulator::Schedule(ns3::Seconds(deferTime), &PolicyStrategy::doSendInterest, this,
+                                            pitEntry, egress, ingress, interest);
+    ns3::HopTracer::Deferred(interest, deferTime);
+    VANET_PROBE3(defer_schedule, Policy::NAME, eventId.GetUid(), uint64_t(deferTime * 1e9));
+    m_waitTableInt.push_back({NameInterner::get().intern(interest.getName()), interest.getNonce(),
+                              context.sender.position, eventId});
+}
+
+template<typename Policy>
+void PolicyStrategy<Policy>::afterReceiveLoopedInterest(const FaceEndpoint& ingress, const Interest& interest,
+                                                        pit::Entry& pitEntry) {
+    STRATEGY_PROFILE(Policy::NAME);
+    auto it = findEntry(interest.getName(), interest.getNonce(), m_waitTableInt);
+    if (it != m_waitTableInt.end() && this->suppress(it, m_waitTableInt, ingress, interest)) {
+        // 取消发送后删除对应的PIT表项
+        std::shared_ptr<pit::Entry> sharedPitEntry(&pitEntry, [] (pit::Entry*) {});
+        this->setExpiryTimer(sharedPitEntry, 0_ms);
+    }
+}
+
+template<typename Policy>
+void PolicyStrategy<Policy>::doSendInterest(const shared_ptr<pit::Entry>& pitEntry, const FaceEndpoint& egress,
+                                            const FaceEndpoint& ingress, const Interest& interest) {
+    STRATEGY_PROFILE(Policy::NAME);
+    NFD_LOG_INFO("do Send Interest=" << interest << " from=" << ingress << " to=" << egress);
+    this->sendInterest(pitEntry, egress, interest);
+    auto it = findEntry(interest.getName(), interest.getNonce(), m_waitTableInt);
+    if (it != m_waitTableInt.end()) {
+        m_waitTableInt.erase(it);
+    }
+}
+
+template<typename Policy>
+void PolicyStrategy<Policy>::afterContentStoreHit(const shared_ptr<pit::Entry>& pitEntry,
+                                                  const FaceEndpoint& ingress, const Data& data) {
+    STRATEGY_PROFILE(Policy::NAME);
+    this->sendData(pitEntry, data, ingress);
+    NFD_LOG_DEBUG("do Send Data=" << data.getName() << ", from=" << ingress);
+}
+
+template<typename Policy>
+void PolicyStrategy<Policy>::afterReceiveData(const shared_ptr<pit::Entry>& pitEntry, const FaceEndpoint& ingress,
+                                              const Data& data) {
+    STRATEGY_PROFILE(Policy::NAME);
+    if (DataReturn::NEEDS_OUT_RECORD && pitEntry->getOutRecords().size() == 0) {
+        return;
+    }
+    auto egress = FaceEndpoint(pitEntry->getInRecords().begin()->getFace(), 0);
+    if constexpr (!DataReturn::IS_DEFERRED) {
+        NFD_LOG_DEBUG("do Send Data=" << data.getName() << ", from=" << ingress << ", to=" << egress);
+        this->sendData(pitEntry, data, egress);
+        return;
+    }
+
+    // 如果是Consumer端或Producer端，则直接转发给应用层，无需等待
+    auto now = time::steady_clock::now();
+    bool isTheConsumer = std::any_of(pitEntry->getInRecords().begin(), pitEntry->getInRecords().end(),
+                                     [&](const pit::InRecord& inRecord) {
+                                         return inRecord.getExpiry() > now &&
+                                                inRecord.getFace().getId() == getAppFaceId();
+                                     });
+    if (ingress.face.getId() == getAppFaceId() || isTheConsumer) {
+        this->sendData(pitEntry, data, egress);
+        NFD_LOG_DEBUG("do Send Data=" << data.getName() << "to= " << egress);
+        return;
+    }
+
+    auto it = findEntry(data.getName(), 0, m_waitTableDat);
+    if (it != m_waitTableDat.end()) {
+        this->suppress(it, m_waitTableDat, ingress, data);
+        return;
+    }
+    policy::Context context = this->makeContext(ingress, data);
+    double deferTime = m_defer.compute(context, *m_random);
+    auto eventId = ns3::Simulator::Schedule(ns3::Seconds(deferTime), &PolicyStrategy::doSendData, this,
+                                            pitEntry, data, egress);
+    ns3::HopTracer::Deferred(data, deferTime);
+    VANET_PROBE3(defer_schedule, Policy::NAME, eventId.GetUid(), uint64_t(deferTime * 1e9));
+    m_waitTableDat.push_back({NameInterner::get().intern(data.getName()), 0, context.sender.position, eventId});
+}
+
+template<typename Policy>
+void PolicyStrategy<Policy>::doSendData(const shared_ptr<pit::Entry>& pitEntry, const Data& data,
+                                        const FaceEndpoint& egress) {
+    STRATEGY_PROFILE(Policy::NAME);
+    NFD_LOG_DEBUG("do Send Data=" << data.getName() << "to= " << egress);
+    this->sendData(pitEntry, data, egress);
+    auto it = findEntry(data.getName(), 0, m_waitTableDat);
+    if (it != m_waitTableDat.end()) {
+        m_waitTableDat.erase(it);
+    }
+}
+
+template<typename Policy>
+bool PolicyStrategy<Policy>::suppress(typename WaitTable::iterator it, WaitTable& table,
+                                      const FaceEndpoint& ingress, const ndn::TagHost& packet) {
+    if constexpr (Suppression::USES_POSITION) {
+        if (!m_suppression.shouldSuppress(it->prePosition, this->makeContext(ingress, packet))) {
+            return false;
+        }
+    }
+    else if (!m_suppression.shouldSuppress(it->prePosition, policy::Context())) {
+        return false;
+    }
+    VANET_PROBE2(defer_cancel, Policy::NAME, it->eventId.GetUid());
+    ns3::Simulator::Cancel(it->eventId);
+    table.erase(it);
+    return true;
+}
+
+template<typename Policy>
+policy::Context PolicyStrategy<Policy>::makeContext(const FaceEndpoint& ingress, const ndn::TagHost& packet) {
+    auto wifiTrans = dynamic_cast<ns3::ndn::WifiNetDeviceTransportBroadcast*>(ingress.face.getTransport());
+    uint32_t receiveNodeId = wifiTrans->GetNode()->GetId();
+    ns3::MobilityModel* receiveMobility = m_nodes.GetMobility(receiveNodeId);
+
+    policy::Context context;
+    context.range = Policy::RANGE;
+    context.receiver = {receiveMobility->GetPosition(), receiveMobility->GetVelocity()};
+    // 节点创建的face是从257开始依据节点序号依次递增的，据此计算face对端节点的序号
+    uint32_t sendNodeId = (ingress.face.getId() - 257) + (receiveNodeId + 257 <= ingress.face.getId());
+    ns3::MobilityModel* sendMobility = m_nodes.GetMobility(sendNodeId);
+    context.sender = {sendMobility->GetPosition(), sendMobility->GetVelocity()};
+    if constexpr (Motion::USES_GEO_TAGS) {
+        // 速度不用GeoTagTracker的估计值: 收到第二个GeoTag前为0, 会改变LET和等待时间
+        // GeoTag只有位置字段, 速度仍来自全局移动模型, MPI分区运行时靠每个进程回放完整的移动轨迹
+        GeoTagTracker::Motion tagged;
+        if (m_geoTags->update(ingress.face.getId(), packet, tagged)) {
+            context.sender.position = tagged.position;
+        }
+    }
+    return context;
+}
+
+template<typename Policy>
+typename PolicyStrategy<Policy>::WaitTable::iterator
+PolicyStrategy<Policy>::findEntry(const Name& name, uint32_t nonce, WaitTable& table) {
+    NameInterner::Id nameId = NameInterner::get().find(name);
+    // 未被intern过的Name不可能在表中
+    if (nameId == NameInterner::INVALID_ID) {
+        return table.end();
+    }
+    return std::find_if(table.begin(), table.end(), [&](const WaitEntry& entry) {
+        return entry.nameId == nameId && entry.nonce == nonce;
+    });
+}
+
+template<typename Policy>
+void PolicyStrategy<Policy>::reportTableSizes(std::vector<TableSize>& tables) const {
+    tables.push_back(makeTableSize(std::string(Policy::NAME) + "::m_waitTableInt", m_waitTableInt));
+    tables.push_back(makeTableSize(std::string(Policy::NAME) + "::m_waitTableDat", m_waitTableDat));
+    if (m_geoTags) {
+        tables.push_back({std::string(Policy::NAME) + "::m_geoTags", m_geoTags->size(), m_geoTags->getBytes()});
+    }
+}
+
+} // namespace fw
+} // namespace nfd
+
+#endif // NFD_DAEMON_FW_POLICY_STRATEGY_HPP
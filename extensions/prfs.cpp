@@ -14,6 +14,8 @@
 #include <cmath>
 
 #include "ndn-cxx/interest.hpp"
+#include "strategy-profiler.hpp"
+#include "vanet-kernels.hpp"
 namespace nfd {
 namespace fw {
 
@@ -28,14 +30,14 @@ PRFS::PRFS(Forwarder& forwarder, const Name& name)
       ProcessNackTraits(this),
       m_Rth(200.0),
       m_LET_alpha(1.0),
-      m_nodes(ns3::NodeContainer::GetGlobal()),
+      m_nodes(ns3::ndn::NodeRegistry::Get()),
       m_retxSuppression(RETX_SUPPRESSION_INITIAL,
                         RetxSuppressionExponential::DEFAULT_MULTIPLIER,
                         RETX_SUPPRESSION_MAX) {
     ParsedInstanceName parsed = parseInstanceName(name);
-    if (!parsed.parameters.empty()) {
-        NDN_THROW(std::invalid_argument("PRFS does not accept parameters"));
-    }
+    StrategyParameters params("PRFS", parsed.parameters);
+    m_LET_alpha = params.get("let-alpha", m_LET_alpha);
+    params.checkUnused();
     if (parsed.version &&
         *parsed.version != getStrategyName()[-1].toVersion()) {
         NDN_THROW(std::invalid_argument("PRFS does not support version " +
@@ -54,11 +56,17 @@ void PRFS::afterReceiveInterest(const FaceEndpoint& ingress,
                                const Interest& interest,
                                const shared_ptr<pit::Entry>& pitEntry)
 {
+    STRATEGY_PROFILE("PRFS");
     const fib::Entry& fibEntry = this->lookupFib(*pitEntry);
     const fib::NextHopList& nexthops = fibEntry.getNextHops();
 
 	auto it = std::find_if(nexthops.begin(), nexthops.end(), [&](const auto &nexthop)
 					  { return isNextHopEligible(ingress.face, interest, nexthop, pitEntry); });
+	if (it == nexthops.end()) {
+		// NFD_LOG_DEBUG(interest << " from=" << ingress << " noNextHop");
+		this->setExpiryTimer(pitEntry, 0_ms);
+		return;
+	}
 	auto egress = FaceEndpoint(it->getFace(), 0);
 
     const auto transport = ingress.face.getTransport();
@@ -81,15 +89,22 @@ void PRFS::afterReceiveInterest(const FaceEndpoint& ingress,
         ns3::Ptr<ns3::Node> node = wifiTrans->GetNode();
         int pre_node = (ingress.face.getId() - 257) + (node->GetId()+257 <= ingress.face.getId());
         ns3::Ptr<ns3::Node> preNode = m_nodes[pre_node];
-    	ns3::Ptr<ns3::ndn::L3Protocol> ndn = preNode->GetObject<ns3::ndn::L3Protocol>();
+    	ns3::ndn::L3Protocol* ndn = m_nodes.GetL3(preNode->GetId());
 		ndn::Name prefix("/");
 		nfd::fw::Strategy& strategy =  ndn->getForwarder()->getStrategyChoice().findEffectiveStrategy(prefix);
     	nfd::fw::PRFS& prfs_strategy =  dynamic_cast<nfd::fw::PRFS&>(strategy);
-        std::vector<inteAddField> intTable = prfs_strategy.m_IntTable;
+        const std::vector<inteAddField>& intTable = prfs_strategy.m_IntTable;
+        NameInterner::Id nameId = NameInterner::get().find(interest.getName());
         auto it = find_if(intTable.begin(), intTable.end(),
                         [&](const inteAddField& entry) {
-                          return entry.name == interest.getName() && entry.nonce == interest.getNonce();
+                          return entry.nameId == nameId && entry.nonce == interest.getNonce();
                         });
+        // 上一跳没有该Interest的转发记录(如已被替换), 本节点不是转发者, 丢弃
+        if (it == intTable.end()) {
+            NFD_LOG_DEBUG("no forwarder record of Interest=" << interest << " from=" << ingress << ", drop");
+            this->setExpiryTimer(pitEntry, 0_ms);
+            return;
+        }
         if ( it->FIRD == node) {
             this->setNextHop(nexthops, interest, pitEntry, true, false);
             isRelay = true;
@@ -113,6 +128,7 @@ void
 PRFS::afterContentStoreHit(const shared_ptr<pit::Entry> &pitEntry,
                                 const FaceEndpoint &ingress, const Data &data)
 {
+    STRATEGY_PROFILE("PRFS");
     // NFD_LOG_DEBUG("afterContentStoreHit pitEntry=" << pitEntry->getName()
     //                                                << " in=" << ingress << " data=" << data.getName());
 
@@ -124,6 +140,7 @@ void
 PRFS::afterReceiveData(const shared_ptr<pit::Entry> &pitEntry,
 							const FaceEndpoint &ingress, const Data &data)
 {
+	STRATEGY_PROFILE("PRFS");
 	Interest interest = pitEntry->getInterest();
 	const auto& inface =  (pitEntry->getInRecords().begin()->getFace());
     // auto outface = pitEntry->getOutRecords().size();
@@ -196,7 +213,7 @@ PRFS::setNextHop(const fib::NextHopList& nexthops,
         // else{NFD_LOG_DEBUG("No Next FIRRD");}
     }
 
-    PRFS::inteAddField inteEntry(interest.getName(), interest.getNonce(), FIRD, FIRRD);
+    PRFS::inteAddField inteEntry(NameInterner::get().intern(interest.getName()), interest.getNonce(), FIRD, FIRRD);
     m_IntTable.push_back(inteEntry);
 }
 
@@ -225,27 +242,21 @@ double
 PRFS::calculateLET(ns3::Ptr<ns3::Node> sendNode, ns3::Ptr<ns3::Node> revNode) {
     ns3::Ptr<ns3::MobilityModel> mobility1 = sendNode->GetObject<ns3::MobilityModel>();
 	ns3::Ptr<ns3::MobilityModel> mobility2 = revNode->GetObject<ns3::MobilityModel>();
-    double m = mobility1->GetPosition().x - mobility2->GetPosition().x;
-    double n = mobility1->GetPosition().y - mobility2->GetPosition().y;
-    double p = mobility1->GetVelocity().x - mobility2->GetVelocity().x;
-    double q = mobility1->GetVelocity().y - mobility2->GetVelocity().y;
-    if (p==0 && q==0) {return 1e6;} //相对速度为0时，用1e6表示无限大
-    double let = (-(m*p+n*q)+sqrt((pow(p,2)+pow(q,2))*pow(m_Rth,2) - pow(n*p-m*q, 2)) ) / (pow(p,2)+pow(q,2));
-    return let;
+    return vanet::linkExpirationTime(mobility1->GetPosition(), mobility1->GetVelocity(),
+                                     mobility2->GetPosition(), mobility2->GetVelocity(), m_Rth);
 }
 
 double
 PRFS::caculateDR(ns3::Ptr<ns3::Node> sendNode, ns3::Ptr<ns3::Node> receiveNode) {
     double eculid = PRFS::calculateDistance(sendNode, receiveNode);
-    ns3::Ptr<ns3::MobilityModel> mobility = sendNode->GetObject<ns3::MobilityModel>();
-    ns3::Vector3D nodePos = mobility->GetPosition();
-    ns3::Ptr<ns3::MobilityModel> remoteMob = receiveNode->GetObject<ns3::MobilityModel>();
-    ns3::Vector3D remotePos = remoteMob->GetPosition();
-    // ns3::Vector3D direction = remoteMob->GetVelocity();
-    ns3::Vector3D direction = {1.0, 0.0, 0.0};
-    double angle = std::atan2(direction.x, direction.y) - std::atan2( remotePos.x-nodePos.x, remotePos.y-nodePos.y);
-    double dr = abs(eculid * cos(angle));
-    return dr;
+    ns3::Vector3D nodePos = sendNode->GetObject<ns3::MobilityModel>()->GetPosition();
+    ns3::Vector3D remotePos = receiveNode->GetObject<ns3::MobilityModel>()->GetPosition();
+    return vanet::roadDistance(nodePos, remotePos, eculid);
+}
+
+void
+PRFS::reportTableSizes(std::vector<TableSize>& tables) const {
+    tables.push_back(makeTableSize("PRFS::m_IntTable", m_IntTable));
 }
 
 }  // namespace fw
@@ -4,22 +4,25 @@
 #include "ns3/ndnSIM/NFD/daemon/fw/strategy.hpp"
 #include "ns3/ndnSIM/NFD/daemon/fw/process-nack-traits.hpp"
 #include "ns3/ndnSIM/NFD/daemon/fw/retx-suppression-exponential.hpp"
-#include "ns3/node-container.h"
+#include "node-registry.hpp"
+#include "strategy-parameters.hpp"
 #include "ns3/node.h"
 #include "ns3/vector.h"
+#include "name-interner.hpp"
+#include "table-size-reporter.hpp"
 namespace nfd
 {
 namespace fw
 {
 
-class PRFS : public Strategy, public ProcessNackTraits<PRFS>
+class PRFS : public Strategy, public TableSizeReporter, public ProcessNackTraits<PRFS>
 {
 struct  inteAddField {
-	const Name name;
+	NameInterner::Id nameId;
 	uint32_t nonce;
 	ns3::Ptr<ns3::Node> FIRD;
 	ns3::Ptr<ns3::Node> FIRRD;
-	inteAddField(const Name na, uint32_t n, ns3::Ptr<ns3::Node>fird, ns3::Ptr<ns3::Node> firrd) : name(na), nonce(n), FIRD(fird), FIRRD(firrd) {}
+	inteAddField(NameInterner::Id na, uint32_t n, ns3::Ptr<ns3::Node>fird, ns3::Ptr<ns3::Node> firrd) : nameId(na), nonce(n), FIRD(fird), FIRRD(firrd) {}
 };
 
 public:
@@ -28,6 +31,9 @@ public:
 	static const Name &
 	getStrategyName();
 
+	void
+	reportTableSizes(std::vector<TableSize>& tables) const override;
+
 	void
 	afterReceiveInterest(const FaceEndpoint &ingress, const Interest &interest,
 						 const shared_ptr<pit::Entry> &pitEntry) override;
@@ -83,7 +89,7 @@ public:
 private:
 	double m_Rth;
 	double m_LET_alpha;
-	ns3::NodeContainer m_nodes;
+	const ns3::ndn::NodeRegistry& m_nodes;
 	std::vector<PRFS::inteAddField> m_IntTable;
 	// std::map<uint32_t, std::vector<int>> m_hop;
 
@@ -0,0 +1,178 @@
+#include "profiling-simulator-impl.hpp"
+
+#include "ns3/log.h"
+#include "ns3/string.h"
+
+#include <cxxabi.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <typeinfo>
+#include <vector>
+
+NS_LOG_COMPONENT_DEFINE("ProfilingSimulatorImpl");
+
+namespace ns3 {
+
+NS_OBJECT_ENSURE_REGISTERED(ProfilingSimulatorImpl);
+
+namespace {
+
+std::string
+demangle(const char* name) {
+    int status = 0;
+    char* demangled = abi::__cxa_demangle(name, nullptr, nullptr, &status);
+    if (status != 0 || demangled == nullptr) {
+        return name;
+    }
+    std::string result(demangled);
+    std::free(demangled);
+    return result;
+}
+
+std::string
+csvString(const std::string& str) {
+    std::string result = "\"";
+    for (char c : str) {
+        if (c == '"') {
+            result += '"';
+        }
+        result += c;
+    }
+    return result + "\"";
+}
+
+}  // namespace
+
+TypeId ProfilingSimulatorImpl::GetTypeId() {
+    static TypeId tid = TypeId("ns3::ProfilingSimulatorImpl")
+                            .SetParent<DefaultSimulatorImpl>()
+                            .AddConstructor<ProfilingSimulatorImpl>()
+                            .AddAttribute("Output", "CSV file the per-origin event profile is written to",
+                                          StringValue("event-profile.csv"),
+                                          MakeStringAccessor(&ProfilingSimulatorImpl::m_output),
+                                          MakeStringChecker());
+    return tid;
+}
+
+ProfilingSimulatorImpl::ProfilingSimulatorImpl() : m_pending(0), m_peakPending(0) {}
+
+ProfilingSimulatorImpl::~ProfilingSimulatorImpl() {}
+
+EventId ProfilingSimulatorImpl::Schedule(const Time& delay, EventImpl* event) {
+    return DefaultSimulatorImpl::Schedule(delay, Wrap(event));
+}
+
+void ProfilingSimulatorImpl::ScheduleWithContext(uint32_t context, const Time& delay, EventImpl* event) {
+    DefaultSimulatorImpl::ScheduleWithContext(context, delay, Wrap(event));
+}
+
+EventId ProfilingSimulatorImpl::ScheduleNow(EventImpl* event) {
+    return DefaultSimulatorImpl::ScheduleNow(Wrap(event));
+}
+
+void ProfilingSimulatorImpl::Remove(const EventId& id) {
+    Discard(id);
+    DefaultSimulatorImpl::Remove(id);
+}
+
+void ProfilingSimulatorImpl::Cancel(const EventId& id) {
+    Discard(id);
+    DefaultSimulatorImpl::Cancel(id);
+}
+
+void ProfilingSimulatorImpl::DoDispose() {
+    Write();
+    DefaultSimulatorImpl::DoDispose();
+}
+
+EventImpl* ProfilingSimulatorImpl::Wrap(EventImpl* event) {
+    Origin& origin = m_origins[std::type_index(typeid(*event))];
+    if (origin.name.empty()) {
+        origin.name = Shorten(demangle(typeid(*event).name()));
+    }
+    origin.scheduled++;
+    origin.peakPending = std::max(origin.peakPending, ++origin.pending);
+    m_peakPending = std::max(m_peakPending, ++m_pending);
+    // the simulator takes over the reference the caller passed with event
+    return new ProfiledEvent(this, &origin, event);
+}
+
+void ProfilingSimulatorImpl::Discard(const EventId& id) {
+    if (id.PeekEventImpl() == nullptr || IsExpired(id)) {
+        return;
+    }
+    ProfiledEvent* event = dynamic_cast<ProfiledEvent*>(id.PeekEventImpl());
+    if (event == nullptr) {
+        return;
+    }
+    event->GetOrigin()->cancelled++;
+    event->GetOrigin()->pending--;
+    m_pending--;
+}
+
+std::string ProfilingSimulatorImpl::Shorten(const std::string& name) {
+    // "ns3::MakeEvent<void (Foo::*)(), Foo*>(void (Foo::*)(), Foo*)::EventMemberImpl0" keeps MakeEvent<...>
+    size_t open = name.find('<');
+    if (open == std::string::npos) {
+        return name;
+    }
+    int depth = 0;
+    for (size_t i = open; i < name.size(); i++) {
+        if (name[i] == '<') {
+            depth++;
+        } else if (name[i] == '>' && --depth == 0) {
+            return name.substr(0, i + 1);
+        }
+    }
+    return name;
+}
+
+void ProfilingSimulatorImpl::Write() const {
+    if (m_output.empty()) {
+        return;
+    }
+    std::ofstream os(m_output);
+    if (!os) {
+        NS_LOG_ERROR("cannot write event profile to " << m_output);
+        return;
+    }
+    std::vector<const Origin*> origins;
+    for (const auto& item : m_origins) {
+        origins.push_back(&item.second);
+    }
+    std::sort(origins.begin(), origins.end(),
+              [](const Origin* a, const Origin* b) { return a->totalNs > b->totalNs; });
+
+    os << "origin,scheduled,executed,cancelled,total_ms,mean_us,peak_pending\n";
+    for (const Origin* origin : origins) {
+        os << csvString(origin->name) << "," << origin->scheduled << "," << origin->executed << ","
+           << origin->cancelled << "," << origin->totalNs / 1e6 << ","
+           << (origin->executed > 0 ? origin->totalNs / 1e3 / origin->executed : 0) << ","
+           << origin->peakPending << "\n";
+    }
+    // peak of the whole queue, not the sum of the per-origin peaks
+    os << "\"all\",,,,,," << m_peakPending << "\n";
+    NS_LOG_INFO("event profile written to " << m_output);
+}
+
+ProfilingSimulatorImpl::ProfiledEvent::ProfiledEvent(ProfilingSimulatorImpl* impl, Origin* origin, EventImpl* event)
+    : m_impl(impl), m_origin(origin), m_event(event) {}
+
+ProfilingSimulatorImpl::ProfiledEvent::~ProfiledEvent() {
+    // only the wrapped event, the simulator and origin may be gone when the last EventId goes
+    m_event->Unref();
+}
+
+void ProfilingSimulatorImpl::ProfiledEvent::Notify() {
+    m_origin->pending--;
+    m_impl->m_pending--;
+    auto start = std::chrono::steady_clock::now();
+    m_event->Invoke();
+    m_origin->totalNs += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+    m_origin->executed++;
+}
+
+}  // namespace ns3
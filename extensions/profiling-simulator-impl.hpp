@@ -0,0 +1,101 @@
+#ifndef PROFILING_SIMULATOR_IMPL_HPP
+#define PROFILING_SIMULATOR_IMPL_HPP
+
+#include "ns3/default-simulator-impl.h"
+#include "ns3/event-impl.h"
+
+#include <cstdint>
+#include <string>
+#include <typeindex>
+#include <unordered_map>
+
+namespace ns3 {
+
+/**
+ * \brief DefaultSimulatorImpl that attributes every scheduled event to the
+ *        handler it was scheduled with
+ *
+ * Each event passed to Schedule, ScheduleWithContext or ScheduleNow is
+ * wrapped in a ProfiledEvent. The origin of an event is the demangled type
+ * of its EventImpl: MakeEvent creates one class per member function or
+ * function pointer type and bound object type, so e.g. DASB::doSendInterest,
+ * DASB::doSendData, YansWifiPhy receive events and the mobility course
+ * changes each get their own origin. Member functions of one class with the
+ * same signature (CCAF::distributeCLT and other void() members of CCAF)
+ * share an origin.
+ *
+ * Per origin it counts scheduled, executed and cancelled events, the total
+ * and mean wall time of their handlers and the peak number of pending
+ * events. The table, sorted by total handler time, is written to the Output
+ * attribute path when the simulator is destroyed. Select it with
+ * --SimulatorImplementationType=ns3::ProfilingSimulatorImpl, or add
+ * --profile-events to ./waf --run. Not usable with MPI, which needs the
+ * DistributedSimulatorImpl.
+ */
+class ProfilingSimulatorImpl : public DefaultSimulatorImpl {
+  public:
+    struct Origin {
+        std::string name;
+        uint64_t scheduled = 0;
+        uint64_t executed = 0;
+        uint64_t cancelled = 0;
+        uint64_t pending = 0;
+        uint64_t peakPending = 0;
+        uint64_t totalNs = 0;
+    };
+
+    static TypeId GetTypeId();
+
+    ProfilingSimulatorImpl();
+    virtual ~ProfilingSimulatorImpl();
+
+    virtual EventId Schedule(const Time& delay, EventImpl* event);
+    virtual void ScheduleWithContext(uint32_t context, const Time& delay, EventImpl* event);
+    virtual EventId ScheduleNow(EventImpl* event);
+    virtual void Remove(const EventId& id);
+    virtual void Cancel(const EventId& id);
+
+  protected:
+    virtual void DoDispose();
+
+  private:
+    /** \brief runs the wrapped event and charges its wall time to its origin
+     */
+    class ProfiledEvent : public EventImpl {
+      public:
+        ProfiledEvent(ProfilingSimulatorImpl* impl, Origin* origin, EventImpl* event);
+        virtual ~ProfiledEvent();
+
+        Origin* GetOrigin() const { return m_origin; }
+
+      protected:
+        virtual void Notify();
+
+      private:
+        ProfilingSimulatorImpl* m_impl;
+        Origin* m_origin;
+        EventImpl* m_event;
+    };
+
+    EventImpl* Wrap(EventImpl* event);
+
+    /** \brief books \p id as cancelled if it is a pending profiled event
+     */
+    void Discard(const EventId& id);
+
+    /** \brief \p name without the MakeEvent argument list and local class suffix
+     */
+    static std::string Shorten(const std::string& name);
+
+    void Write() const;
+
+  private:
+    std::string m_output;
+    std::unordered_map<std::type_index, Origin> m_origins;
+    uint64_t m_pending;
+    uint64_t m_peakPending;
+};
+
+}  // namespace ns3
+
+#endif  // PROFILING_SIMULATOR_IMPL_HPP
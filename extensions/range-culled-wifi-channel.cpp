@@ -0,0 +1,319 @@
+#include "range-culled-wifi-channel.hpp"
+
+#include "ns3/boolean.h"
+#include "ns3/constant-position-mobility-model.h"
+#include "ns3/double.h"
+#include "ns3/log.h"
+#include "ns3/net-device.h"
+#include "ns3/node.h"
+#include "ns3/simulator.h"
+#include "ns3/wifi-net-device.h"
+#include "ns3/wifi-utils.h"
+
+#include <algorithm>
+#include <cmath>
+
+NS_LOG_COMPONENT_DEFINE("RangeCulledWifiChannel");
+
+namespace ns3 {
+
+NS_OBJECT_ENSURE_REGISTERED(RangeCulledWifiChannel);
+NS_OBJECT_ENSURE_REGISTERED(RangeCulledYansWifiPhy);
+
+TypeId RangeCulledWifiChannel::GetTypeId() {
+    static TypeId tid =
+        TypeId("ns3::RangeCulledWifiChannel")
+            .SetParent<YansWifiChannel>()
+            .AddConstructor<RangeCulledWifiChannel>()
+            .AddAttribute("EnableCulling",
+                          "Only deliver frames to PHYs inside the cutoff distance",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&RangeCulledWifiChannel::m_enableCulling),
+                          MakeBooleanChecker())
+            .AddAttribute("MaxRange",
+                          "Cutoff distance in meters; 0 derives it from the loss "
+                          "model and the RX sensitivity",
+                          DoubleValue(0.0),
+                          MakeDoubleAccessor(&RangeCulledWifiChannel::m_maxRange),
+                          MakeDoubleChecker<double>(0.0))
+            .AddAttribute("MaxSpeed",
+                          "Upper bound on node speed (m/s), used to widen the "
+                          "lookup while the spatial index ages",
+                          DoubleValue(70.0),
+                          MakeDoubleAccessor(&RangeCulledWifiChannel::m_maxSpeed),
+                          MakeDoubleChecker<double>(0.0))
+            .AddAttribute("IndexRefreshInterval",
+                          "Maximum age of the spatial index",
+                          TimeValue(MilliSeconds(100)),
+                          MakeTimeAccessor(&RangeCulledWifiChannel::m_refreshInterval),
+                          MakeTimeChecker());
+    return tid;
+}
+
+RangeCulledWifiChannel::RangeCulledWifiChannel()
+    : m_enableCulling(false),
+      m_maxRange(0.0),
+      m_maxSpeed(70.0),
+      m_refreshInterval(MilliSeconds(100)),
+      m_minRxThresholdDbm(0.0),
+      m_warnedNoCulling(false),
+      m_cellSize(0.0),
+      m_indexValid(false) {
+    NS_LOG_FUNCTION(this);
+}
+
+RangeCulledWifiChannel::~RangeCulledWifiChannel() {
+    NS_LOG_FUNCTION(this);
+}
+
+void RangeCulledWifiChannel::DoDispose() {
+    m_phys.clear();
+    m_mobilities.clear();
+    m_grid.clear();
+    m_cutoffs.clear();
+    m_loss = 0;
+    m_delay = 0;
+    YansWifiChannel::DoDispose();
+}
+
+void RangeCulledWifiChannel::SetPropagationModels(
+    const Ptr<PropagationLossModel> loss, const Ptr<PropagationDelayModel> delay) {
+    YansWifiChannel::SetPropagationLossModel(loss);
+    YansWifiChannel::SetPropagationDelayModel(delay);
+    m_loss = loss;
+    m_delay = delay;
+    m_cutoffs.clear();
+}
+
+void RangeCulledWifiChannel::Send(Ptr<YansWifiPhy> sender,
+                                  Ptr<const Packet> packet, double txPowerDbm,
+                                  Time duration) const {
+    UpdatePhyList();
+    Ptr<MobilityModel> senderMobility = sender->GetMobility();
+    NS_ASSERT(senderMobility != 0);
+
+    double cutoff = m_enableCulling ? GetCutoffDistance(sender, txPowerDbm) : -1;
+    if (cutoff < 0) {
+        // same walk as YansWifiChannel::Send
+        for (uint32_t i = 0; i < m_phys.size(); i++) {
+            if (m_phys[i] != sender) {
+                Deliver(sender, senderMobility, i, packet, txPowerDbm, duration);
+            }
+        }
+        return;
+    }
+
+    if (!m_indexValid || Simulator::Now() - m_indexTime > m_refreshInterval) {
+        BuildIndex(cutoff);
+    }
+
+    // a receiver may have moved since the index was built
+    double radius =
+        cutoff + m_maxSpeed * (Simulator::Now() - m_indexTime).GetSeconds();
+    Vector pos = senderMobility->GetPosition();
+    int64_t xMin = std::floor((pos.x - radius) / m_cellSize);
+    int64_t xMax = std::floor((pos.x + radius) / m_cellSize);
+    int64_t yMin = std::floor((pos.y - radius) / m_cellSize);
+    int64_t yMax = std::floor((pos.y + radius) / m_cellSize);
+
+    std::vector<uint32_t> candidates;
+    if (static_cast<double>(xMax - xMin + 1) * (yMax - yMin + 1) > m_grid.size()) {
+        for (const auto& cell : m_grid) {
+            candidates.insert(candidates.end(), cell.second.begin(), cell.second.end());
+        }
+    } else {
+        for (int64_t cx = xMin; cx <= xMax; cx++) {
+            for (int64_t cy = yMin; cy <= yMax; cy++) {
+                auto it = m_grid.find(CellKey(cx, cy));
+                if (it != m_grid.end()) {
+                    candidates.insert(candidates.end(), it->second.begin(),
+                                      it->second.end());
+                }
+            }
+        }
+    }
+
+    // keep the scheduling order of YansWifiChannel, so that events with the
+    // same timestamp still run in the same order
+    std::sort(candidates.begin(), candidates.end());
+
+    uint32_t nCulled = m_phys.size() - 1;
+    for (uint32_t i : candidates) {
+        if (m_phys[i] == sender ||
+            senderMobility->GetDistanceFrom(m_mobilities[i]) > cutoff) {
+            continue;
+        }
+        Deliver(sender, senderMobility, i, packet, txPowerDbm, duration);
+        nCulled--;
+    }
+    NS_LOG_DEBUG("cutoff=" << cutoff << "m, culled " << nCulled << " of "
+                           << m_phys.size() - 1 << " receivers");
+}
+
+double RangeCulledWifiChannel::GetCutoffDistance(Ptr<YansWifiPhy> sender,
+                                                 double txPowerDbm) const {
+    if (m_maxRange > 0) {
+        return m_maxRange;
+    }
+    auto it = m_cutoffs.find(txPowerDbm);
+    if (it == m_cutoffs.end()) {
+        it = m_cutoffs.emplace(txPowerDbm, ComputeCutoff(txPowerDbm)).first;
+        NS_LOG_INFO("txPower=" << txPowerDbm << "dBm, cutoff=" << it->second << "m");
+
+        // 截止距离覆盖所有节点时裁剪不会省下任何事件
+        double extent = 0;
+        for (const auto& mobility : m_mobilities) {
+            extent = std::max(extent, mobility->GetDistanceFrom(m_mobilities.front()));
+        }
+        if (!m_warnedNoCulling && (it->second < 0 || it->second >= 2 * extent)) {
+            m_warnedNoCulling = true;
+            NS_LOG_WARN("txPower=" << txPowerDbm << "dBm, cutoff=" << it->second
+                        << "m covers every receiver, nothing is culled");
+        }
+    }
+    return it->second;
+}
+
+double RangeCulledWifiChannel::ComputeCutoff(double txPowerDbm) const {
+    UpdatePhyList();
+    if (m_loss == 0 || m_phys.empty()) {
+        return -1;
+    }
+
+    Ptr<ConstantPositionMobilityModel> a = CreateObject<ConstantPositionMobilityModel>();
+    Ptr<ConstantPositionMobilityModel> b = CreateObject<ConstantPositionMobilityModel>();
+    a->SetPosition(Vector(0, 0, 0));
+    auto isReachable = [&](double d) {
+        b->SetPosition(Vector(d, 0, 0));
+        return m_loss->CalcRxPower(txPowerDbm, a, b) >= m_minRxThresholdDbm;
+    };
+
+    // the loss model is assumed to be monotonic in distance
+    double hi = 1.0;
+    while (isReachable(hi)) {
+        hi *= 2;
+        if (hi > 1e8) {
+            return -1;
+        }
+    }
+    double lo = hi / 2;
+    for (int i = 0; i < 64 && hi - lo > 1e-6; i++) {
+        double mid = (lo + hi) / 2;
+        if (isReachable(mid)) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+    return hi;
+}
+
+void RangeCulledWifiChannel::UpdatePhyList() const {
+    if (m_phys.size() == GetNDevices()) {
+        return;
+    }
+    m_phys.clear();
+    m_mobilities.clear();
+    m_minRxThresholdDbm = std::numeric_limits<double>::infinity();
+    for (uint32_t i = 0; i < GetNDevices(); i++) {
+        Ptr<WifiNetDevice> device = DynamicCast<WifiNetDevice>(GetDevice(i));
+        NS_ASSERT(device != 0);
+        Ptr<YansWifiPhy> phy = DynamicCast<YansWifiPhy>(device->GetPhy());
+        NS_ASSERT(phy != 0);
+        m_phys.push_back(phy);
+        m_mobilities.push_back(phy->GetMobility()->GetObject<MobilityModel>());
+        m_minRxThresholdDbm = std::min(m_minRxThresholdDbm,
+                                       phy->GetRxSensitivity() - phy->GetRxGain());
+    }
+    m_cutoffs.clear();
+    m_indexValid = false;
+}
+
+void RangeCulledWifiChannel::BuildIndex(double cutoff) const {
+    m_grid.clear();
+    m_cellSize = cutoff;
+    m_indexTime = Simulator::Now();
+    m_indexValid = true;
+    for (uint32_t i = 0; i < m_mobilities.size(); i++) {
+        Vector pos = m_mobilities[i]->GetPosition();
+        int64_t cx = std::floor(pos.x / m_cellSize);
+        int64_t cy = std::floor(pos.y / m_cellSize);
+        m_grid[CellKey(cx, cy)].push_back(i);
+    }
+}
+
+void RangeCulledWifiChannel::Deliver(Ptr<YansWifiPhy> sender,
+                                     Ptr<MobilityModel> senderMobility,
+                                     uint32_t index, Ptr<const Packet> packet,
+                                     double txPowerDbm, Time duration) const {
+    Ptr<YansWifiPhy> receiver = m_phys[index];
+    // For now don't account for inter channel interference nor channel bonding
+    if (receiver->GetChannelNumber() != sender->GetChannelNumber()) {
+        return;
+    }
+
+    Ptr<MobilityModel> receiverMobility = m_mobilities[index];
+    Time delay = m_delay->GetDelay(senderMobility, receiverMobility);
+    double rxPowerDbm =
+        m_loss->CalcRxPower(txPowerDbm, senderMobility, receiverMobility);
+    NS_LOG_DEBUG("propagation: txPower=" << txPowerDbm << "dbm, rxPower=" << rxPowerDbm
+                 << "dbm, distance=" << senderMobility->GetDistanceFrom(receiverMobility)
+                 << "m, delay=" << delay);
+    Ptr<Packet> copy = packet->Copy();
+    Ptr<NetDevice> dstNetDevice = receiver->GetDevice();
+    uint32_t dstNode =
+        dstNetDevice == 0 ? 0xffffffff : dstNetDevice->GetNode()->GetId();
+
+    Simulator::ScheduleWithContext(dstNode, delay, &RangeCulledWifiChannel::Receive,
+                                   receiver, copy, rxPowerDbm, duration);
+}
+
+void RangeCulledWifiChannel::Receive(Ptr<YansWifiPhy> phy, Ptr<Packet> packet,
+                                     double rxPowerDbm, Time duration) {
+    NS_LOG_FUNCTION(phy << packet << rxPowerDbm << duration.GetSeconds());
+    // Do no further processing if signal is too weak
+    if ((rxPowerDbm + phy->GetRxGain()) < phy->GetRxSensitivity()) {
+        NS_LOG_INFO("Received signal too weak to process: " << rxPowerDbm << " dBm");
+        return;
+    }
+    phy->StartReceivePreamble(packet, DbmToW(rxPowerDbm + phy->GetRxGain()), duration);
+}
+
+int64_t RangeCulledWifiChannel::CellKey(int64_t cx, int64_t cy) {
+    return (cx << 32) ^ (cy & 0xffffffff);
+}
+
+TypeId RangeCulledYansWifiPhy::GetTypeId() {
+    static TypeId tid = TypeId("ns3::RangeCulledYansWifiPhy")
+                            .SetParent<YansWifiPhy>()
+                            .AddConstructor<RangeCulledYansWifiPhy>();
+    return tid;
+}
+
+RangeCulledYansWifiPhy::RangeCulledYansWifiPhy() {
+    NS_LOG_FUNCTION(this);
+}
+
+RangeCulledYansWifiPhy::~RangeCulledYansWifiPhy() {
+    NS_LOG_FUNCTION(this);
+}
+
+void RangeCulledYansWifiPhy::StartTx(Ptr<Packet> packet, WifiTxVector txVector,
+                                     Time txDuration) {
+    Ptr<RangeCulledWifiChannel> channel =
+        DynamicCast<RangeCulledWifiChannel>(GetChannel());
+    if (channel == 0) {
+        YansWifiPhy::StartTx(packet, txVector, txDuration);
+        return;
+    }
+    NS_LOG_DEBUG("Start transmission: signal power before antenna gain="
+                 << GetPowerDbm(txVector.GetTxPowerLevel()) << "dBm");
+    channel->Send(this, packet, GetPowerDbm(txVector.GetTxPowerLevel()) + GetTxGain(),
+                  txDuration);
+}
+
+RangeCulledYansWifiPhyHelper::RangeCulledYansWifiPhyHelper() {
+    m_phy.SetTypeId("ns3::RangeCulledYansWifiPhy");
+}
+
+}  // namespace ns3
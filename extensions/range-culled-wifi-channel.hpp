@@ -0,0 +1,141 @@
+#ifndef RANGE_CULLED_WIFI_CHANNEL_HPP
+#define RANGE_CULLED_WIFI_CHANNEL_HPP
+
+#include "ns3/mobility-model.h"
+#include "ns3/nstime.h"
+#include "ns3/propagation-delay-model.h"
+#include "ns3/propagation-loss-model.h"
+#include "ns3/yans-wifi-channel.h"
+#include "ns3/yans-wifi-helper.h"
+#include "ns3/yans-wifi-phy.h"
+
+#include <limits>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \brief YansWifiChannel that only delivers a frame to PHYs inside the
+ *        reception cutoff of the sender.
+ *
+ * YansWifiChannel::Send schedules one Receive event per PHY on the channel,
+ * and YansWifiChannel::Receive then drops every event whose power is below the
+ * receiver's RX sensitivity. This channel finds the receivers through a
+ * uniform grid over the node positions instead, and never schedules the
+ * events that would have been dropped. The cutoff is derived by inverting the
+ * (deterministic, monotonic) propagation loss model against the RX sensitivity,
+ * so the set and the order of delivered frames are the same as with
+ * YansWifiChannel.
+ *
+ * Culling is off unless the EnableCulling attribute is set, and then every
+ * PHY on the channel is visited exactly as YansWifiChannel does. It only pays
+ * off when the cutoff is small against the road, and with the scenarios'
+ * radio it never is. Their loss model (40 dB at 1 m, exponent 1) at 0 dBm
+ * gives 0 - 40 - 10 log10(d) dBm, so the cutoff is about 1260 km against the
+ * -101 dBm RX sensitivity, and still about 160 km against the roughly
+ * -92 dBm a 6 Mbps OFDM frame needs to decode (-174 dBm/Hz over 10 MHz, 7 dB
+ * noise figure, 5 dB SNR). Every receiver of the traces is inside either
+ * cutoff, so no event is saved. Lowering the threshold further, or setting
+ * MaxRange below it, drops frames the PHY would have decoded and changes the
+ * results. Culling is therefore deferred until the scenarios use a realistic
+ * exponent (at 2.0 the same -92 dBm gives about 400 m). GetCutoffDistance
+ * warns once per channel when a derived cutoff cannot cull anything.
+ *
+ * YansWifiChannel::Send is not virtual, so the PHYs must be
+ * RangeCulledYansWifiPhy (see RangeCulledYansWifiPhyHelper) for the culled
+ * send path to be used. For the same reason the models are set with
+ * SetPropagationModels rather than the base class setters, which the channel
+ * could not see.
+ */
+class RangeCulledWifiChannel : public YansWifiChannel {
+  public:
+    static TypeId GetTypeId();
+
+    RangeCulledWifiChannel();
+    virtual ~RangeCulledWifiChannel();
+
+    /** \brief set the loss and delay models of this channel and of the
+     *         YansWifiChannel base
+     */
+    void SetPropagationModels(const Ptr<PropagationLossModel> loss,
+                              const Ptr<PropagationDelayModel> delay);
+
+    /** \brief send a frame to every PHY whose received power can reach the
+     *         RX sensitivity
+     */
+    void Send(Ptr<YansWifiPhy> sender, Ptr<const Packet> packet,
+              double txPowerDbm, Time duration) const;
+
+    /** \brief distance beyond which a frame sent by \p sender at
+     *         \p txPowerDbm is below the RX sensitivity of every receiver
+     *  \return a negative value if no finite cutoff exists
+     */
+    double GetCutoffDistance(Ptr<YansWifiPhy> sender, double txPowerDbm) const;
+
+  protected:
+    virtual void DoDispose();
+
+  private:
+    static void Receive(Ptr<YansWifiPhy> receiver, Ptr<Packet> packet,
+                        double rxPowerDbm, Time duration);
+
+    void UpdatePhyList() const;
+
+    void BuildIndex(double cutoff) const;
+
+    double ComputeCutoff(double txPowerDbm) const;
+
+    void Deliver(Ptr<YansWifiPhy> sender, Ptr<MobilityModel> senderMobility,
+                 uint32_t index, Ptr<const Packet> packet, double txPowerDbm,
+                 Time duration) const;
+
+    static int64_t CellKey(int64_t cx, int64_t cy);
+
+  private:
+    Ptr<PropagationLossModel> m_loss;
+    Ptr<PropagationDelayModel> m_delay;
+
+    bool m_enableCulling;
+    double m_maxRange;         ///< manual cutoff, <= 0 means derive it
+    double m_maxSpeed;         ///< bound on node speed (m/s)
+    Time m_refreshInterval;    ///< maximum age of the grid
+
+    mutable std::vector<Ptr<YansWifiPhy>> m_phys;
+    mutable std::vector<Ptr<MobilityModel>> m_mobilities;
+    mutable double m_minRxThresholdDbm;  ///< min(RxSensitivity - RxGain)
+
+    mutable std::map<double, double> m_cutoffs;  ///< txPowerDbm -> cutoff
+    mutable bool m_warnedNoCulling;
+    mutable double m_cellSize;
+    mutable Time m_indexTime;
+    mutable bool m_indexValid;
+    mutable std::unordered_map<int64_t, std::vector<uint32_t>> m_grid;
+};
+
+/**
+ * \brief YansWifiPhy whose transmissions go through
+ *        RangeCulledWifiChannel::Send
+ */
+class RangeCulledYansWifiPhy : public YansWifiPhy {
+  public:
+    static TypeId GetTypeId();
+
+    RangeCulledYansWifiPhy();
+    virtual ~RangeCulledYansWifiPhy();
+
+    void StartTx(Ptr<Packet> packet, WifiTxVector txVector, Time txDuration);
+};
+
+/**
+ * \brief YansWifiPhyHelper that installs RangeCulledYansWifiPhy
+ */
+class RangeCulledYansWifiPhyHelper : public YansWifiPhyHelper {
+  public:
+    RangeCulledYansWifiPhyHelper();
+};
+
+}  // namespace ns3
+
+#endif  // RANGE_CULLED_WIFI_CHANNEL_HPP
@@ -0,0 +1,193 @@
+#include "run-report.hpp"
+
+#include "airtime-report.hpp"
+#include "decision-cache.hpp"
+#include "ndn-beacon-app.hpp"
+#include "strategy-parameters.hpp"
+#include "strategy-profiler.hpp"
+
+#include "ns3/log.h"
+#include "ns3/node-list.h"
+#include "ns3/simulator.h"
+
+#include <sys/resource.h>
+
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+NS_LOG_COMPONENT_DEFINE("RunReport");
+
+namespace ns3 {
+
+namespace {
+
+std::string
+jsonString(const std::string& str) {
+    std::ostringstream os;
+    os << '"';
+    for (char c : str) {
+        switch (c) {
+        case '"':
+            os << "\\\"";
+            break;
+        case '\\':
+            os << "\\\\";
+            break;
+        case '\n':
+            os << "\\n";
+            break;
+        default:
+            os << c;
+        }
+    }
+    os << '"';
+    return os.str();
+}
+
+}  // namespace
+
+RunReport::RunReport(const std::string& path) : m_path(path), m_eventsAtStart(0) {}
+
+void RunReport::SetParameter(const std::string& key, const std::string& value) {
+    m_parameters.emplace_back(key, jsonString(value));
+}
+
+void RunReport::SetParameter(const std::string& key, double value) {
+    std::ostringstream os;
+    os << std::setprecision(10) << value;
+    m_parameters.emplace_back(key, os.str());
+}
+
+void RunReport::SetProfileOutput(const std::string& path, bool tsc) {
+    m_profilePath = path;
+    m_tsc = tsc;
+}
+
+void RunReport::Start() {
+    if (!IsEnabled()) {
+        return;
+    }
+    using Clock = ::nfd::fw::StrategyProfiler::Clock;
+    if (!::nfd::fw::StrategyProfiler::setClock(m_tsc ? Clock::TSC : Clock::STEADY)) {
+        NS_LOG_WARN("RDTSC is not available, timing callbacks with steady_clock");
+    }
+    ::nfd::fw::StrategyProfiler::reset();
+    ::nfd::fw::StrategyProfiler::enable();
+    m_eventsAtStart = Simulator::GetEventCount();
+    m_wallStart = std::chrono::steady_clock::now();
+}
+
+void RunReport::Finish() {
+    if (!IsEnabled()) {
+        return;
+    }
+    double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - m_wallStart).count();
+    uint64_t events = Simulator::GetEventCount() - m_eventsAtStart;
+    ::nfd::fw::StrategyProfiler::enable(false);
+
+    if (!m_profilePath.empty()) {
+        WriteProfile();
+    }
+    if (m_path.empty()) {
+        return;
+    }
+
+    std::ofstream os(m_path);
+    if (!os) {
+        NS_LOG_ERROR("cannot write run report to " << m_path);
+        return;
+    }
+    os << std::setprecision(10);
+    os << "{\n  \"parameters\": {";
+    for (size_t i = 0; i < m_parameters.size(); i++) {
+        os << (i == 0 ? "" : ",") << "\n    " << jsonString(m_parameters[i].first) << ": "
+           << m_parameters[i].second;
+    }
+    os << "\n  },\n";
+    // thresholds the strategies actually used, including the defaults of keys not given
+    const auto& strategyValues = ::nfd::fw::StrategyParameters::getValues();
+    os << "  \"strategy_parameters\": {";
+    for (auto strategy = strategyValues.begin(); strategy != strategyValues.end(); ++strategy) {
+        os << (strategy == strategyValues.begin() ? "" : ",") << "\n    " << jsonString(strategy->first)
+           << ": {";
+        for (auto value = strategy->second.begin(); value != strategy->second.end(); ++value) {
+            os << (value == strategy->second.begin() ? "" : ", ") << jsonString(value->first) << ": "
+               << value->second;
+        }
+        os << "}";
+    }
+    os << "\n  },\n";
+    os << "  \"wall_clock_s\": " << wall << ",\n";
+    os << "  \"simulated_s\": " << Simulator::Now().GetSeconds() << ",\n";
+    os << "  \"events\": " << events << ",\n";
+    os << "  \"events_per_s\": " << (wall > 0 ? events / wall : 0) << ",\n";
+    os << "  \"peak_rss_kb\": " << GetPeakRss() << ",\n";
+    const auto& decisions = ::nfd::fw::DecisionCache::getCounters();
+    uint64_t lookups = decisions.hits + decisions.misses;
+    if (lookups > 0) {
+        os << "  \"decision_cache\": {\"hits\": " << decisions.hits << ", \"misses\": " << decisions.misses
+           << ", \"hit_rate\": " << double(decisions.hits) / lookups << ", \"verified\": " << decisions.verified
+           << ", \"diverged\": " << decisions.diverged << ", \"divergence_rate\": "
+           << (decisions.verified > 0 ? double(decisions.diverged) / decisions.verified : 0) << "},\n";
+    }
+    const auto& beacons = ndn::BeaconApp::GetCounters();
+    if (beacons.sent > 0) {
+        // share of each node's simulated time spent transmitting beacons
+        double nodeSeconds = NodeList::GetNNodes() * Simulator::Now().GetSeconds();
+        os << "  \"beacons\": {\"sent\": " << beacons.sent << ", \"received\": " << beacons.received
+           << ", \"bytes\": " << beacons.bytes << ", \"airtime_s\": " << beacons.airtime
+           << ", \"airtime_share\": " << (nodeSeconds > 0 ? beacons.airtime / nodeSeconds : 0) << "},\n";
+    }
+    const auto& airtime = AirtimeReport::GetTotals();
+    if (airtime.time > 0) {
+        // shares of the PHY time reported by all 802.11p devices
+        os << "  \"airtime\": {\"tx_share\": " << airtime.tx / airtime.time << ", \"rx_share\": "
+           << airtime.rx / airtime.time << ", \"cca_busy_share\": " << airtime.ccaBusy / airtime.time
+           << ", \"collisions\": " << airtime.collisions << ", \"tx_s\": {";
+        for (int type = 0; type < AirtimeReport::N_PACKET_TYPES; type++) {
+            os << (type == 0 ? "" : ", ")
+               << jsonString(AirtimeReport::GetPacketTypeName(AirtimeReport::PacketType(type))) << ": "
+               << airtime.txByType[type];
+        }
+        os << "}},\n";
+    }
+    os << "  \"callbacks\": [";
+    auto records = ::nfd::fw::StrategyProfiler::getRecords();
+    for (size_t i = 0; i < records.size(); i++) {
+        const auto& r = records[i];
+        os << (i == 0 ? "" : ",") << "\n    {\"strategy\": " << jsonString(r.strategy)
+           << ", \"trigger\": " << jsonString(r.trigger) << ", \"calls\": " << r.calls
+           << ", \"nested_calls\": " << r.nestedCalls
+           << ", \"total_s\": " << r.totalNs / 1e9
+           << ", \"mean_us\": " << (r.calls > 0 ? r.totalNs / 1e3 / r.calls : 0)
+           << ", \"p50_us\": " << r.histogram.getPercentile(0.5) / 1e3
+           << ", \"p99_us\": " << r.histogram.getPercentile(0.99) / 1e3
+           << ", \"max_us\": " << r.maxNs / 1e3 << "}";
+    }
+    os << "\n  ]\n}\n";
+    NS_LOG_INFO("run report written to " << m_path);
+}
+
+void RunReport::WriteProfile() const {
+    std::ofstream os(m_profilePath);
+    std::ofstream nodes(m_profilePath + ".nodes.csv");
+    if (!os || !nodes) {
+        NS_LOG_ERROR("cannot write callback profile to " << m_profilePath);
+        return;
+    }
+    ::nfd::fw::StrategyProfiler::printPercentiles(os);
+    ::nfd::fw::StrategyProfiler::printNodePercentiles(nodes);
+    NS_LOG_INFO("callback profile written to " << m_profilePath);
+}
+
+uint64_t RunReport::GetPeakRss() {
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+    // ru_maxrss is in KiB on Linux
+    return usage.ru_maxrss;
+}
+
+}  // namespace ns3
@@ -0,0 +1,65 @@
+#ifndef RUN_REPORT_HPP
+#define RUN_REPORT_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \brief machine-readable performance report of one simulation run
+ *
+ * Records wall-clock time, simulator events processed, events per second,
+ * peak RSS, the time spent inside each strategy callback and, when enabled,
+ * the hit and divergence rates of the selectFIB decision cache, the
+ * count and estimated airtime of beacons and the channel time measured by
+ * AirtimeReport and the strategy thresholds read by StrategyParameters,
+ * and writes them as JSON. Nothing is measured or written when neither the report path nor
+ * a profile output is set.
+ */
+class RunReport {
+  public:
+    explicit RunReport(const std::string& path);
+
+    bool IsEnabled() const { return !m_path.empty() || !m_profilePath.empty(); }
+
+    /** \brief also write per-callback latency percentiles to \p path and the
+     *         per-node histograms to \p path + ".nodes.csv"
+     *  \param tsc time callbacks with RDTSC instead of steady_clock
+     */
+    void SetProfileOutput(const std::string& path, bool tsc);
+
+    void SetParameter(const std::string& key, const std::string& value);
+
+    void SetParameter(const std::string& key, double value);
+
+    /** \brief call right before Simulator::Run()
+     */
+    void Start();
+
+    /** \brief call right after Simulator::Run(), writes the report
+     */
+    void Finish();
+
+    /** \return peak resident set size of this process in KiB
+     */
+    static uint64_t GetPeakRss();
+
+  private:
+    void WriteProfile() const;
+
+  private:
+    std::string m_path;
+    std::string m_profilePath;
+    bool m_tsc = false;
+    std::vector<std::pair<std::string, std::string>> m_parameters;  ///< key -> JSON value
+    std::chrono::steady_clock::time_point m_wallStart;
+    uint64_t m_eventsAtStart;
+};
+
+}  // namespace ns3
+
+#endif  // RUN_REPORT_HPP
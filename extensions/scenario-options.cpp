@@ -0,0 +1,52 @@
+#include "scenario-options.hpp"
+
+#include <sstream>
+
+namespace ns3 {
+
+void ScenarioOptions::AddValues(CommandLine& cmd) {
+    cmd.AddValue("num", "Description for number of nodes parameter", num);
+    cmd.AddValue("consumers", "List of consumer nodes", m_consumersList);
+    cmd.AddValue("producers", "List of producer nodes", m_producersList);
+    cmd.AddValue("popularity", "Popularity of Zipf", popularity);
+    cmd.AddValue("rate", "Description for request rate  parameter", rate);
+    cmd.AddValue("time", "Description for request rate  parameter", time);
+    cmd.AddValue("trace", "Description for mobility trace  parameter", trace);
+    cmd.AddValue("culling", "Only deliver frames inside the reception cutoff, see ns3::RangeCulledWifiChannel::MaxRange", culling);
+    cmd.AddValue("fast", "Use the unit-disk link model instead of 802.11p", fast);
+    cmd.AddValue("strategyParams", "Strategy thresholds as key~value components, e.g. pth~0.9/t~2", strategyParams);
+    cmd.AddValue("steady", "Window in seconds for steady-state/collapse detection that may end the run before --time, 0 disables", steady);
+    cmd.AddValue("memoryInterval", "Seconds between memory samples", memoryInterval);
+    cmd.AddValue("airtimeInterval", "Seconds between airtime rows", airtimeInterval);
+    cmd.AddValue("hopSampling", "Trace one Interest/Data in this many for --hops, by name hash", hopSampling);
+}
+
+void ScenarioOptions::AddOutputValues(CommandLine& cmd) {
+    cmd.AddValue("delay_log", "Description for delay log parameter", delayLog);
+    cmd.AddValue("report", "Write a JSON performance report to this file", report);
+    cmd.AddValue("profile", "Write per-callback latency percentiles to this file, per-node histograms to <file>.nodes.csv", profile);
+    cmd.AddValue("tsc", "Time strategy callbacks with RDTSC instead of steady_clock", tsc);
+    cmd.AddValue("memory", "Write per-subsystem memory samples to this file, peaks to <file>.peak.csv", memory);
+    cmd.AddValue("airtime", "Write per-region airtime every interval to this file, per-node and per-region totals to <file>.nodes.csv and <file>.regions.csv", airtime);
+    cmd.AddValue("hops", "Write the per-hop latency breakdown (strategy, defer, mac, air, retx_wait) of sampled packets to this file", hops);
+}
+
+void ScenarioOptions::Parse(CommandLine& cmd, int argc, char* argv[]) {
+    cmd.Parse(argc, argv);
+    consumers = ParseList(m_consumersList);
+    producers = ParseList(m_producersList);
+}
+
+std::vector<int> ScenarioOptions::ParseList(const std::string& str) {
+    std::vector<int> result;
+    std::istringstream ss(str);
+    char delimiter;
+    int number;
+    while (ss >> number) {
+        result.push_back(number);
+        ss >> delimiter;  // the comma
+    }
+    return result;
+}
+
+}  // namespace ns3
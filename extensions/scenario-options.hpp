@@ -0,0 +1,82 @@
+#ifndef SCENARIO_OPTIONS_HPP
+#define SCENARIO_OPTIONS_HPP
+
+#include "ns3/command-line.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \brief command-line options of the scenarios
+ *
+ * Every scenario fills one ScenarioOptions and passes it to its ns3::main,
+ * so an option is declared, defaulted and registered here once instead of
+ * in each scenario file. AddValues registers the options all scenarios
+ * understand; options only some of them have (mpi, strategy, size,
+ * decisionCache, beaconInterval) are fields as well, and the scenario
+ * registers them itself with the help text that fits it.
+ */
+struct ScenarioOptions {
+    // workload
+    uint32_t num = 0;
+    std::vector<int> consumers;
+    std::vector<int> producers;
+    double popularity = 0;
+    double rate = 0;
+    double time = 0;
+    std::string trace;
+
+    // link layer
+    bool culling = false;
+    bool fast = false;
+    bool mpi = false;
+
+    // strategy
+    std::string strategy;
+    std::string strategyParams;
+    int size = 20;
+    bool decisionCache = false;
+    double beaconInterval = 0;
+
+    // outputs, each disabled while its path is empty
+    std::string delayLog;
+    std::string report;
+    std::string profile;
+    bool tsc = false;
+    std::string memory;
+    double memoryInterval = 1.0;
+    std::string airtime;
+    double airtimeInterval = 1.0;
+    std::string hops;
+    uint32_t hopSampling = 16;
+    double steady = 0;
+
+    /** \brief register the workload, link, strategyParams, steady and
+     *         sampling interval options with \p cmd
+     */
+    void AddValues(CommandLine& cmd);
+
+    /** \brief register the output file options (delay_log, report,
+     *         profile, tsc, memory, airtime, hops) with \p cmd
+     */
+    void AddOutputValues(CommandLine& cmd);
+
+    /** \brief parse the command line and the consumer/producer lists
+     */
+    void Parse(CommandLine& cmd, int argc, char* argv[]);
+
+    /** \brief "1,2,3" as a list of node ids
+     */
+    static std::vector<int> ParseList(const std::string& str);
+
+  private:
+    std::string m_consumersList;
+    std::string m_producersList;
+};
+
+}  // namespace ns3
+
+#endif  // SCENARIO_OPTIONS_HPP
@@ -0,0 +1,113 @@
+#include "steady-state-monitor.hpp"
+
+#include "ns3/log.h"
+#include "ns3/node-list.h"
+#include "ns3/node.h"
+#include "ns3/simulator.h"
+#include "ns3/ndnSIM/apps/ndn-consumer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+NS_LOG_COMPONENT_DEFINE("SteadyStateMonitor");
+
+namespace ns3 {
+
+SteadyStateMonitor::SteadyStateMonitor(double rate, Time window)
+    : m_rate(rate), m_window(window), m_windows(1), m_reason(TIME) {}
+
+void SteadyStateMonitor::Start() {
+    if (!IsEnabled()) {
+        return;
+    }
+    for (uint32_t i = 0; i < NodeList::GetNNodes(); i++) {
+        Ptr<Node> node = NodeList::GetNode(i);
+        for (uint32_t j = 0; j < node->GetNApplications(); j++) {
+            Ptr<ndn::Consumer> consumer = DynamicCast<ndn::Consumer>(node->GetApplication(j));
+            if (consumer != nullptr) {
+                consumer->TraceConnectWithoutContext("LastRetransmittedInterestDataDelay",
+                                                     MakeCallback(&SteadyStateMonitor::OnDelay, this));
+            }
+        }
+    }
+    m_event = Simulator::Schedule(m_window, &SteadyStateMonitor::DoCheck, this);
+    std::cout << "Warm-up until " << m_window.GetSeconds() << " s" << std::endl;
+}
+
+void SteadyStateMonitor::Finish() {
+    if (!IsEnabled()) {
+        return;
+    }
+    Simulator::Cancel(m_event);
+    if (m_reason != TIME) {
+        std::cout << "Stopped at " << Simulator::Now().GetSeconds() << " s: " << GetStopReason() << std::endl;
+    }
+}
+
+std::string SteadyStateMonitor::GetStopReason() const {
+    switch (m_reason) {
+    case STEADY:
+        return "steady";
+    case COLLAPSE:
+        return "collapse";
+    default:
+        return "time";
+    }
+}
+
+void SteadyStateMonitor::OnDelay(Ptr<ndn::App> app, uint32_t seqno, Time delay, int32_t hopCount) {
+    Window& window = m_windows.back();
+    window.satisfied++;
+    window.delaySum += delay.GetSeconds();
+}
+
+void SteadyStateMonitor::Average(size_t first, double& isr, double& isd, uint32_t& satisfied) const {
+    satisfied = 0;
+    double delaySum = 0;
+    for (size_t i = first; i < first + WINDOWS; i++) {
+        satisfied += m_windows[i].satisfied;
+        delaySum += m_windows[i].delaySum;
+    }
+    isr = satisfied / (m_rate * m_window.GetSeconds() * WINDOWS);
+    isd = satisfied > 0 ? delaySum / satisfied : 0;
+}
+
+void SteadyStateMonitor::DoCheck() {
+    // m_windows[0] is the warm-up window, the last one has just closed
+    size_t closed = m_windows.size() - 1;
+    m_windows.emplace_back();
+
+    if (closed >= WINDOWS) {
+        bool collapsed = true;
+        for (size_t i = closed + 1 - WINDOWS; i <= closed; i++) {
+            double isr = m_windows[i].satisfied / (m_rate * m_window.GetSeconds());
+            collapsed = collapsed && isr < COLLAPSE_ISR;
+        }
+        if (collapsed) {
+            m_reason = COLLAPSE;
+        }
+    }
+    if (m_reason == TIME && closed >= 2 * WINDOWS) {
+        double isrBefore, isdBefore, isrLast, isdLast;
+        uint32_t before, last;
+        Average(closed + 1 - 2 * WINDOWS, isrBefore, isdBefore, before);
+        Average(closed + 1 - WINDOWS, isrLast, isdLast, last);
+        bool isrSettled = std::abs(isrLast - isrBefore) <= std::max(TOLERANCE * isrBefore, ISR_FLOOR);
+        bool isdSettled = before > 0 && last > 0 &&
+                          std::abs(isdLast - isdBefore) <= std::max(TOLERANCE * isdBefore, ISD_FLOOR);
+        NS_LOG_DEBUG("ISR " << isrBefore << " -> " << isrLast << ", ISD " << isdBefore << " -> " << isdLast);
+        if (isrSettled && isdSettled) {
+            m_reason = STEADY;
+        }
+    }
+
+    if (m_reason != TIME) {
+        NS_LOG_INFO("stopping at " << Simulator::Now().GetSeconds() << " s: " << GetStopReason());
+        Simulator::Stop();
+        return;
+    }
+    m_event = Simulator::Schedule(m_window, &SteadyStateMonitor::DoCheck, this);
+}
+
+}  // namespace ns3
@@ -0,0 +1,93 @@
+#ifndef STEADY_STATE_MONITOR_HPP
+#define STEADY_STATE_MONITOR_HPP
+
+#include "ns3/event-id.h"
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ns3 {
+
+namespace ndn {
+class App;
+}
+
+/**
+ * \brief ends a run early once the consumers' ISR and ISD have settled or
+ *        the run has collapsed
+ *
+ * Listens to the LastRetransmittedInterestDataDelay trace of every
+ * ndn::Consumer, the sample ndn::AppDelayTracer logs as LastDelay, and
+ * keeps the satisfied Interests and their mean delay per window. The first
+ * window is skipped as warm-up. Afterwards:
+ *
+ * - steady state: the mean ISR and ISD of the last WINDOWS windows differ
+ *   from those of the WINDOWS windows before by at most TOLERANCE
+ *   (relative), or by ISR_FLOOR / ISD_FLOOR in absolute terms;
+ * - collapse: the ISR of each of the last WINDOWS windows is below
+ *   COLLAPSE_ISR.
+ *
+ * Either one calls Simulator::Stop(). Start() prints "Warm-up until <t> s"
+ * and Finish() prints "Stopped at <t> s: <reason>"; calMetric in
+ * test/metrics.py drops the packets of the warm-up window and normalizes
+ * ISR by the simulated time after it, and FIP/FDP by that time scaled to
+ * the configured --time. Nothing is monitored when the window is not
+ * positive.
+ */
+class SteadyStateMonitor {
+  public:
+    static const uint32_t WINDOWS = 3;
+    static constexpr double TOLERANCE = 0.05;
+    static constexpr double ISR_FLOOR = 0.01;
+    static constexpr double ISD_FLOOR = 0.001;  ///< seconds
+    static constexpr double COLLAPSE_ISR = 0.02;
+
+    /** \param rate Interests per second issued by all consumers together
+     *  \param window length of one measurement window
+     */
+    SteadyStateMonitor(double rate, Time window);
+
+    bool IsEnabled() const { return m_window.IsStrictlyPositive() && m_rate > 0; }
+
+    /** \brief call right before Simulator::Run(), after the consumers are installed
+     */
+    void Start();
+
+    /** \brief call right after Simulator::Run(), prints the stop line when the run ended early
+     */
+    void Finish();
+
+    /** \return "steady", "collapse", or "time" when the run was not stopped
+     */
+    std::string GetStopReason() const;
+
+  private:
+    struct Window {
+        uint32_t satisfied = 0;
+        double delaySum = 0;
+    };
+
+    void OnDelay(Ptr<ndn::App> app, uint32_t seqno, Time delay, int32_t hopCount);
+
+    void DoCheck();
+
+    /** \brief mean ISR and ISD over windows [first, first + WINDOWS)
+     */
+    void Average(size_t first, double& isr, double& isd, uint32_t& satisfied) const;
+
+  private:
+    enum Reason { TIME, STEADY, COLLAPSE };
+
+    double m_rate;
+    Time m_window;
+    std::vector<Window> m_windows;
+    Reason m_reason;
+    EventId m_event;
+};
+
+}  // namespace ns3
+
+#endif  // STEADY_STATE_MONITOR_HPP
@@ -0,0 +1,53 @@
+#include "strategy-parameters.hpp"
+
+#include <stdexcept>
+
+namespace nfd {
+namespace fw {
+
+std::map<std::string, std::map<std::string, double>> StrategyParameters::s_values;
+
+StrategyParameters::StrategyParameters(const std::string& strategy, const PartialName& parameters)
+    : m_strategy(strategy) {
+    for (const auto& component : parameters) {
+        std::string field(reinterpret_cast<const char*>(component.value()), component.value_size());
+        size_t sep = field.find('~');
+        if (sep == std::string::npos || sep == 0) {
+            NDN_THROW(std::invalid_argument(m_strategy + " expects key~value parameters, got " + field));
+        }
+        m_values[field.substr(0, sep)] = field.substr(sep + 1);
+    }
+}
+
+double StrategyParameters::get(const std::string& key, double def) {
+    auto it = m_values.find(key);
+    if (it == m_values.end()) {
+        s_values[m_strategy][key] = def;
+        return def;
+    }
+    m_used.insert(key);
+    size_t end = 0;
+    double value = 0;
+    try {
+        value = std::stod(it->second, &end);
+    }
+    catch (const std::exception&) {
+        end = 0;
+    }
+    if (end == 0 || end != it->second.size()) {
+        NDN_THROW(std::invalid_argument(m_strategy + " parameter " + key + " is not a number: " + it->second));
+    }
+    s_values[m_strategy][key] = value;
+    return value;
+}
+
+void StrategyParameters::checkUnused() const {
+    for (const auto& value : m_values) {
+        if (m_used.count(value.first) == 0) {
+            NDN_THROW(std::invalid_argument(m_strategy + " does not accept parameter " + value.first));
+        }
+    }
+}
+
+}  // namespace fw
+}  // namespace nfd
@@ -0,0 +1,53 @@
+#ifndef NFD_DAEMON_FW_STRATEGY_PARAMETERS_HPP
+#define NFD_DAEMON_FW_STRATEGY_PARAMETERS_HPP
+
+#include "ns3/ndnSIM/NFD/daemon/fw/strategy.hpp"
+
+#include <map>
+#include <set>
+#include <string>
+
+namespace nfd {
+namespace fw {
+
+/** \brief tunable thresholds passed in the strategy instance name
+ *
+ *  Each component after the version is "key~value", the format AsfStrategy
+ *  uses, e.g. /localhost/nfd/strategy/CCAF/%FD%01/pth~0.9/t~2. A strategy
+ *  reads its keys with get() in the constructor, falling back to its built-in
+ *  default, then calls checkUnused() so that a misspelt key fails the run
+ *  instead of being ignored. Every value get() returns, given or default,
+ *  is recorded per strategy name and written to the run report, so scripts
+ *  read the defaults from a run instead of from the sources.
+ */
+class StrategyParameters {
+  public:
+    /** \throw std::invalid_argument a component is not "key~value"
+     */
+    StrategyParameters(const std::string& strategy, const PartialName& parameters);
+
+    /** \return the value of \p key, or \p def when it was not given
+     *  \throw std::invalid_argument the value is not a number
+     */
+    double get(const std::string& key, double def);
+
+    /** \throw std::invalid_argument a key was never read by get()
+     */
+    void checkUnused() const;
+
+    /** \return strategy name -> key -> value returned by get()
+     */
+    static const std::map<std::string, std::map<std::string, double>>& getValues() { return s_values; }
+
+  private:
+    std::string m_strategy;
+    std::map<std::string, std::string> m_values;
+    std::set<std::string> m_used;
+
+    static std::map<std::string, std::map<std::string, double>> s_values;
+};
+
+}  // namespace fw
+}  // namespace nfd
+
+#endif  // NFD_DAEMON_FW_STRATEGY_PARAMETERS_HPP
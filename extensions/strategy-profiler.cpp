@@ -0,0 +1,223 @@
+#include "strategy-profiler.hpp"
+
+#include "ns3/simulator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <iomanip>
+#include <ostream>
+#include <thread>
+#include <tuple>
+#include <unordered_map>
+
+namespace nfd {
+namespace fw {
+
+namespace {
+
+const int SUB_BUCKET_BITS = 4;
+const uint64_t SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+
+}  // namespace
+
+size_t LatencyHistogram::getBucketIndex(uint64_t ns) {
+    if (ns < SUB_BUCKETS) {
+        return ns;
+    }
+    int exponent = 63 - __builtin_clzll(ns);
+    int shift = exponent - SUB_BUCKET_BITS;
+    return (shift + 1) * SUB_BUCKETS + ((ns >> shift) & (SUB_BUCKETS - 1));
+}
+
+uint64_t LatencyHistogram::getBucketUpperBound(size_t index) {
+    if (index < SUB_BUCKETS) {
+        return index;
+    }
+    int shift = index / SUB_BUCKETS - 1;
+    uint64_t lower = (SUB_BUCKETS + index % SUB_BUCKETS) << shift;
+    return lower + (uint64_t(1) << shift) - 1;
+}
+
+void LatencyHistogram::record(uint64_t ns) {
+    size_t index = getBucketIndex(ns);
+    if (index >= m_buckets.size()) {
+        m_buckets.resize(index + 1);
+    }
+    m_buckets[index]++;
+    m_count++;
+    m_max = std::max(m_max, ns);
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+    if (other.m_buckets.size() > m_buckets.size()) {
+        m_buckets.resize(other.m_buckets.size());
+    }
+    for (size_t i = 0; i < other.m_buckets.size(); i++) {
+        m_buckets[i] += other.m_buckets[i];
+    }
+    m_count += other.m_count;
+    m_max = std::max(m_max, other.m_max);
+}
+
+uint64_t LatencyHistogram::getPercentile(double q) const {
+    if (m_count == 0) {
+        return 0;
+    }
+    uint64_t rank = std::max<uint64_t>(1, std::ceil(std::min(std::max(q, 0.0), 1.0) * m_count));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < m_buckets.size(); i++) {
+        seen += m_buckets[i];
+        if (seen >= rank) {
+            return std::min(getBucketUpperBound(i), m_max);
+        }
+    }
+    return m_max;
+}
+
+bool StrategyProfiler::s_enabled = false;
+StrategyProfiler::Clock StrategyProfiler::s_clock = StrategyProfiler::Clock::STEADY;
+double StrategyProfiler::s_nsPerTick = 1.0;
+thread_local ScopedCallbackTimer* ScopedCallbackTimer::s_current = nullptr;
+
+namespace {
+
+struct CallbackKey {
+    const char* strategy;
+    const char* trigger;
+    uint32_t node;
+
+    bool operator==(const CallbackKey& other) const {
+        return strategy == other.strategy && trigger == other.trigger && node == other.node;
+    }
+};
+
+struct CallbackKeyHash {
+    size_t operator()(const CallbackKey& key) const {
+        return (std::hash<const void*>()(key.strategy) * 31 ^
+                std::hash<const void*>()(key.trigger)) * 31 ^ key.node;
+    }
+};
+
+// one record per (strategy, trigger, node); per (strategy, trigger) totals are merged on demand
+std::unordered_map<CallbackKey, StrategyProfiler::Record, CallbackKeyHash>&
+getTable() {
+    static std::unordered_map<CallbackKey, StrategyProfiler::Record, CallbackKeyHash> table;
+    return table;
+}
+
+void
+mergeRecord(StrategyProfiler::Record& into, const StrategyProfiler::Record& from) {
+    into.calls += from.calls;
+    into.nestedCalls += from.nestedCalls;
+    into.totalNs += from.totalNs;
+    into.maxNs = std::max(into.maxNs, from.maxNs);
+    into.histogram.merge(from.histogram);
+}
+
+}  // namespace
+
+bool StrategyProfiler::setClock(Clock clock) {
+    if (clock == Clock::STEADY) {
+        s_clock = clock;
+        s_nsPerTick = 1.0;
+        return true;
+    }
+#ifdef STRATEGY_PROFILER_HAVE_TSC
+    auto wallStart = std::chrono::steady_clock::now();
+    uint64_t tscStart = __rdtsc();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    uint64_t tscEnd = __rdtsc();
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - wallStart).count();
+    if (tscEnd > tscStart) {
+        s_clock = clock;
+        s_nsPerTick = ns / (tscEnd - tscStart);
+        return true;
+    }
+#endif
+    return false;
+}
+
+void StrategyProfiler::record(const char* strategy, const char* trigger, uint64_t ticks, bool nested) {
+    uint64_t ns = s_clock == Clock::STEADY ? ticks : static_cast<uint64_t>(ticks * s_nsPerTick);
+    auto& record = getTable()[{strategy, trigger, ns3::Simulator::GetContext()}];
+    record.calls++;
+    record.nestedCalls += nested;
+    record.totalNs += ns;
+    record.maxNs = std::max(record.maxNs, ns);
+    record.histogram.record(ns);
+}
+
+std::vector<StrategyProfiler::Record> StrategyProfiler::getRecords() {
+    // the same literal may live at several addresses, merge by name
+    std::vector<Record> records;
+    for (const auto& item : getTable()) {
+        auto it = std::find_if(records.begin(), records.end(), [&](const Record& r) {
+            return r.strategy == item.first.strategy && r.trigger == item.first.trigger;
+        });
+        if (it == records.end()) {
+            records.push_back(item.second);
+            records.back().strategy = item.first.strategy;
+            records.back().trigger = item.first.trigger;
+        } else {
+            mergeRecord(*it, item.second);
+        }
+    }
+    std::sort(records.begin(), records.end(), [](const Record& a, const Record& b) {
+        return std::tie(a.strategy, a.trigger) < std::tie(b.strategy, b.trigger);
+    });
+    return records;
+}
+
+void StrategyProfiler::printPercentiles(std::ostream& os) {
+    auto records = getRecords();
+    os << std::fixed << std::setprecision(2);
+    std::string strategy;
+    for (const auto& r : records) {
+        if (r.strategy != strategy) {
+            os << (strategy.empty() ? "" : "\n") << "strategy " << r.strategy << " ("
+               << (s_clock == Clock::TSC ? "rdtsc" : "steady_clock") << ", us, self time)\n";
+            strategy = r.strategy;
+            os << std::left << std::setw(28) << "  trigger" << std::right << std::setw(10) << "calls"
+               << std::setw(10) << "mean" << std::setw(10) << "p50" << std::setw(10) << "p90"
+               << std::setw(10) << "p99" << std::setw(10) << "p99.9" << std::setw(10) << "max" << "\n";
+        }
+        os << "  " << std::left << std::setw(26) << r.trigger << std::right << std::setw(10) << r.calls
+           << std::setw(10) << (r.calls > 0 ? r.totalNs / 1e3 / r.calls : 0)
+           << std::setw(10) << r.histogram.getPercentile(0.5) / 1e3
+           << std::setw(10) << r.histogram.getPercentile(0.9) / 1e3
+           << std::setw(10) << r.histogram.getPercentile(0.99) / 1e3
+           << std::setw(10) << r.histogram.getPercentile(0.999) / 1e3
+           << std::setw(10) << r.maxNs / 1e3 << "\n";
+    }
+}
+
+void StrategyProfiler::printNodePercentiles(std::ostream& os) {
+    std::vector<std::pair<CallbackKey, const Record*>> items;
+    for (const auto& item : getTable()) {
+        items.emplace_back(item.first, &item.second);
+    }
+    std::sort(items.begin(), items.end(), [](const auto& a, const auto& b) {
+        return std::make_tuple(std::string(a.first.strategy), std::string(a.first.trigger), a.first.node) <
+               std::make_tuple(std::string(b.first.strategy), std::string(b.first.trigger), b.first.node);
+    });
+    os << std::fixed << std::setprecision(3);
+    os << "strategy,trigger,node,calls,mean_us,p50_us,p99_us,max_us\n";
+    for (const auto& item : items) {
+        const Record& r = *item.second;
+        os << item.first.strategy << "," << item.first.trigger << ",";
+        if (item.first.node != ns3::Simulator::NO_CONTEXT) {
+            os << item.first.node;
+        }
+        os << "," << r.calls << "," << (r.calls > 0 ? r.totalNs / 1e3 / r.calls : 0)
+           << "," << r.histogram.getPercentile(0.5) / 1e3 << "," << r.histogram.getPercentile(0.99) / 1e3
+           << "," << r.maxNs / 1e3 << "\n";
+    }
+}
+
+void StrategyProfiler::reset() {
+    getTable().clear();
+}
+
+}  // namespace fw
+}  // namespace nfd
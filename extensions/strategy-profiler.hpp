@@ -0,0 +1,181 @@
+#ifndef NFD_DAEMON_FW_STRATEGY_PROFILER_HPP
+#define NFD_DAEMON_FW_STRATEGY_PROFILER_HPP
+
+#include "vanet-probes.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define STRATEGY_PROFILER_HAVE_TSC 1
+#endif
+
+namespace nfd {
+namespace fw {
+
+/** \brief log-linear latency histogram in the style of HdrHistogram
+ *
+ *  Values below 16 ns are exact; above that every power of two is split into
+ *  16 buckets, so a reported percentile is within 6.25% of the true value.
+ *  Buckets are allocated lazily up to the largest value seen.
+ */
+class LatencyHistogram {
+  public:
+    void record(uint64_t ns);
+
+    void merge(const LatencyHistogram& other);
+
+    uint64_t getCount() const { return m_count; }
+
+    uint64_t getMax() const { return m_max; }
+
+    /** \param q quantile in [0, 1]
+     *  \return highest value equivalent to the q-th recorded value, 0 if empty
+     */
+    uint64_t getPercentile(double q) const;
+
+  private:
+    static size_t getBucketIndex(uint64_t ns);
+
+    static uint64_t getBucketUpperBound(size_t index);
+
+  private:
+    std::vector<uint32_t> m_buckets;
+    uint64_t m_count = 0;
+    uint64_t m_max = 0;
+};
+
+/** \brief accumulates the wall-clock time spent inside strategy callbacks
+ *
+ *  Keeps one histogram per (strategy, trigger) and per (strategy, trigger,
+ *  node), the node being the ns-3 context of the event that runs the callback.
+ *  A callback that runs inside another profiled callback is charged to itself
+ *  only: its time is subtracted from the enclosing one, so the totals of all
+ *  records add up to the time spent in strategies, counted once.
+ *  Disabled by default; a disabled profiler costs one branch per callback.
+ */
+class StrategyProfiler {
+  public:
+    enum class Clock {
+        STEADY, ///< std::chrono::steady_clock
+        TSC     ///< RDTSC, converted to ns with a rate calibrated against steady_clock
+    };
+
+    struct Record {
+        std::string strategy;
+        std::string trigger;
+        uint64_t calls = 0;
+        uint64_t nestedCalls = 0;  ///< calls made inside another profiled callback
+        uint64_t totalNs = 0;      ///< self time, without nested callbacks
+        uint64_t maxNs = 0;
+        LatencyHistogram histogram;
+    };
+
+    static bool isEnabled() { return s_enabled; }
+
+    static void enable(bool enabled = true) { s_enabled = enabled; }
+
+    /** \brief select the time source of callback timers
+     *  \return false if TSC is requested but unavailable; steady_clock is kept then
+     */
+    static bool setClock(Clock clock);
+
+    static Clock getClock() { return s_clock; }
+
+    /** \return current time in ticks of the selected clock
+     */
+    static uint64_t now() {
+#ifdef STRATEGY_PROFILER_HAVE_TSC
+        if (s_clock == Clock::TSC) {
+            return __rdtsc();
+        }
+#endif
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    /** \param strategy,trigger string literals; they are used as keys by address
+     *  \param ticks self time in ticks of the selected clock
+     *  \param nested whether the call ran inside another profiled callback
+     */
+    static void record(const char* strategy, const char* trigger, uint64_t ticks, bool nested);
+
+    /** \return one record per (strategy, trigger), sorted by name
+     */
+    static std::vector<Record> getRecords();
+
+    /** \brief print a percentile table per strategy
+     */
+    static void printPercentiles(std::ostream& os);
+
+    /** \brief write one CSV line per (strategy, trigger, node)
+     */
+    static void printNodePercentiles(std::ostream& os);
+
+    static void reset();
+
+  private:
+    static bool s_enabled;
+    static Clock s_clock;
+    static double s_nsPerTick;
+};
+
+/** \brief measures one strategy callback invocation
+ *
+ *  Active timers form a per-thread stack; on exit a timer records its elapsed
+ *  time minus that of the timers nested in it, and adds its elapsed time to
+ *  the enclosing timer's child time.
+ */
+class ScopedCallbackTimer {
+  public:
+    ScopedCallbackTimer(const char* strategy, const char* trigger)
+        : m_strategy(strategy), m_trigger(trigger), m_active(StrategyProfiler::isEnabled()) {
+        VANET_PROBE2(strategy_enter, m_strategy, m_trigger);
+        if (m_active) {
+            m_parent = s_current;
+            s_current = this;
+            m_start = StrategyProfiler::now();
+        }
+    }
+
+    ~ScopedCallbackTimer() {
+        if (m_active) {
+            uint64_t elapsed = StrategyProfiler::now() - m_start;
+            StrategyProfiler::record(m_strategy, m_trigger, elapsed - std::min(elapsed, m_childTicks),
+                                     m_parent != nullptr);
+            if (m_parent != nullptr) {
+                m_parent->m_childTicks += elapsed;
+            }
+            s_current = m_parent;
+        }
+        VANET_PROBE2(strategy_exit, m_strategy, m_trigger);
+    }
+
+    ScopedCallbackTimer(const ScopedCallbackTimer&) = delete;
+    ScopedCallbackTimer& operator=(const ScopedCallbackTimer&) = delete;
+
+  private:
+    const char* m_strategy;
+    const char* m_trigger;
+    bool m_active;
+    uint64_t m_start = 0;
+    uint64_t m_childTicks = 0;
+    ScopedCallbackTimer* m_parent = nullptr;
+
+    static thread_local ScopedCallbackTimer* s_current;
+};
+
+}  // namespace fw
+}  // namespace nfd
+
+/** \brief time the enclosing strategy callback, labelled with its function name
+ */
+#define STRATEGY_PROFILE(strategy) \
+    ::nfd::fw::ScopedCallbackTimer strategyProfileTimer_(strategy, __func__)
+
+#endif  // NFD_DAEMON_FW_STRATEGY_PROFILER_HPP
@@ -0,0 +1,66 @@
+#ifndef NFD_DAEMON_FW_TABLE_SIZE_REPORTER_HPP
+#define NFD_DAEMON_FW_TABLE_SIZE_REPORTER_HPP
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace nfd {
+namespace fw {
+
+/** \brief implemented by strategies that keep private tables, so that
+ *         MemoryReport can account for them
+ *
+ *  MemoryReport finds the interface with dynamic_cast on each strategy
+ *  instance; strategies without private state need not implement it.
+ */
+class TableSizeReporter {
+  public:
+    struct TableSize {
+        std::string name;    ///< e.g. "VNDN::m_waitTable"
+        size_t entries = 0;
+        size_t bytes = 0;    ///< estimate, excluding heap memory owned by the elements
+    };
+
+    virtual ~TableSizeReporter() = default;
+
+    /** \brief append one TableSize per private table
+     */
+    virtual void reportTableSizes(std::vector<TableSize>& tables) const = 0;
+
+  protected:
+    template<typename T>
+    static size_t estimateBytes(const std::vector<T>& table) {
+        return table.capacity() * sizeof(T);
+    }
+
+    template<typename K, typename V, typename... Args>
+    static size_t estimateBytes(const std::unordered_map<K, V, Args...>& table) {
+        // one node (value + next pointer + cached hash) per entry plus the bucket array
+        return table.size() * (sizeof(std::pair<const K, V>) + 2 * sizeof(void*)) +
+               table.bucket_count() * sizeof(void*);
+    }
+
+    /** \brief estimate for a container whose nodes are not otherwise accounted for
+     */
+    template<typename T>
+    static size_t estimateBytes(const T& table) {
+        return table.size() * (sizeof(typename T::value_type) + 3 * sizeof(void*));
+    }
+
+    template<typename T>
+    static TableSize makeTableSize(std::string name, const T& table) {
+        TableSize size;
+        size.name = std::move(name);
+        size.entries = table.size();
+        size.bytes = estimateBytes(table);
+        return size;
+    }
+};
+
+}  // namespace fw
+}  // namespace nfd
+
+#endif  // NFD_DAEMON_FW_TABLE_SIZE_REPORTER_HPP
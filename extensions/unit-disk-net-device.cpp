@@ -0,0 +1,471 @@
+#include "unit-disk-net-device.hpp"
+
+#include "ns3/abort.h"
+#include "ns3/address-utils.h"
+#include "ns3/boolean.h"
+#include "ns3/double.h"
+#include "ns3/log.h"
+#include "ns3/node.h"
+#include "ns3/packet.h"
+#include "ns3/simulator.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+#include <set>
+
+#ifdef NS3_MPI
+#include <ns3/distributed-simulator-impl.h>
+#include <ns3/mpi-interface.h>
+#include <ns3/mpi-receiver.h>
+#endif
+
+NS_LOG_COMPONENT_DEFINE("UnitDiskNetDevice");
+
+namespace ns3 {
+
+NS_OBJECT_ENSURE_REGISTERED(UnitDiskHeader);
+NS_OBJECT_ENSURE_REGISTERED(UnitDiskChannel);
+NS_OBJECT_ENSURE_REGISTERED(UnitDiskNetDevice);
+
+TypeId UnitDiskHeader::GetTypeId() {
+    static TypeId tid = TypeId("ns3::UnitDiskHeader").SetParent<Header>().AddConstructor<UnitDiskHeader>();
+    return tid;
+}
+
+UnitDiskHeader::UnitDiskHeader()
+    : m_protocol(0) {
+}
+
+TypeId UnitDiskHeader::GetInstanceTypeId() const {
+    return GetTypeId();
+}
+
+uint32_t UnitDiskHeader::GetSerializedSize() const {
+    return 2 + 6 + 6 + 8;
+}
+
+void UnitDiskHeader::Serialize(Buffer::Iterator start) const {
+    Buffer::Iterator i = start;
+    i.WriteHtonU16(m_protocol);
+    WriteTo(i, m_from);
+    WriteTo(i, m_to);
+    i.WriteHtonU64(m_duration.GetTimeStep());
+}
+
+uint32_t UnitDiskHeader::Deserialize(Buffer::Iterator start) {
+    Buffer::Iterator i = start;
+    m_protocol = i.ReadNtohU16();
+    ReadFrom(i, m_from);
+    ReadFrom(i, m_to);
+    m_duration = TimeStep(i.ReadNtohU64());
+    return GetSerializedSize();
+}
+
+void UnitDiskHeader::Print(std::ostream& os) const {
+    os << "protocol=" << m_protocol << " from=" << m_from << " to=" << m_to << " duration=" << m_duration;
+}
+
+TypeId UnitDiskChannel::GetTypeId() {
+    static TypeId tid =
+        TypeId("ns3::UnitDiskChannel")
+            .SetParent<Channel>()
+            .AddConstructor<UnitDiskChannel>()
+            .AddAttribute("Range",
+                          "Delivery distance in meters",
+                          DoubleValue(200.0),
+                          MakeDoubleAccessor(&UnitDiskChannel::m_range),
+                          MakeDoubleChecker<double>(0.0))
+            .AddAttribute("LossProbability",
+                          "Probability that a receiver in range drops a frame",
+                          DoubleValue(0.0),
+                          MakeDoubleAccessor(&UnitDiskChannel::m_lossProbability),
+                          MakeDoubleChecker<double>(0.0, 1.0))
+            .AddAttribute("Delay",
+                          "Fixed propagation delay",
+                          TimeValue(MicroSeconds(1)),
+                          MakeTimeAccessor(&UnitDiskChannel::m_delay),
+                          MakeTimeChecker());
+    return tid;
+}
+
+UnitDiskChannel::UnitDiskChannel()
+    : m_range(200.0),
+      m_lossProbability(0.0),
+      m_delay(MicroSeconds(1)),
+      m_random(CreateObject<UniformRandomVariable>()) {
+    NS_LOG_FUNCTION(this);
+}
+
+void UnitDiskChannel::DoDispose() {
+    m_devices.clear();
+    m_mobilities.clear();
+    m_random = 0;
+    Channel::DoDispose();
+}
+
+int64_t UnitDiskChannel::AssignStreams(int64_t stream) {
+    m_random->SetStream(stream);
+    return 1;
+}
+
+void UnitDiskChannel::Add(Ptr<UnitDiskNetDevice> device) {
+    m_devices.push_back(device);
+    m_mobilities.clear();
+}
+
+std::size_t UnitDiskChannel::GetNDevices() const {
+    return m_devices.size();
+}
+
+Ptr<NetDevice> UnitDiskChannel::GetDevice(std::size_t i) const {
+    return m_devices[i];
+}
+
+Time UnitDiskChannel::GetLookAhead() const {
+    Time macDelay = Time::Max();
+    for (const auto& device : m_devices) {
+        macDelay = std::min(macDelay, device->GetMacDelay());
+    }
+    return m_delay + (m_devices.empty() ? Time(0) : macDelay);
+}
+
+MobilityModel* UnitDiskChannel::GetMobility(std::size_t i) const {
+    if (m_mobilities.size() != m_devices.size()) {
+        m_mobilities.resize(m_devices.size(), nullptr);
+    }
+    if (m_mobilities[i] == nullptr) {
+        m_mobilities[i] = PeekPointer(m_devices[i]->GetNode()->GetObject<MobilityModel>());
+        NS_ASSERT_MSG(m_mobilities[i] != nullptr, "UnitDiskChannel needs a MobilityModel on every node");
+    }
+    return m_mobilities[i];
+}
+
+void UnitDiskChannel::Send(Ptr<UnitDiskNetDevice> sender, Ptr<const Packet> packet, uint16_t protocol,
+                           Mac48Address from, Mac48Address to, Time txStart, Time txTime) {
+    NS_LOG_FUNCTION(this << sender << packet << from << to);
+    std::size_t senderIndex = m_devices.size();
+    for (std::size_t i = 0; i < m_devices.size(); i++) {
+        if (m_devices[i] == sender) {
+            senderIndex = i;
+            break;
+        }
+    }
+    NS_ASSERT(senderIndex < m_devices.size());
+
+    // positions are taken when the frame is queued; the error is at most
+    // speed * (MAC delay + queueing), well under a meter for a 20 s run
+    Vector senderPos = GetMobility(senderIndex)->GetPosition();
+    double rangeSquared = m_range * m_range;
+    for (std::size_t i = 0; i < m_devices.size(); i++) {
+        if (i == senderIndex) {
+            continue;
+        }
+        Vector pos = GetMobility(i)->GetPosition();
+        double dx = pos.x - senderPos.x, dy = pos.y - senderPos.y, dz = pos.z - senderPos.z;
+        if (dx * dx + dy * dy + dz * dz > rangeSquared) {
+            continue;
+        }
+        if (m_lossProbability > 0 && m_random->GetValue() < m_lossProbability) {
+            NS_LOG_LOGIC("frame from " << from << " lost at device " << i);
+            continue;
+        }
+        Ptr<UnitDiskNetDevice> receiver = m_devices[i];
+#ifdef NS3_MPI
+        // a receiver owned by another rank gets the frame over MPI, at least
+        // GetLookAhead() from now
+        if (receiver->GetNode()->GetSystemId() != MpiInterface::GetSystemId()) {
+            UnitDiskHeader header;
+            header.m_protocol = protocol;
+            header.m_from = from;
+            header.m_to = to;
+            header.m_duration = txTime;
+            Ptr<Packet> copy = packet->Copy();
+            copy->AddHeader(header);
+            Time rxTime = Simulator::Now() + txStart + m_delay + (receiver->IsCollisionEnabled() ? Time(0) : txTime);
+            MpiInterface::SendPacket(copy, rxTime, receiver->GetNode()->GetId(), receiver->GetIfIndex());
+            continue;
+        }
+#endif
+        uint32_t context = receiver->GetNode()->GetId();
+        // without collisions only the end of the reception matters
+        if (receiver->IsCollisionEnabled()) {
+            Simulator::ScheduleWithContext(context, txStart + m_delay, &UnitDiskNetDevice::StartReceive,
+                                           receiver, packet->Copy(), protocol, from, to, txTime);
+        }
+        else {
+            Simulator::ScheduleWithContext(context, txStart + m_delay + txTime, &UnitDiskNetDevice::Receive,
+                                           receiver, packet->Copy(), protocol, from, to);
+        }
+    }
+}
+
+TypeId UnitDiskNetDevice::GetTypeId() {
+    static TypeId tid =
+        TypeId("ns3::UnitDiskNetDevice")
+            .SetParent<NetDevice>()
+            .AddConstructor<UnitDiskNetDevice>()
+            .AddAttribute("Mtu",
+                          "The MAC-level Maximum Transmission Unit",
+                          UintegerValue(2296),
+                          MakeUintegerAccessor(&UnitDiskNetDevice::SetMtu, &UnitDiskNetDevice::GetMtu),
+                          MakeUintegerChecker<uint16_t>(1, 65535))
+            .AddAttribute("DataRate",
+                          "Rate used to compute the transmission time of a frame",
+                          DataRateValue(DataRate("6Mbps")),
+                          MakeDataRateAccessor(&UnitDiskNetDevice::m_dataRate),
+                          MakeDataRateChecker())
+            .AddAttribute("MacDelay",
+                          "Fixed delay before each transmission, standing in for "
+                          "DIFS/AIFS and backoff",
+                          TimeValue(MicroSeconds(100)),
+                          MakeTimeAccessor(&UnitDiskNetDevice::m_macDelay),
+                          MakeTimeChecker())
+            .AddAttribute("EnableCollisions",
+                          "Drop both frames when two receptions overlap at a device",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&UnitDiskNetDevice::m_enableCollisions),
+                          MakeBooleanChecker());
+    return tid;
+}
+
+UnitDiskNetDevice::UnitDiskNetDevice()
+    : m_ifIndex(0),
+      m_mtu(2296),
+      m_dataRate("6Mbps"),
+      m_macDelay(MicroSeconds(100)),
+      m_enableCollisions(false),
+      m_rxCollided(false) {
+    NS_LOG_FUNCTION(this);
+}
+
+void UnitDiskNetDevice::DoDispose() {
+    m_channel = 0;
+    m_node = 0;
+    m_rxCallback.Nullify();
+    m_promiscRxCallback.Nullify();
+    NetDevice::DoDispose();
+}
+
+void UnitDiskNetDevice::SetChannel(Ptr<UnitDiskChannel> channel) {
+    m_channel = channel;
+    m_channel->Add(this);
+}
+
+void UnitDiskNetDevice::StartReceive(Ptr<Packet> packet, uint16_t protocol, Mac48Address from,
+                                     Mac48Address to, Time duration) {
+    Time now = Simulator::Now();
+    if (now < m_rxEnd) {
+        // overlaps the reception in progress: both are lost
+        NS_LOG_LOGIC("collision at " << m_address << ", frame from " << from << " dropped");
+        m_rxCollided = true;
+        m_rxEnd = std::max(m_rxEnd, now + duration);
+        return;
+    }
+    m_rxEnd = now + duration;
+    m_rxCollided = false;
+    Simulator::Schedule(duration, &UnitDiskNetDevice::Receive, this, packet, protocol, from, to);
+}
+
+void UnitDiskNetDevice::Receive(Ptr<Packet> packet, uint16_t protocol, Mac48Address from, Mac48Address to) {
+    if (m_enableCollisions && m_rxCollided) {
+        return;
+    }
+
+    PacketType packetType;
+    if (to == m_address) {
+        packetType = PACKET_HOST;
+    }
+    else if (to.IsBroadcast()) {
+        packetType = PACKET_BROADCAST;
+    }
+    else if (to.IsGroup()) {
+        packetType = PACKET_MULTICAST;
+    }
+    else {
+        packetType = PACKET_OTHERHOST;
+    }
+
+    if (!m_promiscRxCallback.IsNull()) {
+        m_promiscRxCallback(this, packet, protocol, from, to, packetType);
+    }
+    if (packetType != PACKET_OTHERHOST) {
+        m_rxCallback(this, packet, protocol, from);
+    }
+}
+
+void UnitDiskNetDevice::ReceiveRemote(Ptr<Packet> packet) {
+    UnitDiskHeader header;
+    packet->RemoveHeader(header);
+    if (m_enableCollisions) {
+        StartReceive(packet, header.m_protocol, header.m_from, header.m_to, header.m_duration);
+    }
+    else {
+        Receive(packet, header.m_protocol, header.m_from, header.m_to);
+    }
+}
+
+bool UnitDiskNetDevice::Send(Ptr<Packet> packet, const Address& dest, uint16_t protocolNumber) {
+    return SendFrom(packet, m_address, dest, protocolNumber);
+}
+
+bool UnitDiskNetDevice::SendFrom(Ptr<Packet> packet, const Address& source, const Address& dest,
+                                 uint16_t protocolNumber) {
+    NS_LOG_FUNCTION(this << packet << source << dest << protocolNumber);
+    if (m_channel == nullptr || packet->GetSize() > m_mtu) {
+        return false;
+    }
+
+    // frames of this device go out one after another, each after the MAC delay
+    Time now = Simulator::Now();
+    Time txStart = std::max(now, m_txEnd) + m_macDelay;
+    Time txTime = m_dataRate.CalculateBytesTxTime(packet->GetSize() + MAC_OVERHEAD);
+    m_txEnd = txStart + txTime;
+
+    m_channel->Send(this, packet, protocolNumber, Mac48Address::ConvertFrom(source),
+                    Mac48Address::ConvertFrom(dest), txStart - now, txTime);
+    return true;
+}
+
+void UnitDiskNetDevice::SetIfIndex(const uint32_t index) {
+    m_ifIndex = index;
+}
+
+uint32_t UnitDiskNetDevice::GetIfIndex() const {
+    return m_ifIndex;
+}
+
+Ptr<Channel> UnitDiskNetDevice::GetChannel() const {
+    return m_channel;
+}
+
+void UnitDiskNetDevice::SetAddress(Address address) {
+    m_address = Mac48Address::ConvertFrom(address);
+}
+
+Address UnitDiskNetDevice::GetAddress() const {
+    return m_address;
+}
+
+bool UnitDiskNetDevice::SetMtu(const uint16_t mtu) {
+    m_mtu = mtu;
+    return true;
+}
+
+uint16_t UnitDiskNetDevice::GetMtu() const {
+    return m_mtu;
+}
+
+bool UnitDiskNetDevice::IsLinkUp() const {
+    return true;
+}
+
+void UnitDiskNetDevice::AddLinkChangeCallback(Callback<void> callback) {
+    // the link never goes down
+}
+
+bool UnitDiskNetDevice::IsBroadcast() const {
+    return true;
+}
+
+Address UnitDiskNetDevice::GetBroadcast() const {
+    return Mac48Address::GetBroadcast();
+}
+
+bool UnitDiskNetDevice::IsMulticast() const {
+    return true;
+}
+
+Address UnitDiskNetDevice::GetMulticast(Ipv4Address multicastGroup) const {
+    return Mac48Address::GetMulticast(multicastGroup);
+}
+
+Address UnitDiskNetDevice::GetMulticast(Ipv6Address addr) const {
+    return Mac48Address::GetMulticast(addr);
+}
+
+bool UnitDiskNetDevice::IsBridge() const {
+    return false;
+}
+
+bool UnitDiskNetDevice::IsPointToPoint() const {
+    return false;
+}
+
+Ptr<Node> UnitDiskNetDevice::GetNode() const {
+    return m_node;
+}
+
+void UnitDiskNetDevice::SetNode(Ptr<Node> node) {
+    m_node = node;
+}
+
+bool UnitDiskNetDevice::NeedsArp() const {
+    return false;
+}
+
+void UnitDiskNetDevice::SetReceiveCallback(NetDevice::ReceiveCallback cb) {
+    m_rxCallback = cb;
+}
+
+void UnitDiskNetDevice::SetPromiscReceiveCallback(NetDevice::PromiscReceiveCallback cb) {
+    m_promiscRxCallback = cb;
+}
+
+bool UnitDiskNetDevice::SupportsSendFrom() const {
+    return true;
+}
+
+UnitDiskHelper::UnitDiskHelper() {
+    m_channelFactory.SetTypeId("ns3::UnitDiskChannel");
+    m_deviceFactory.SetTypeId("ns3::UnitDiskNetDevice");
+}
+
+void UnitDiskHelper::SetChannelAttribute(std::string name, const AttributeValue& value) {
+    m_channelFactory.Set(name, value);
+}
+
+void UnitDiskHelper::SetDeviceAttribute(std::string name, const AttributeValue& value) {
+    m_deviceFactory.Set(name, value);
+}
+
+NetDeviceContainer UnitDiskHelper::Install(NodeContainer nodes) const {
+    Ptr<UnitDiskChannel> channel = m_channelFactory.Create<UnitDiskChannel>();
+    NetDeviceContainer devices;
+    for (NodeContainer::Iterator it = nodes.Begin(); it != nodes.End(); ++it) {
+        Ptr<UnitDiskNetDevice> device = m_deviceFactory.Create<UnitDiskNetDevice>();
+        device->SetAddress(Mac48Address::Allocate());
+        (*it)->AddDevice(device);
+        device->SetChannel(channel);
+#ifdef NS3_MPI
+        if (MpiInterface::IsEnabled()) {
+            Ptr<MpiReceiver> receiver = CreateObject<MpiReceiver>();
+            receiver->SetReceiveCallback(MakeCallback(&UnitDiskNetDevice::ReceiveRemote, device));
+            device->AggregateObject(receiver);
+        }
+#endif
+        devices.Add(device);
+    }
+#ifdef NS3_MPI
+    if (MpiInterface::IsEnabled()) {
+        Ptr<DistributedSimulatorImpl> impl = DynamicCast<DistributedSimulatorImpl>(Simulator::GetImplementation());
+        NS_ABORT_MSG_IF(impl == nullptr,
+                        "UnitDiskHelper under MPI needs SimulatorImplementationType=ns3::DistributedSimulatorImpl");
+        impl->BoundLookAhead(channel->GetLookAhead());
+    }
+#endif
+    return devices;
+}
+
+int64_t UnitDiskHelper::AssignStreams(NetDeviceContainer devices, int64_t stream) const {
+    int64_t current = stream;
+    std::set<Ptr<Channel>> channels;
+    for (NetDeviceContainer::Iterator it = devices.Begin(); it != devices.End(); ++it) {
+        Ptr<UnitDiskChannel> channel = DynamicCast<UnitDiskChannel>((*it)->GetChannel());
+        if (channel != nullptr && channels.insert(channel).second) {
+            current += channel->AssignStreams(current);
+        }
+    }
+    return current - stream;
+}
+
+}  // namespace ns3
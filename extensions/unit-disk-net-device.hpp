@@ -0,0 +1,235 @@
+#ifndef UNIT_DISK_NET_DEVICE_HPP
+#define UNIT_DISK_NET_DEVICE_HPP
+
+#include "ns3/channel.h"
+#include "ns3/data-rate.h"
+#include "ns3/header.h"
+#include "ns3/mac48-address.h"
+#include "ns3/mobility-model.h"
+#include "ns3/net-device.h"
+#include "ns3/net-device-container.h"
+#include "ns3/node-container.h"
+#include "ns3/nstime.h"
+#include "ns3/object-factory.h"
+#include "ns3/random-variable-stream.h"
+
+#include <vector>
+
+namespace ns3 {
+
+class UnitDiskNetDevice;
+
+/**
+ * \brief link-layer fields of a UnitDiskNetDevice frame sent to another MPI rank
+ *
+ * Frames between devices of one rank are passed in the scheduled event and
+ * never carry it. MpiInterface only transfers the packet, so a frame for a
+ * remote rank takes its protocol, addresses and airtime along in this header.
+ */
+class UnitDiskHeader : public Header {
+  public:
+    static TypeId GetTypeId();
+
+    UnitDiskHeader();
+
+    virtual TypeId GetInstanceTypeId() const;
+    virtual uint32_t GetSerializedSize() const;
+    virtual void Serialize(Buffer::Iterator start) const;
+    virtual uint32_t Deserialize(Buffer::Iterator start);
+    virtual void Print(std::ostream& os) const;
+
+    uint16_t m_protocol;
+    Mac48Address m_from;
+    Mac48Address m_to;
+    Time m_duration;
+};
+
+/**
+ * \brief shared medium of UnitDiskNetDevice with range-based delivery
+ *
+ * A frame reaches every other device within Range of the sender, each one
+ * independently dropped with LossProbability, after the sender's MAC delay,
+ * its transmission time at the device DataRate and a fixed propagation
+ * Delay. There is no PHY, no carrier sensing, no ACK and no retransmission,
+ * so a 20 s run costs one event per receiver and frame instead of the
+ * YansWifiPhy/OcbWifiMac state machines. It is meant for ranking forwarding
+ * strategies quickly; test/calibrate.py compares its metrics with the full
+ * 802.11p stack. That comparison has not been run yet, so neither the
+ * speed-up nor the agreement of the strategy ranking with 802.11p is
+ * established. Treat --fast results as unverified until calibrate.py has
+ * produced its summary for the traces in use.
+ */
+class UnitDiskChannel : public Channel {
+  public:
+    static TypeId GetTypeId();
+
+    UnitDiskChannel();
+
+    void Add(Ptr<UnitDiskNetDevice> device);
+
+    virtual std::size_t GetNDevices() const;
+
+    virtual Ptr<NetDevice> GetDevice(std::size_t i) const;
+
+    /** \brief deliver \p packet to the devices in range of \p sender
+     *  \param txStart delay from now until the sender starts transmitting
+     *  \param txTime transmission time of the frame
+     */
+    void Send(Ptr<UnitDiskNetDevice> sender, Ptr<const Packet> packet, uint16_t protocol,
+              Mac48Address from, Mac48Address to, Time txStart, Time txTime);
+
+    double GetRange() const { return m_range; }
+
+    /** \brief lower bound on the delay between a send and its reception:
+     *         propagation delay plus the smallest MacDelay on the channel
+     *
+     * With MPI this is the lookahead between ranks.
+     */
+    Time GetLookAhead() const;
+
+    /** \brief assign a fixed stream number to the loss random variable
+     *  \return number of streams used, 1
+     */
+    int64_t AssignStreams(int64_t stream);
+
+  protected:
+    virtual void DoDispose();
+
+  private:
+    MobilityModel* GetMobility(std::size_t i) const;
+
+  private:
+    double m_range;
+    double m_lossProbability;
+    Time m_delay;
+    Ptr<UniformRandomVariable> m_random;
+
+    std::vector<Ptr<UnitDiskNetDevice>> m_devices;
+    // resolved on first use, the mobility models are installed after the devices
+    mutable std::vector<MobilityModel*> m_mobilities;
+};
+
+/**
+ * \brief NetDevice attached to a UnitDiskChannel
+ *
+ * Frames of one device are sent back to back, each after a fixed MacDelay.
+ * Received frames are passed to the promiscuous callback whatever their
+ * destination, the way WifiNetDevice does in promiscuous mode, so the ndnSIM
+ * WifiNetDeviceTransport and WifiNetDeviceTransportBroadcast work on it
+ * unchanged.
+ *
+ * With EnableCollisions, two frames whose receptions overlap at a device are
+ * both lost there. This is the whole collision model: there is no capture
+ * and no backoff.
+ *
+ * Under MPI, frames from devices on other ranks arrive through an
+ * MpiReceiver aggregated by UnitDiskHelper and are passed to ReceiveRemote.
+ */
+class UnitDiskNetDevice : public NetDevice {
+  public:
+    /// 802.11 data header (24) + LLC/SNAP (8) + FCS (4)
+    static const uint32_t MAC_OVERHEAD = 36;
+
+    static TypeId GetTypeId();
+
+    UnitDiskNetDevice();
+
+    void SetChannel(Ptr<UnitDiskChannel> channel);
+
+    /** \brief called by the channel at the start of a reception
+     */
+    void StartReceive(Ptr<Packet> packet, uint16_t protocol, Mac48Address from, Mac48Address to, Time duration);
+
+    /** \brief called by the channel, or by StartReceive, at the end of a reception
+     */
+    void Receive(Ptr<Packet> packet, uint16_t protocol, Mac48Address from, Mac48Address to);
+
+    /** \brief called through MpiReceiver for a frame sent from another rank
+     */
+    void ReceiveRemote(Ptr<Packet> packet);
+
+    bool IsCollisionEnabled() const { return m_enableCollisions; }
+
+    Time GetMacDelay() const { return m_macDelay; }
+
+    // inherited from NetDevice
+    virtual void SetIfIndex(const uint32_t index);
+    virtual uint32_t GetIfIndex() const;
+    virtual Ptr<Channel> GetChannel() const;
+    virtual void SetAddress(Address address);
+    virtual Address GetAddress() const;
+    virtual bool SetMtu(const uint16_t mtu);
+    virtual uint16_t GetMtu() const;
+    virtual bool IsLinkUp() const;
+    virtual void AddLinkChangeCallback(Callback<void> callback);
+    virtual bool IsBroadcast() const;
+    virtual Address GetBroadcast() const;
+    virtual bool IsMulticast() const;
+    virtual Address GetMulticast(Ipv4Address multicastGroup) const;
+    virtual Address GetMulticast(Ipv6Address addr) const;
+    virtual bool IsBridge() const;
+    virtual bool IsPointToPoint() const;
+    virtual bool Send(Ptr<Packet> packet, const Address& dest, uint16_t protocolNumber);
+    virtual bool SendFrom(Ptr<Packet> packet, const Address& source, const Address& dest,
+                          uint16_t protocolNumber);
+    virtual Ptr<Node> GetNode() const;
+    virtual void SetNode(Ptr<Node> node);
+    virtual bool NeedsArp() const;
+    virtual void SetReceiveCallback(NetDevice::ReceiveCallback cb);
+    virtual void SetPromiscReceiveCallback(NetDevice::PromiscReceiveCallback cb);
+    virtual bool SupportsSendFrom() const;
+
+  protected:
+    virtual void DoDispose();
+
+  private:
+    Ptr<UnitDiskChannel> m_channel;
+    Ptr<Node> m_node;
+    Mac48Address m_address;
+    uint32_t m_ifIndex;
+    uint16_t m_mtu;
+    DataRate m_dataRate;
+    Time m_macDelay;
+    bool m_enableCollisions;
+    NetDevice::ReceiveCallback m_rxCallback;
+    NetDevice::PromiscReceiveCallback m_promiscRxCallback;
+
+    Time m_txEnd;        ///< end of the last scheduled transmission
+    Time m_rxEnd;        ///< end of the reception in progress
+    bool m_rxCollided;   ///< the reception in progress overlapped another one
+};
+
+/**
+ * \brief installs UnitDiskNetDevices on one shared UnitDiskChannel
+ *
+ * Under MPI every rank installs devices on all nodes, as ns-3 requires; the
+ * helper also aggregates an MpiReceiver to each device and bounds the
+ * DistributedSimulatorImpl lookahead by UnitDiskChannel::GetLookAhead().
+ */
+class UnitDiskHelper {
+  public:
+    UnitDiskHelper();
+
+    void SetChannelAttribute(std::string name, const AttributeValue& value);
+
+    void SetDeviceAttribute(std::string name, const AttributeValue& value);
+
+    NetDeviceContainer Install(NodeContainer nodes) const;
+
+    /** \brief assign fixed stream numbers to the random variables of the
+     *         channel \p devices are attached to, starting at \p stream
+     *
+     *  The streams follow the RngRun in effect at the time of the call.
+     *
+     *  \return number of streams used
+     */
+    int64_t AssignStreams(NetDeviceContainer devices, int64_t stream) const;
+
+  private:
+    ObjectFactory m_channelFactory;
+    ObjectFactory m_deviceFactory;
+};
+
+}  // namespace ns3
+
+#endif  // UNIT_DISK_NET_DEVICE_HPP
@@ -0,0 +1,200 @@
+#ifndef NFD_DAEMON_FW_VANET_KERNELS_HPP
+#define NFD_DAEMON_FW_VANET_KERNELS_HPP
+
+#include "ns3/vector.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+namespace nfd {
+namespace face {
+class Face;
+} // namespace face
+
+namespace fw {
+namespace vanet {
+
+/* 各转发策略共用的计算内核，只依赖位置/速度等数值输入，便于单独测试和基准测试 */
+
+/* TOPSIS决策中一个候选Face的指标 */
+struct FaceStats {
+    face::Face* face;
+    double distance;
+    double sisr;
+    double srtt;
+    FaceStats(face::Face* f, double d, double isr, double rtt) : face(f), distance(d), sisr(isr), srtt(rtt) {}
+};
+
+/* 计算链路持续时间LET，相对速度为0时返回1e6 */
+inline double
+linkExpirationTime(const ns3::Vector& pos1, const ns3::Vector& vel1,
+                   const ns3::Vector& pos2, const ns3::Vector& vel2, double range) {
+    double m = pos1.x - pos2.x;
+    double n = pos1.y - pos2.y;
+    double p = vel1.x - vel2.x;
+    double q = vel1.y - vel2.y;
+    if (p == 0 && q == 0) { return 1e6; } //相对速度为0时，用1e6表示无限大
+    return (-(m * p + n * q) + sqrt((pow(p, 2) + pow(q, 2)) * pow(range, 2) - pow(n * p - m * q, 2))) / (pow(p, 2) + pow(q, 2));
+}
+
+/* 计算沿道路方向(x轴)的距离DR，distance为两节点间的欧氏距离 */
+inline double
+roadDistance(const ns3::Vector& nodePos, const ns3::Vector& remotePos, double distance) {
+    ns3::Vector direction = { 1.0, 0.0, 0.0 };
+    double angle = std::atan2(direction.x, direction.y) - std::atan2(remotePos.x - nodePos.x, remotePos.y - nodePos.y);
+    return std::abs(distance * cos(angle));
+}
+
+/* 计算链路可用概率LAP */
+inline double
+linkAvailabilityProbability(double t, double delta_t) {
+    if (t == 0) { return 0; }
+    double lambda = 10;
+    double L = (1.0 - exp(-2 * lambda * t)) * (1.0 / (2 * lambda * t)) + 0.5 * lambda * t * exp(-2 * lambda * t);
+    return delta_t <= t ? (1.0 - (1.0 - L) / t * delta_t) : L / (log(delta_t - t + 1) + 1);
+}
+
+/* 判断C是否位于以A为顶点、AB为轴、半角为maxAngle的抑制区域内 */
+inline bool
+isInSuppressRegion(const ns3::Vector& a, const ns3::Vector& b, const ns3::Vector& c, double maxAngle) {
+    double d_AB = ns3::CalculateDistance(a, b);
+    double d_AC = ns3::CalculateDistance(a, c);
+    double d_BC = ns3::CalculateDistance(b, c);
+    double angle = std::acos((pow(d_AB, 2) + pow(d_AC, 2) - pow(d_BC, 2)) / (2 * d_AB * d_AC + 0.0001));
+    return angle < maxAngle;
+}
+
+/* 计算positions[index]处节点的交通密度：其邻居数与网络平均连接度之比，上限为1 */
+inline double
+trafficDensity(const std::vector<ns3::Vector>& positions, size_t index, double range) {
+    int num_avg = 0;
+    double num_con = 0.0; // 网络平均连接度
+    for (size_t i = 0; i < positions.size(); i++) {
+        int num_neighbor = 0;
+        for (size_t j = 0; j < positions.size(); j++) {
+            num_neighbor += (ns3::CalculateDistance(positions[i], positions[j]) < range);
+        }
+        num_neighbor -= 1; // 去掉自身
+        if (i == index) { num_avg = num_neighbor; }
+        num_con += num_neighbor;
+    }
+    num_con = num_con / positions.size();
+    double td = num_avg / num_con;
+    return std::min(td, 1.0);
+}
+
+/* TOPSIS: 向量归一化，三个指标等权重 */
+inline std::vector<FaceStats>
+topsisNormalize(const std::vector<FaceStats>& faceList) {
+    double letSum = 0, lapSum = 0, srttSum = 0;
+    std::vector<FaceStats> normalizedFaceList;
+    normalizedFaceList.reserve(faceList.size());
+    for (const auto& faceStats : faceList) {
+        letSum += pow(faceStats.distance, 2);
+        lapSum += pow(faceStats.sisr, 2);
+        srttSum += pow(faceStats.srtt, 2);
+    }
+    for (const auto& faceStats : faceList) {
+        double let = letSum > 0 ? 1.0 / 3.0 * faceStats.distance / sqrt(letSum) : 0;
+        double lap = lapSum > 0 ? 1.0 / 3.0 * faceStats.sisr / sqrt(lapSum) : 0;
+        double srtt = srttSum > 0 ? 1.0 / 3.0 * faceStats.srtt / sqrt(srttSum) : 0;
+        normalizedFaceList.push_back({ faceStats.face, let, lap, srtt });
+    }
+    return normalizedFaceList;
+}
+
+/* TOPSIS: 正理想解，以第一个候选的Face作为默认值 */
+inline FaceStats
+topsisIdealSolution(const std::vector<FaceStats>& faceList) {
+    return FaceStats(faceList[0].face,
+        std::max_element(faceList.begin(), faceList.end(), [](const auto& a, const auto& b) { return a.distance < b.distance; })->distance,
+        std::max_element(faceList.begin(), faceList.end(), [](const auto& a, const auto& b) { return a.sisr < b.sisr; })->sisr,
+        std::max_element(faceList.begin(), faceList.end(), [](const auto& a, const auto& b) { return a.srtt < b.srtt; })->srtt);
+}
+
+/* TOPSIS: 负理想解 */
+inline FaceStats
+topsisNegativeIdealSolution(const std::vector<FaceStats>& faceList) {
+    return FaceStats(faceList[0].face,
+        std::min_element(faceList.begin(), faceList.end(), [](const auto& a, const auto& b) { return a.distance < b.distance; })->distance,
+        std::min_element(faceList.begin(), faceList.end(), [](const auto& a, const auto& b) { return a.sisr < b.sisr; })->sisr,
+        std::min_element(faceList.begin(), faceList.end(), [](const auto& a, const auto& b) { return a.srtt < b.srtt; })->srtt);
+}
+
+/* TOPSIS: 相对贴近度 */
+inline double
+topsisCloseness(const FaceStats& entry, const FaceStats& idealSolution, const FaceStats& negativeIdealSolution) {
+    double closenessToIdeal = sqrt(pow(entry.distance - idealSolution.distance, 2) +
+                                   pow(entry.sisr - idealSolution.sisr, 2) +
+                                   pow(entry.srtt - idealSolution.srtt, 2));
+    double closenessToNeg = sqrt(pow(entry.distance - negativeIdealSolution.distance, 2) +
+                                 pow(entry.sisr - negativeIdealSolution.sisr, 2) +
+                                 pow(entry.srtt - negativeIdealSolution.srtt, 2));
+    return closenessToNeg / (closenessToIdeal + closenessToNeg);
+}
+
+/* TOPSIS: 贴近度最大的候选的下标，faceList应已归一化且非空 */
+inline size_t
+topsisOptimalIndex(const std::vector<FaceStats>& faceList) {
+    FaceStats idealSolution = topsisIdealSolution(faceList);
+    FaceStats negIdealSolution = topsisNegativeIdealSolution(faceList);
+    std::vector<double> closenessValues;
+    closenessValues.reserve(faceList.size());
+    for (const auto& entry : faceList) {
+        closenessValues.push_back(topsisCloseness(entry, idealSolution, negIdealSolution));
+    }
+    return std::distance(closenessValues.begin(), std::max_element(closenessValues.begin(), closenessValues.end()));
+}
+
+/* 缓存预测的中间量，用于日志输出 */
+struct CachePredictionTerms {
+    bool inCacheRange = false; // order <= cacheSize
+    double mu = 0.0;
+    double sigma = 0.0;
+    double sumRate = 0.0;
+    double probLess = 0.0;
+};
+
+/* 预测排在clt第order位(从1开始)的内容在tau时刻仍被缓存的概率
+ * clt按最近请求时间降序排列，元素的second需有rate成员 */
+template<typename Table>
+double
+predictCacheHit(const Table& clt, int order, double tau, int cacheSize, int contentNum,
+                CachePredictionTerms* terms = nullptr) {
+    CachePredictionTerms t;
+    double prob;
+    double rate = clt[order - 1].second.rate;
+    int size = clt.size();
+    if (order <= cacheSize) {
+        t.inCacheRange = true;
+        t.probLess = rate * exp(-rate * tau);
+        for (int i = order; i < std::max(size, cacheSize); i++) {
+            t.mu += i < size ? exp(-clt[i].second.rate * tau) : 1;
+            t.sigma += i < size ? exp(-clt[i].second.rate * tau) * (1 - exp(-clt[i].second.rate * tau)) : 0;
+            t.probLess *= i < size ? 0.5 * clt[i].second.rate * exp(-clt[i].second.rate * tau) : 0;
+        }
+        prob = 0.5 * erfc((contentNum - cacheSize - t.mu) / sqrt(2) / t.sigma) + t.probLess;
+    }
+    else {
+        t.probLess = 1.0;
+        for (const auto& p : clt) {
+            t.sumRate += p.second.rate;
+            t.probLess *= p.second.rate;
+        }
+        t.probLess *= pow(0.5, size) * exp(-t.sumRate * tau);
+        prob = exp(-t.sumRate * tau) * (exp(rate * tau) - 1) + t.probLess;
+    }
+    if (terms != nullptr) {
+        *terms = t;
+    }
+    return prob;
+}
+
+} // namespace vanet
+} // namespace fw
+} // namespace nfd
+
+#endif // NFD_DAEMON_FW_VANET_KERNELS_HPP
@@ -0,0 +1,14 @@
+#include "vanet-probes.hpp"
+
+#ifdef HAVE_SYS_SDT_H
+
+// the tracer finds each semaphore through the probe's ELF note and
+// increments it while attached
+#define VANET_DEFINE_SEMAPHORE(name)                                                     \
+    extern "C" {                                                                         \
+    unsigned short vanet_##name##_semaphore __attribute__((section(".probes"))) = 0; \
+    }
+VANET_PROBE_SEMAPHORES(VANET_DEFINE_SEMAPHORE)
+#undef VANET_DEFINE_SEMAPHORE
+
+#endif  // HAVE_SYS_SDT_H
@@ -0,0 +1,93 @@
+#ifndef VANET_PROBES_HPP
+#define VANET_PROBES_HPP
+
+/** \file
+ *  \brief Linux USDT probe points of provider "vanet"
+ *
+ *  With sys/sdt.h (found by ./waf configure unless --disable-probes is
+ *  given, which then defines HAVE_SYS_SDT_H) each probe is a nop plus an
+ *  ELF note, so the binaries can be traced by bpftrace or perf while
+ *  running. Every probe has a semaphore, vanet_<name>_semaphore, defined in
+ *  vanet-probes.cpp, which the tracer increments while it is attached; the
+ *  probe's arguments are only evaluated when it is non-zero, so an
+ *  untraced probe costs a load and a branch. Without sys/sdt.h the probes
+ *  compile to nothing. Delays are in ns.
+ *
+ *  | probe              | arguments                                        |
+ *  |--------------------|--------------------------------------------------|
+ *  | strategy_enter     | strategy, trigger (C strings)                    |
+ *  | strategy_exit      | strategy, trigger                                |
+ *  | interest_send      | face id, nonce, Name TLV, Name TLV size          |
+ *  | data_send          | face id, Name TLV, Name TLV size                 |
+ *  | link_send          | face id, LpPacket size                           |
+ *  | link_receive       | face id, LpPacket size                           |
+ *  | transport_send     | node id, packet size                             |
+ *  | transport_receive  | node id, packet size                             |
+ *  | defer_schedule     | strategy, event uid, delay                       |
+ *  | defer_cancel       | strategy, event uid                              |
+ *
+ *  interest_send and data_send fire in the link service right below the
+ *  strategy's sendInterest/sendData, in the same call. Example:
+ *
+ *      bpftrace -e 'usdt:build/dasb:vanet:defer_schedule { @[str(arg0)] = hist(arg2); }'
+ */
+
+#ifdef HAVE_SYS_SDT_H
+
+#define _SDT_HAS_SEMAPHORES 1
+#include <sys/sdt.h>
+
+#define VANET_PROBE_SEMAPHORES(X) \
+    X(strategy_enter)             \
+    X(strategy_exit)              \
+    X(interest_send)              \
+    X(data_send)                  \
+    X(link_send)                  \
+    X(link_receive)               \
+    X(transport_send)             \
+    X(transport_receive)          \
+    X(defer_schedule)             \
+    X(defer_cancel)
+
+#define VANET_DECLARE_SEMAPHORE(name) \
+    extern "C" unsigned short vanet_##name##_semaphore __attribute__((section(".probes")));
+VANET_PROBE_SEMAPHORES(VANET_DECLARE_SEMAPHORE)
+#undef VANET_DECLARE_SEMAPHORE
+
+/** \brief true while a tracer is attached to probe \p name
+ */
+#define VANET_PROBE_ENABLED(name) __builtin_expect(vanet_##name##_semaphore != 0, 0)
+
+#define VANET_PROBE2(name, a1, a2)           \
+    do {                                     \
+        if (VANET_PROBE_ENABLED(name))       \
+            STAP_PROBE2(vanet, name, a1, a2); \
+    } while (0)
+#define VANET_PROBE3(name, a1, a2, a3)           \
+    do {                                         \
+        if (VANET_PROBE_ENABLED(name))           \
+            STAP_PROBE3(vanet, name, a1, a2, a3); \
+    } while (0)
+#define VANET_PROBE4(name, a1, a2, a3, a4)           \
+    do {                                             \
+        if (VANET_PROBE_ENABLED(name))               \
+            STAP_PROBE4(vanet, name, a1, a2, a3, a4); \
+    } while (0)
+
+#else
+
+#define VANET_PROBE_ENABLED(name) false
+
+#define VANET_PROBE2(name, a1, a2) \
+    do {                           \
+    } while (0)
+#define VANET_PROBE3(name, a1, a2, a3) \
+    do {                               \
+    } while (0)
+#define VANET_PROBE4(name, a1, a2, a3, a4) \
+    do {                                   \
+    } while (0)
+
+#endif  // HAVE_SYS_SDT_H
+
+#endif  // VANET_PROBES_HPP
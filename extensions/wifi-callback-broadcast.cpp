@@ -1,4 +1,5 @@
 #include "generic-link-service-m.hpp"
+#include "ndn-geo-tag-helper.hpp"
 #include "ndn-wifi-net-device-transport-broadcast.hpp"
 #include "ns3/core-module.h"
 #include "ns3/mobility-helper.h"
@@ -13,6 +14,7 @@
 #include "ns3/wifi-mac.h"
 #include "ns3/wifi-net-device.h"
 #include "ns3/yans-wifi-helper.h"
+#include "wifi-callback.hpp"
 
 NS_LOG_COMPONENT_DEFINE("WIFICBBroad");
 
@@ -35,72 +37,28 @@ shared_ptr<::nfd::face::Face> WifiApStaDeviceBroadcastCallback(Ptr<Node> node,
                                                       Ptr<ndn::L3Protocol> ndn,
                                                       Ptr<NetDevice> device) {
     NS_LOG_DEBUG("Creating Wifi Face on node " << node->GetId());
-    Ptr<WifiNetDevice> netDevice = DynamicCast<WifiNetDevice>(device);
-    NS_ASSERT(netDevice != nullptr);
-
-    // access the other end of the link
-    Ptr<YansWifiChannel> channel =
-        DynamicCast<YansWifiChannel>(netDevice->GetChannel());
-    NS_ASSERT(channel != nullptr);
-
-    Ptr<WifiMac> mac = netDevice->GetMac();
-    NS_ASSERT(mac != nullptr);
-
-    NetDeviceContainer apdevices;
-    NetDeviceContainer stadevices;
-    NetDeviceContainer adhocDevices;
-    NetDeviceContainer vanetDevices;
-    for (uint32_t i = 0; i < channel->GetNDevices(); i++) {
-        auto ite_dev = DynamicCast<WifiNetDevice>(channel->GetDevice(i));
-        if (ite_dev->GetMac()->GetTypeOfStation() == AP)
-            apdevices.Add(ite_dev);
-        if (ite_dev->GetMac()->GetTypeOfStation() == STA)
-            stadevices.Add(ite_dev);
-        if(ite_dev->GetMac()->GetTypeOfStation()== ADHOC_STA ) 
-            adhocDevices.Add(ite_dev);
-        if(ite_dev->GetMac()->GetTypeOfStation()== OCB ) 
-            vanetDevices.Add(ite_dev);
-    }
-
-    NS_LOG_DEBUG("wifi channel have " 
-                                      << vanetDevices.GetN()<< " vehicles");
-
-    auto type = mac->GetTypeOfStation();
-    NetDeviceContainer* remotedev;
-    switch (type) {
-    case AP:
-        remotedev = &stadevices;
-        break;
-    case STA:
-        remotedev = &apdevices;
-        break;
-    case ADHOC_STA:
-        remotedev = &adhocDevices;
-        break;
-    case OCB:
-        remotedev = &vanetDevices;
-        break;
-    default:
-        NS_LOG_ERROR("do not support this wifi mac type, it should be AP/STA");
-        exit(1);
-        break;
-    }
+    NetDeviceContainer remotedev = GetRemoteDevices(device);
 
     shared_ptr<::nfd::face::Face> face;
 
+    // every face of this node stamps its packets with the node's position,
+    // once a strategy on this node that reads GeoTags has enabled GeoTagHelper
+    auto geoTagProvider = ndn::GeoTagHelper::CreateProvider(node);
+
     // Create an ndnSIM-specific transport instance
-    for (uint32_t i = 0; i < remotedev->GetN(); i++) {
+    for (uint32_t i = 0; i < remotedev.GetN(); i++) {
         ::nfd::face::GenericLinkServiceM::Options opts;
         opts.allowFragmentation = true;
         opts.allowReassembly = true;
         opts.allowCongestionMarking = true;
+        opts.enableGeoTags = geoTagProvider;
 
         auto linkService = make_unique<::nfd::face::GenericLinkServiceM>(opts);
 
-        if(netDevice != remotedev->Get(i)){
+        if(device != remotedev.Get(i)){
             auto transport = make_unique<ndn::WifiNetDeviceTransportBroadcast>(
-                node, netDevice, constructFaceUri2(netDevice),
-                constructFaceUri2(remotedev->Get(i)));
+                node, device, constructFaceUri2(device),
+                constructFaceUri2(remotedev.Get(i)));
 
             face = std::make_shared<::nfd::face::Face>(std::move(linkService),
                                                     std::move(transport));
@@ -1,5 +1,6 @@
 #include "generic-link-service-m.hpp"
 #include "ndn-wifi-net-device-transport.hpp"
+#include "wifi-callback.hpp"
 #include "ns3/core-module.h"
 #include "ns3/mobility-helper.h"
 #include "ns3/ndnSIM-module.h"
@@ -13,6 +14,7 @@
 #include "ns3/wifi-mac.h"
 #include "ns3/wifi-net-device.h"
 #include "ns3/yans-wifi-helper.h"
+#include "unit-disk-net-device.hpp"
 
 NS_LOG_COMPONENT_DEFINE("WIFICB");
 
@@ -31,10 +33,21 @@ std::string constructFaceUri(Ptr<NetDevice> netDevice) {
     return uri;
 }
 
-shared_ptr<::nfd::face::Face> WifiApStaDeviceCallback(Ptr<Node> node,
-                                                      Ptr<ndn::L3Protocol> ndn,
-                                                      Ptr<NetDevice> device) {
-    NS_LOG_DEBUG("Creating Wifi Face on node " << node->GetId());
+NetDeviceContainer GetRemoteDevices(Ptr<NetDevice> device) {
+    NetDeviceContainer apdevices;
+    NetDeviceContainer stadevices;
+    NetDeviceContainer adhocDevices;
+    NetDeviceContainer vanetDevices;
+
+    // 单位圆盘信道上的其他设备都是对端
+    Ptr<UnitDiskChannel> unitDiskChannel = DynamicCast<UnitDiskChannel>(device->GetChannel());
+    if (unitDiskChannel != nullptr) {
+        for (uint32_t i = 0; i < unitDiskChannel->GetNDevices(); i++) {
+            vanetDevices.Add(unitDiskChannel->GetDevice(i));
+        }
+        return vanetDevices;
+    }
+
     Ptr<WifiNetDevice> netDevice = DynamicCast<WifiNetDevice>(device);
     NS_ASSERT(netDevice != nullptr);
 
@@ -46,10 +59,6 @@ shared_ptr<::nfd::face::Face> WifiApStaDeviceCallback(Ptr<Node> node,
     Ptr<WifiMac> mac = netDevice->GetMac();
     NS_ASSERT(mac != nullptr);
 
-    NetDeviceContainer apdevices;
-    NetDeviceContainer stadevices;
-    NetDeviceContainer adhocDevices;
-    NetDeviceContainer vanetDevices;
     for (uint32_t i = 0; i < channel->GetNDevices(); i++) {
         auto ite_dev = DynamicCast<WifiNetDevice>(channel->GetDevice(i));
         if (ite_dev->GetMac()->GetTypeOfStation() == AP)
@@ -66,30 +75,31 @@ shared_ptr<::nfd::face::Face> WifiApStaDeviceCallback(Ptr<Node> node,
                                       << vanetDevices.GetN()<< " vehicles");
 
     auto type = mac->GetTypeOfStation();
-    NetDeviceContainer* remotedev;
     switch (type) {
     case AP:
-        remotedev = &stadevices;
-        break;
+        return stadevices;
     case STA:
-        remotedev = &apdevices;
-        break;
+        return apdevices;
     case ADHOC_STA:
-        remotedev = &adhocDevices;
-        break;
+        return adhocDevices;
     case OCB:
-        remotedev = &vanetDevices;
-        break;
+        return vanetDevices;
     default:
         NS_LOG_ERROR("do not support this wifi mac type, it should be AP/STA");
         exit(1);
-        break;
     }
+}
+
+shared_ptr<::nfd::face::Face> WifiApStaDeviceCallback(Ptr<Node> node,
+                                                      Ptr<ndn::L3Protocol> ndn,
+                                                      Ptr<NetDevice> device) {
+    NS_LOG_DEBUG("Creating Wifi Face on node " << node->GetId());
+    NetDeviceContainer remotedev = GetRemoteDevices(device);
 
     shared_ptr<::nfd::face::Face> face;
 
     // Create an ndnSIM-specific transport instance
-    for (uint32_t i = 0; i < remotedev->GetN(); i++) {
+    for (uint32_t i = 0; i < remotedev.GetN(); i++) {
         ::nfd::face::GenericLinkServiceM::Options opts;
         opts.allowFragmentation = true;
         opts.allowReassembly = true;
@@ -97,10 +107,10 @@ shared_ptr<::nfd::face::Face> WifiApStaDeviceCallback(Ptr<Node> node,
 
         auto linkService = make_unique<::nfd::face::GenericLinkServiceM>(opts);
 
-        if(netDevice != remotedev->Get(i)){
+        if(device != remotedev.Get(i)){
             auto transport = make_unique<ndn::WifiNetDeviceTransport>(
-                node, netDevice, constructFaceUri(netDevice),
-                constructFaceUri(remotedev->Get(i)));
+                node, device, constructFaceUri(device),
+                constructFaceUri(remotedev.Get(i)));
 
             face = std::make_shared<::nfd::face::Face>(std::move(linkService),
                                                     std::move(transport));
@@ -0,0 +1,22 @@
+#ifndef WIFI_CALLBACK_HPP
+#define WIFI_CALLBACK_HPP
+
+#include "ns3/net-device-container.h"
+#include "ns3/net-device.h"
+#include "ns3/ptr.h"
+
+namespace ns3 {
+
+/** \brief the devices \p device gets a face to, shared by
+ *         WifiApStaDeviceCallback and WifiApStaDeviceBroadcastCallback
+ *
+ *  On a UnitDiskChannel every device on the channel is a peer. On a
+ *  YansWifiChannel the peers are picked by the station type of \p device:
+ *  STAs for an AP, APs for a STA, and devices of the same type for ad hoc
+ *  and OCB stations. The result still holds \p device itself.
+ */
+NetDeviceContainer GetRemoteDevices(Ptr<NetDevice> device);
+
+}  // namespace ns3
+
+#endif  // WIFI_CALLBACK_HPP
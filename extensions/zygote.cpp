@@ -0,0 +1,103 @@
+#include "zygote.hpp"
+
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fcntl.h>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <sys/wait.h>
+#include <unistd.h>
+
+NS_LOG_COMPONENT_DEFINE("Zygote");
+
+namespace ns3 {
+
+std::vector<Zygote::Point> Zygote::ReadPoints(const std::string& path) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        NS_FATAL_ERROR("Cannot open point list " << path);
+    }
+    std::vector<Point> points;
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        std::istringstream ss(line);
+        Point point;
+        if (!(ss >> point.strategy >> point.run >> point.output)) {
+            NS_FATAL_ERROR("Malformed point in " << path << ": " << line);
+        }
+        std::string field;
+        while (ss >> field) {
+            size_t eq = field.find('=');
+            if (eq == std::string::npos) {
+                NS_FATAL_ERROR("Expected key=value in " << path << ": " << field);
+            }
+            point.params[field.substr(0, eq)] = field.substr(eq + 1);
+        }
+        points.push_back(point);
+    }
+    return points;
+}
+
+uint32_t Zygote::Run(const std::vector<Point>& points, uint32_t jobs,
+                     const std::function<int(const Point&)>& child) {
+    std::map<pid_t, const Point*> running;
+    uint32_t failed = 0;
+
+    auto reap = [&] {
+        int status;
+        pid_t pid = waitpid(-1, &status, 0);
+        if (pid <= 0) {
+            return;
+        }
+        const Point* point = running[pid];
+        running.erase(pid);
+        bool ok = WIFEXITED(status) && WEXITSTATUS(status) == 0;
+        if (!ok) {
+            failed++;
+        }
+        std::cout << point->strategy << " run=" << point->run << " -> " << point->output
+                  << (ok ? " done" : " failed") << std::endl;
+    };
+
+    for (const Point& point : points) {
+        while (running.size() >= std::max(jobs, 1u)) {
+            reap();
+        }
+        // buffered output would otherwise be written again by every child
+        std::cout.flush();
+        std::cerr.flush();
+        std::fflush(nullptr);
+
+        pid_t pid = fork();
+        if (pid < 0) {
+            NS_FATAL_ERROR("fork failed");
+        }
+        if (pid == 0) {
+            int fd = open((point.output + ".log").c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+            if (fd >= 0) {
+                dup2(fd, STDOUT_FILENO);
+                dup2(fd, STDERR_FILENO);
+                close(fd);
+            }
+            int code = child(point);
+            std::cout.flush();
+            std::cerr.flush();
+            std::fflush(nullptr);
+            // skip the zygote's static destructors and atexit handlers
+            _exit(code);
+        }
+        running[pid] = &point;
+    }
+    while (!running.empty()) {
+        reap();
+    }
+    return failed;
+}
+
+}  // namespace ns3
@@ -0,0 +1,57 @@
+#ifndef ZYGOTE_HPP
+#define ZYGOTE_HPP
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \brief forks one child per simulation point from a process that has
+ *        already built the shared part of a scenario
+ *
+ * Creating the nodes, installing the devices, parsing the mobility trace
+ * and installing the NDN stack with its N^2 faces and routes do not depend
+ * on the strategy or the seed. A scenario in zygote mode does them once,
+ * then calls Run(), and each forked child only installs its strategy and
+ * apps and runs the simulation. Children share the zygote's memory copy on
+ * write, so up to \p jobs of them run in parallel at little extra cost.
+ *
+ * Each child redirects stdout and stderr to <output>.log, so NS_LOG output
+ * lands where test/result.py expects it.
+ *
+ * Random variables created before the fork, such as the wifi backoff and the
+ * unit-disk loss, start on the streams of the zygote's RngRun. The child
+ * must set the point's run and then reassign their streams (AssignStreams
+ * of the device helper), which rebuilds them for that run; objects created
+ * in the child, such as the consumers, follow the run anyway.
+ */
+class Zygote {
+  public:
+    struct Point {
+        std::string strategy;
+        uint32_t run;
+        std::string output;                          ///< prefix of the child's output files
+        std::map<std::string, std::string> params;   ///< extra key=value fields
+    };
+
+    /** \brief read one point per line: "<strategy> <run> <output> [key=value ...]"
+     *
+     *  Empty lines and lines starting with # are skipped.
+     */
+    static std::vector<Point> ReadPoints(const std::string& path);
+
+    /** \brief fork a child per point, at most \p jobs at a time, and wait for all of them
+     *  \param child called in the child process; its return value is the exit status
+     *  \return number of children that did not exit with status 0
+     */
+    static uint32_t Run(const std::vector<Point>& points, uint32_t jobs,
+                        const std::function<int(const Point&)>& child);
+};
+
+}  // namespace ns3
+
+#endif  // ZYGOTE_HPP
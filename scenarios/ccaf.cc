@@ -4,6 +4,15 @@
 
 #include "annotated-topology-reader-m.hpp"
 #include "generic-link-service-m.hpp"
+#include "range-culled-wifi-channel.hpp"
+#include "unit-disk-net-device.hpp"
+#include "run-report.hpp"
+#include "memory-report.hpp"
+#include "airtime-report.hpp"
+#include "hop-tracer.hpp"
+#include "steady-state-monitor.hpp"
+#include "scenario-options.hpp"
+#include "decision-cache.hpp"
 
 #include "ns3/constant-velocity-mobility-model.h"
 #include "ns3/core-module.h"
@@ -41,29 +50,29 @@
 NS_LOG_COMPONENT_DEFINE("WifiSimpleOcb");
 
 namespace ns3 {
-    int main(int num, vector<int> consumers, vector<int> producers, double popularity, double rate, double time, string trace, string delay_log, int size) {
-        uint32_t N = num;
-        vector<int> ConsumerId = consumers;
-        vector<int> ProducerId = producers;
-        double Popularity = popularity;
-        double Rate = rate;
-        double Time = time;
-        string MobilityTrace = trace;
-        string DelayTrace = delay_log;
-
-        int Size = size;
+    int main(const ScenarioOptions& options) {
+        uint32_t N = options.num;
+        vector<int> ConsumerId = options.consumers;
+        vector<int> ProducerId = options.producers;
+        double Popularity = options.popularity;
+        double Rate = options.rate;
+        double Time = options.time;
+        string MobilityTrace = options.trace;
+        string DelayTrace = options.delayLog;
+
+        int Size = options.size;
 
         NodeContainer nodes;
         nodes.Create(N);
 
         std::string phyMode("OfdmRate6Mbps");
-        YansWifiPhyHelper wifiPhy;
-        YansWifiChannelHelper channelHelper = YansWifiChannelHelper::Default();
-        Ptr<YansWifiChannel> channel = channelHelper.Create();
+        RangeCulledYansWifiPhyHelper wifiPhy;
+        Ptr<RangeCulledWifiChannel> channel = CreateObject<RangeCulledWifiChannel>();
+        channel->SetAttribute("EnableCulling", BooleanValue(options.culling));
         Ptr<LogDistancePropagationLossModel> lossModel = CreateObject<LogDistancePropagationLossModel>();
         lossModel->SetReference(1, 40.00);
         lossModel->SetPathLossExponent(1);
-        channel->SetPropagationLossModel(lossModel);
+        channel->SetPropagationModels(lossModel, CreateObject<ConstantSpeedPropagationDelayModel>());
         wifiPhy.Set("TxPowerStart", DoubleValue(0));
         wifiPhy.Set("TxPowerEnd", DoubleValue(0));
         wifiPhy.SetChannel(channel);
@@ -76,7 +85,9 @@ namespace ns3 {
             "DataMode", StringValue(phyMode),
             "ControlMode", StringValue(phyMode));
 
-        NetDeviceContainer devices = wifi80211p.Install(wifiPhy, wifi80211pMac, nodes);
+        // fast=true时用单位圆盘模型代替802.11p, 用于快速筛选策略
+        UnitDiskHelper unitDisk;
+        NetDeviceContainer devices = options.fast ? unitDisk.Install(nodes) : wifi80211p.Install(wifiPhy, wifi80211pMac, nodes);
         Ns2MobilityHelper ns2Mobiity = Ns2MobilityHelper(MobilityTrace);
         ns2Mobiity.Install();
 
@@ -86,11 +97,19 @@ namespace ns3 {
         ndn::StackHelper ndnHelper;
         ndnHelper.AddFaceCreateCallback(WifiNetDevice::GetTypeId(),
             MakeCallback(&WifiApStaDeviceCallback));
+        ndnHelper.AddFaceCreateCallback(UnitDiskNetDevice::GetTypeId(),
+            MakeCallback(&WifiApStaDeviceCallback));
 
         ndnHelper.setCsSize(20);
         ndnHelper.InstallAll();
 
-        ndn::StrategyChoiceHelper::InstallAll("/", "/localhost/nfd/strategy/CCAF/%FD%01");
+        // 策略实例在StrategyChoiceHelper安装时创建, 需先设置决策缓存选项
+        nfd::fw::DecisionCache::Options decisionCacheOptions;
+        decisionCacheOptions.enabled = options.decisionCache;
+        nfd::fw::DecisionCache::setDefaultOptions(decisionCacheOptions);
+
+        // strategyParams为key~value形式的实例名参数, 如pth~0.9/t~2
+        ndn::StrategyChoiceHelper::InstallAll("/", "/localhost/nfd/strategy/CCAF/%FD%01" + (options.strategyParams.empty() ? "" : "/" + options.strategyParams));
 
         // Installing Consumer
         // ndn::AppHelper consumerHelper("ns3::ndn::ConsumerCbr");
@@ -118,6 +137,13 @@ namespace ns3 {
         }
         producer.Install(producerContainer);
 
+        // 信标间隔为0时不安装信标, 策略退回到移动模型
+        if (options.beaconInterval > 0) {
+            ndn::AppHelper beaconHelper("ns3::ndn::BeaconApp");
+            beaconHelper.SetAttribute("Interval", TimeValue(Seconds(options.beaconInterval)));
+            beaconHelper.Install(nodes);
+        }
+
         std::cout << "Trace=" << MobilityTrace << ", Num=" << N << std::endl;
         std::cout << "Install " << consumerContainer.GetN() << " consumers on Node=";
         for (auto& consumer : consumerContainer) {
@@ -132,54 +158,55 @@ namespace ns3 {
         ndn::AppDelayTracer::Install(consumerContainer, DelayTrace);
         // ndn::CsTracer::InstallAll("results/cs_prfs.log", MilliSeconds(1000));
 
+        RunReport runReport(options.report);
+        runReport.SetParameter("strategy", "CCAF");
+        runReport.SetParameter("num", N);
+        runReport.SetParameter("time", Time);
+        runReport.SetParameter("trace", MobilityTrace);
+        runReport.SetParameter("fast", options.fast);
+        runReport.SetParameter("strategyParams", options.strategyParams);
+        runReport.SetParameter("decisionCache", options.decisionCache);
+        runReport.SetParameter("beaconInterval", options.beaconInterval);
+        runReport.SetProfileOutput(options.profile, options.tsc);
+        runReport.Start();
+        MemoryReport memoryReport(options.memory, Seconds(options.memoryInterval));
+        memoryReport.Start();
+        AirtimeReport airtimeReport(options.airtime, Seconds(options.airtimeInterval));
+        airtimeReport.Start();
+        HopTracer hopTracer(options.hops, "CCAF", options.hopSampling);
+        hopTracer.Start();
+        // steady>0时每steady秒统计一次ISR/ISD, 稳定或崩溃后提前结束
+        SteadyStateMonitor steadyMonitor(Rate * consumerContainer.GetN(), Seconds(options.steady));
+        steadyMonitor.Start();
+
         Simulator::Stop(Seconds(Time));
         Simulator::Run();
+        steadyMonitor.Finish();
+        runReport.SetParameter("stop_reason", steadyMonitor.GetStopReason());
+        runReport.SetParameter("stop_time", Simulator::Now().GetSeconds());
+        runReport.Finish();
+        memoryReport.Finish();
+        airtimeReport.Finish();
+        hopTracer.Finish();
         Simulator::Destroy();
         std::cout << "end";
         return 0;
     }
 }
 
-// 解析字符串形式的列表参数，返回vector<int>
-std::vector<int> parseList(const std::string& str) {
-    std::vector<int> result;
-    std::istringstream ss(str); // 去掉首尾的方括号
-    char delimiter;
-    int number;
-    while (ss >> number) {
-        result.push_back(number);
-        ss >> delimiter; // 读取逗号
-    }
-    return result;
-}
 int main(int argc, char* argv[]) {
     // 创建命令行对象
     ns3::CommandLine cmd;
-    int num;
-    string consumers_list;
-    string producers_list;
-    double rate;
-    double time;
-    double popularity;
-    string trace, log, delay_log;
-
-    int size;
+    ns3::ScenarioOptions options;
     // 添加自定义参数
-    cmd.AddValue("num", "Description for number of nodes parameter", num);
-    cmd.AddValue("consumers", "List of consumer nodes", consumers_list);
-    cmd.AddValue("producers", "List of producer nodes", producers_list);
-    cmd.AddValue("popularity", "Popularity of Zipf", popularity);
-    cmd.AddValue("rate", "Description for request rate  parameter", rate);
-    cmd.AddValue("time", "Description for request rate  parameter", time);
-    cmd.AddValue("trace", "Description for mobility trace  parameter", trace);
-    cmd.AddValue("delay_log", "Description for delay log parameter", delay_log);
-    cmd.AddValue("size", "Description for Cache Size", size);
+    options.AddValues(cmd);
+    options.AddOutputValues(cmd);
+    cmd.AddValue("size", "Description for Cache Size", options.size);
+    cmd.AddValue("decisionCache", "Reuse selectFIB decisions within a mobility epoch", options.decisionCache);
+    cmd.AddValue("beaconInterval", "Seconds between neighbor beacons, 0 disables beacons", options.beaconInterval);
 
     // 解析命令行参数
-    cmd.Parse(argc, argv);
-
-    std::vector<int> consumers = parseList(consumers_list);
-    std::vector<int> producers = parseList(producers_list);
+    options.Parse(cmd, argc, argv);
 
-    return ns3::main(num, consumers, producers, popularity, rate, time, trace, delay_log, size);
+    return ns3::main(options);
 }
\ No newline at end of file
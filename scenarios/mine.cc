@@ -4,6 +4,14 @@
 
 #include "annotated-topology-reader-m.hpp"
 #include "generic-link-service-m.hpp"
+#include "range-culled-wifi-channel.hpp"
+#include "unit-disk-net-device.hpp"
+#include "run-report.hpp"
+#include "memory-report.hpp"
+#include "airtime-report.hpp"
+#include "hop-tracer.hpp"
+#include "steady-state-monitor.hpp"
+#include "scenario-options.hpp"
 
 #include "ns3/constant-velocity-mobility-model.h"
 #include "ns3/core-module.h"
@@ -42,28 +50,28 @@ NS_LOG_COMPONENT_DEFINE("WifiSimpleOcb");
 
 namespace ns3
 {
-	int main(int num, vector<int> consumers, vector<int> producers, double popularity, double rate, double time, string trace, string delay_log)
+	int main(const ScenarioOptions& options)
 	{
-		uint32_t N = num;
-		vector<int> ConsumerId = consumers;
-		vector<int> ProducerId = producers;
-		double Popularity = popularity;
-		double Rate = rate;
-		double Time = time;
-		string MobilityTrace = trace;
-		string DelayTrace = delay_log;
+		uint32_t N = options.num;
+		vector<int> ConsumerId = options.consumers;
+		vector<int> ProducerId = options.producers;
+		double Popularity = options.popularity;
+		double Rate = options.rate;
+		double Time = options.time;
+		string MobilityTrace = options.trace;
+		string DelayTrace = options.delayLog;
 
 		NodeContainer nodes;
 		nodes.Create(N);
 
 		std::string phyMode("OfdmRate6Mbps");
-		YansWifiPhyHelper wifiPhy;
-		YansWifiChannelHelper channelHelper = YansWifiChannelHelper::Default();
-		Ptr<YansWifiChannel> channel = channelHelper.Create();
+		RangeCulledYansWifiPhyHelper wifiPhy;
+		Ptr<RangeCulledWifiChannel> channel = CreateObject<RangeCulledWifiChannel>();
+		channel->SetAttribute("EnableCulling", BooleanValue(options.culling));
 		Ptr<LogDistancePropagationLossModel> lossModel = CreateObject<LogDistancePropagationLossModel>();
 		lossModel->SetReference(1, 40.00);
 		lossModel->SetPathLossExponent(1);
-		channel->SetPropagationLossModel(lossModel);
+		channel->SetPropagationModels(lossModel, CreateObject<ConstantSpeedPropagationDelayModel>());
 		wifiPhy.Set("TxPowerStart", DoubleValue(0));
 		wifiPhy.Set("TxPowerEnd", DoubleValue(0));
 		wifiPhy.SetChannel(channel);
@@ -76,7 +84,9 @@ namespace ns3
 										   "DataMode", StringValue(phyMode),
 										   "ControlMode", StringValue(phyMode));
 
-		NetDeviceContainer devices = wifi80211p.Install(wifiPhy, wifi80211pMac, nodes);
+		// fast=true时用单位圆盘模型代替802.11p, 用于快速筛选策略
+		UnitDiskHelper unitDisk;
+		NetDeviceContainer devices = options.fast ? unitDisk.Install(nodes) : wifi80211p.Install(wifiPhy, wifi80211pMac, nodes);
 		Ns2MobilityHelper ns2Mobiity = Ns2MobilityHelper(MobilityTrace);
 		ns2Mobiity.Install();
 
@@ -86,6 +96,8 @@ namespace ns3
 		ndn::StackHelper ndnHelper;
 		ndnHelper.AddFaceCreateCallback(WifiNetDevice::GetTypeId(),
 										MakeCallback(&WifiApStaDeviceCallback));
+		ndnHelper.AddFaceCreateCallback(UnitDiskNetDevice::GetTypeId(),
+										MakeCallback(&WifiApStaDeviceCallback));
 
 		ndnHelper.setCsSize(20);
 		ndnHelper.InstallAll();
@@ -136,54 +148,50 @@ namespace ns3
 		ndn::AppDelayTracer::Install(consumerContainer, DelayTrace);
 		// ndn::CsTracer::InstallAll("results/cs_prfs.log", MilliSeconds(1000));
 
+		RunReport runReport(options.report);
+		runReport.SetParameter("strategy", "MINE");
+		runReport.SetParameter("num", N);
+		runReport.SetParameter("time", Time);
+		runReport.SetParameter("trace", MobilityTrace);
+		runReport.SetParameter("fast", options.fast);
+		runReport.SetProfileOutput(options.profile, options.tsc);
+		runReport.Start();
+		MemoryReport memoryReport(options.memory, Seconds(options.memoryInterval));
+		memoryReport.Start();
+		AirtimeReport airtimeReport(options.airtime, Seconds(options.airtimeInterval));
+		airtimeReport.Start();
+		HopTracer hopTracer(options.hops, "MINE", options.hopSampling);
+		hopTracer.Start();
+		// steady>0时每steady秒统计一次ISR/ISD, 稳定或崩溃后提前结束
+		SteadyStateMonitor steadyMonitor(Rate * consumerContainer.GetN(), Seconds(options.steady));
+		steadyMonitor.Start();
+
 		Simulator::Stop(Seconds(Time));
 		Simulator::Run();
+		steadyMonitor.Finish();
+		runReport.SetParameter("stop_reason", steadyMonitor.GetStopReason());
+		runReport.SetParameter("stop_time", Simulator::Now().GetSeconds());
+		runReport.Finish();
+		memoryReport.Finish();
+		airtimeReport.Finish();
+		hopTracer.Finish();
 		Simulator::Destroy();
 		std::cout << "end";
 		return 0;
 	}
 }
 
-// 解析字符串形式的列表参数，返回vector<int>
-std::vector<int> parseList(const std::string &str)
-{
-	std::vector<int> result;
-	std::istringstream ss(str); // 去掉首尾的方括号
-	char delimiter;
-	int number;
-	while (ss >> number)
-	{
-		result.push_back(number);
-		ss >> delimiter; // 读取逗号
-	}
-	return result;
-}
 int main(int argc, char *argv[])
 {
 	// 创建命令行对象
 	ns3::CommandLine cmd;
-	int num;
-	string consumers_list;
-	string producers_list;
-	double rate;
-	double time;
-	double popularity;
-	string trace, log, delay_log;
+	ns3::ScenarioOptions options;
 	// 添加自定义参数
-	cmd.AddValue("num", "Description for number of nodes parameter", num);
-	cmd.AddValue("consumers", "List of consumer nodes", consumers_list);
-	cmd.AddValue("producers", "List of producer nodes", producers_list);
-	cmd.AddValue("popularity", "Popularity of Zipf", popularity);
-	cmd.AddValue("rate", "Description for request rate  parameter", rate);
-	cmd.AddValue("time", "Description for request rate  parameter", time);
-	cmd.AddValue("trace", "Description for mobility trace  parameter", trace);
-	cmd.AddValue("delay_log", "Description for delay log parameter", delay_log);
+	options.AddValues(cmd);
+	options.AddOutputValues(cmd);
 
 	// 解析命令行参数
-	cmd.Parse(argc, argv);
-
-	std::vector<int> consumers = parseList(consumers_list);
-	std::vector<int> producers = parseList(producers_list);
+	options.Parse(cmd, argc, argv);
 
-	return ns3::main(num, consumers, producers, popularity, rate, time, trace, delay_log);
+	return ns3::main(options);
 }
\ No newline at end of file
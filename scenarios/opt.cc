@@ -0,0 +1,209 @@
+#include "ns3/config.h"
+#include "ns3/log.h"
+#include "ns3/command-line.h"
+
+#include "annotated-topology-reader-m.hpp"
+#include "generic-link-service-m.hpp"
+#include "range-culled-wifi-channel.hpp"
+#include "unit-disk-net-device.hpp"
+#include "run-report.hpp"
+#include "memory-report.hpp"
+#include "airtime-report.hpp"
+#include "hop-tracer.hpp"
+#include "steady-state-monitor.hpp"
+#include "scenario-options.hpp"
+#include "decision-cache.hpp"
+
+#include "ns3/constant-velocity-mobility-model.h"
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/node.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/position-allocator.h"
+#include "ns3/propagation-loss-model.h"
+#include "ns3/ptr.h"
+#include "ns3/qos-txop.h"
+#include "ns3/rectangle.h"
+#include "ns3/ssid.h"
+#include "ns3/wifi-net-device.h"
+#include "ns3/yans-wifi-helper.h"
+#include "ns3/wifi-phy-state-helper.h"
+#include "ns3/ocb-wifi-mac.h"
+#include "ns3/wifi-80211p-helper.h"
+#include "ns3/wave-mac-helper.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/mobility-model.h"
+#include "ns3/ns2-mobility-helper.h"
+#include "ns3/ndnSIM-module.h"
+#include "ns3/ndnSIM/NFD/daemon/face/face-common.hpp"
+#include "ns3/ndnSIM/apps/ndn-producer.hpp"
+#include "ns3/ndnSIM/helper/ndn-link-control-helper.hpp"
+#include "ns3/ndnSIM/helper/ndn-global-routing-helper.hpp"
+#include "ns3/ndnSIM/model/ndn-l3-protocol.hpp"
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+#include "ns3/ndnSIM/utils/tracers/ndn-app-delay-tracer.hpp"
+#include "ns3/ndnSIM/utils/tracers/ndn-cs-tracer.hpp"
+
+#include <iostream>
+#include <random>
+
+NS_LOG_COMPONENT_DEFINE("WifiSimpleOcb");
+
+namespace ns3 {
+    int main(const ScenarioOptions& options) {
+        uint32_t N = options.num;
+        vector<int> ConsumerId = options.consumers;
+        vector<int> ProducerId = options.producers;
+        double Popularity = options.popularity;
+        double Rate = options.rate;
+        double Time = options.time;
+        string MobilityTrace = options.trace;
+        string DelayTrace = options.delayLog;
+
+        NodeContainer nodes;
+        nodes.Create(N);
+
+        std::string phyMode("OfdmRate6Mbps");
+        RangeCulledYansWifiPhyHelper wifiPhy;
+        Ptr<RangeCulledWifiChannel> channel = CreateObject<RangeCulledWifiChannel>();
+        channel->SetAttribute("EnableCulling", BooleanValue(options.culling));
+        Ptr<LogDistancePropagationLossModel> lossModel = CreateObject<LogDistancePropagationLossModel>();
+        lossModel->SetReference(1, 40.00);
+        lossModel->SetPathLossExponent(1);
+        channel->SetPropagationModels(lossModel, CreateObject<ConstantSpeedPropagationDelayModel>());
+        wifiPhy.Set("TxPowerStart", DoubleValue(0));
+        wifiPhy.Set("TxPowerEnd", DoubleValue(0));
+        wifiPhy.SetChannel(channel);
+        // ns-3 supports generate a pcap trace
+        wifiPhy.SetPcapDataLinkType(WifiPhyHelper::DLT_IEEE802_11);
+        NqosWaveMacHelper wifi80211pMac = NqosWaveMacHelper::Default();
+        Wifi80211pHelper wifi80211p = Wifi80211pHelper::Default();
+
+        wifi80211p.SetRemoteStationManager("ns3::ConstantRateWifiManager",
+            "DataMode", StringValue(phyMode),
+            "ControlMode", StringValue(phyMode));
+
+        // fast=true时用单位圆盘模型代替802.11p, 用于快速筛选策略
+        UnitDiskHelper unitDisk;
+        NetDeviceContainer devices = options.fast ? unitDisk.Install(nodes) : wifi80211p.Install(wifiPhy, wifi80211pMac, nodes);
+        Ns2MobilityHelper ns2Mobiity = Ns2MobilityHelper(MobilityTrace);
+        ns2Mobiity.Install();
+
+        // Install NDN stack on all nodes
+        extern shared_ptr<::nfd::Face> WifiApStaDeviceCallback(
+            Ptr<Node> node, Ptr<ndn::L3Protocol> ndn, Ptr<NetDevice> device);
+        ndn::StackHelper ndnHelper;
+        ndnHelper.AddFaceCreateCallback(WifiNetDevice::GetTypeId(),
+            MakeCallback(&WifiApStaDeviceCallback));
+        ndnHelper.AddFaceCreateCallback(UnitDiskNetDevice::GetTypeId(),
+            MakeCallback(&WifiApStaDeviceCallback));
+
+        ndnHelper.setCsSize(20);
+        ndnHelper.InstallAll();
+
+        // 策略实例在StrategyChoiceHelper安装时创建, 需先设置决策缓存选项
+        nfd::fw::DecisionCache::Options decisionCacheOptions;
+        decisionCacheOptions.enabled = options.decisionCache;
+        nfd::fw::DecisionCache::setDefaultOptions(decisionCacheOptions);
+
+        // OPT不接受实例名参数, 给出strategyParams时策略构造会报错
+        ndn::StrategyChoiceHelper::InstallAll("/", "/localhost/nfd/strategy/OPT/%FD%01" + (options.strategyParams.empty() ? "" : "/" + options.strategyParams));
+
+        // Installing Consumer
+        // ndn::AppHelper consumerHelper("ns3::ndn::ConsumerCbr");
+        // consumerHelper.SetAttribute("Frequency", DoubleValue(Rate));
+        // consumerHelper.SetAttribute("Randomize", StringValue("none"));
+        ndn::AppHelper consumerHelper("ns3::ndn::ConsumerZipfMandelbrot");
+        consumerHelper.SetAttribute("Frequency", DoubleValue(Rate));
+        consumerHelper.SetAttribute("NumberOfContents", StringValue("50"));
+        consumerHelper.SetAttribute("q", StringValue("0"));
+        consumerHelper.SetAttribute("s", DoubleValue(Popularity));
+        consumerHelper.SetPrefix("/ustc");
+        NodeContainer consumerContainer;
+        for (auto& id : ConsumerId) {
+            consumerContainer.Add(nodes[id]);
+        }
+        consumerHelper.Install(consumerContainer);
+
+        // Installing Producer
+        ndn::AppHelper producer("ns3::ndn::Producer");
+        producer.SetPrefix("/ustc");
+        producer.SetAttribute("PayloadSize", UintegerValue(1024));
+        NodeContainer producerContainer;
+        for (auto& id : ProducerId) {
+            producerContainer.Add(nodes[id]);
+        }
+        producer.Install(producerContainer);
+
+        // 信标间隔为0时不安装信标, 策略退回到移动模型
+        if (options.beaconInterval > 0) {
+            ndn::AppHelper beaconHelper("ns3::ndn::BeaconApp");
+            beaconHelper.SetAttribute("Interval", TimeValue(Seconds(options.beaconInterval)));
+            beaconHelper.Install(nodes);
+        }
+
+        std::cout << "Trace=" << MobilityTrace << ", Num=" << N << std::endl;
+        std::cout << "Install " << consumerContainer.GetN() << " consumers on Node=";
+        for (auto& consumer : consumerContainer) {
+            std::cout << consumer->GetId() << ", ";
+        }
+        std::cout << " and " << producerContainer.GetN() << " producers on Node=";
+        for (auto& producer : producerContainer) {
+            std::cout << producer->GetId() << ", ";
+        }
+        std::cout << std::endl;
+
+        ndn::AppDelayTracer::Install(consumerContainer, DelayTrace);
+        // ndn::CsTracer::InstallAll("results/cs_prfs.log", MilliSeconds(1000));
+
+        RunReport runReport(options.report);
+        runReport.SetParameter("strategy", "OPT");
+        runReport.SetParameter("num", N);
+        runReport.SetParameter("time", Time);
+        runReport.SetParameter("trace", MobilityTrace);
+        runReport.SetParameter("fast", options.fast);
+        runReport.SetParameter("strategyParams", options.strategyParams);
+        runReport.SetParameter("decisionCache", options.decisionCache);
+        runReport.SetParameter("beaconInterval", options.beaconInterval);
+        runReport.SetProfileOutput(options.profile, options.tsc);
+        runReport.Start();
+        MemoryReport memoryReport(options.memory, Seconds(options.memoryInterval));
+        memoryReport.Start();
+        AirtimeReport airtimeReport(options.airtime, Seconds(options.airtimeInterval));
+        airtimeReport.Start();
+        HopTracer hopTracer(options.hops, "OPT", options.hopSampling);
+        hopTracer.Start();
+        // steady>0时每steady秒统计一次ISR/ISD, 稳定或崩溃后提前结束
+        SteadyStateMonitor steadyMonitor(Rate * consumerContainer.GetN(), Seconds(options.steady));
+        steadyMonitor.Start();
+
+        Simulator::Stop(Seconds(Time));
+        Simulator::Run();
+        steadyMonitor.Finish();
+        runReport.SetParameter("stop_reason", steadyMonitor.GetStopReason());
+        runReport.SetParameter("stop_time", Simulator::Now().GetSeconds());
+        runReport.Finish();
+        memoryReport.Finish();
+        airtimeReport.Finish();
+        hopTracer.Finish();
+        Simulator::Destroy();
+        std::cout << "end";
+        return 0;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    // 创建命令行对象
+    ns3::CommandLine cmd;
+    ns3::ScenarioOptions options;
+    // 添加自定义参数
+    options.AddValues(cmd);
+    options.AddOutputValues(cmd);
+    cmd.AddValue("decisionCache", "Reuse selectFIB decisions within a mobility epoch", options.decisionCache);
+    cmd.AddValue("beaconInterval", "Seconds between neighbor beacons, 0 disables beacons", options.beaconInterval);
+
+    // 解析命令行参数
+    options.Parse(cmd, argc, argv);
+
+    return ns3::main(options);
+}
\ No newline at end of file
@@ -0,0 +1,236 @@
+#include "ns3/config.h"
+#include "ns3/log.h"
+#include "ns3/command-line.h"
+
+#include "annotated-topology-reader-m.hpp"
+#include "generic-link-service-m.hpp"
+#include "range-culled-wifi-channel.hpp"
+#include "unit-disk-net-device.hpp"
+#include "zygote.hpp"
+#include "run-report.hpp"
+#include "memory-report.hpp"
+#include "airtime-report.hpp"
+#include "hop-tracer.hpp"
+#include "steady-state-monitor.hpp"
+#include "scenario-options.hpp"
+
+#include "ns3/constant-velocity-mobility-model.h"
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/node.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/position-allocator.h"
+#include "ns3/propagation-loss-model.h"
+#include "ns3/ptr.h"
+#include "ns3/qos-txop.h"
+#include "ns3/rectangle.h"
+#include "ns3/ssid.h"
+#include "ns3/wifi-net-device.h"
+#include "ns3/yans-wifi-helper.h"
+#include "ns3/wifi-phy-state-helper.h"
+#include "ns3/ocb-wifi-mac.h"
+#include "ns3/wifi-80211p-helper.h"
+#include "ns3/wave-mac-helper.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/mobility-model.h"
+#include "ns3/ns2-mobility-helper.h"
+#include "ns3/ndnSIM-module.h"
+#include "ns3/ndnSIM/NFD/daemon/face/face-common.hpp"
+#include "ns3/ndnSIM/apps/ndn-producer.hpp"
+#include "ns3/ndnSIM/helper/ndn-link-control-helper.hpp"
+#include "ns3/ndnSIM/helper/ndn-global-routing-helper.hpp"
+#include "ns3/ndnSIM/model/ndn-l3-protocol.hpp"
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+#include "ns3/ndnSIM/utils/tracers/ndn-app-delay-tracer.hpp"
+#include "ns3/ndnSIM/utils/tracers/ndn-cs-tracer.hpp"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+
+NS_LOG_COMPONENT_DEFINE("ZygoteScenario");
+
+namespace ns3
+{
+	// zygote自己的参数: points文件、同时运行的子进程数, 以及每个点是否写<output prefix>.json等输出
+	struct ZygoteOptions
+	{
+		string points;
+		uint32_t jobs = 1;
+		bool report = false;
+		bool memory = false;
+		bool airtime = false;
+		bool hops = false;
+	};
+
+	/* 在一个进程中完成与策略、种子无关的部署(节点、802.11p/单位圆盘设备、移动轨迹、NDN协议栈),
+	 * 再为points文件中的每个(策略, 种子, 参数)点fork一个子进程, 子进程只安装策略与应用并运行.
+	 * Face由WifiApStaDeviceBroadcastCallback创建, 可运行VNDN/DASB/LISIC/LSIF/PRFS/DIFS策略 */
+	int main(const ScenarioOptions& options, const ZygoteOptions& zygote)
+	{
+		uint32_t N = options.num;
+		vector<int> ConsumerId = options.consumers;
+		vector<int> ProducerId = options.producers;
+		double Time = options.time;
+		string MobilityTrace = options.trace;
+		std::vector<Zygote::Point> pointList = Zygote::ReadPoints(zygote.points);
+
+		auto setupStart = std::chrono::steady_clock::now();
+		NodeContainer nodes;
+		nodes.Create(N);
+
+		std::string phyMode("OfdmRate6Mbps");
+		RangeCulledYansWifiPhyHelper wifiPhy;
+		Ptr<RangeCulledWifiChannel> channel = CreateObject<RangeCulledWifiChannel>();
+		channel->SetAttribute("EnableCulling", BooleanValue(options.culling));
+		Ptr<LogDistancePropagationLossModel> lossModel = CreateObject<LogDistancePropagationLossModel>();
+		lossModel->SetReference(1, 40.00);
+		lossModel->SetPathLossExponent(1);
+		channel->SetPropagationModels(lossModel, CreateObject<ConstantSpeedPropagationDelayModel>());
+		wifiPhy.Set("TxPowerStart", DoubleValue(0));
+		wifiPhy.Set("TxPowerEnd", DoubleValue(0));
+		wifiPhy.SetChannel(channel);
+		NqosWaveMacHelper wifi80211pMac = NqosWaveMacHelper::Default();
+		Wifi80211pHelper wifi80211p = Wifi80211pHelper::Default();
+
+		wifi80211p.SetRemoteStationManager("ns3::ConstantRateWifiManager",
+										   "DataMode", StringValue(phyMode),
+										   "ControlMode", StringValue(phyMode));
+
+		UnitDiskHelper unitDisk;
+		NetDeviceContainer devices = options.fast ? unitDisk.Install(nodes) : wifi80211p.Install(wifiPhy, wifi80211pMac, nodes);
+		Ns2MobilityHelper ns2Mobiity = Ns2MobilityHelper(MobilityTrace);
+		ns2Mobiity.Install();
+
+		// Install NDN stack on all nodes
+		extern shared_ptr<::nfd::Face> WifiApStaDeviceBroadcastCallback(
+			Ptr<Node> node, Ptr<ndn::L3Protocol> ndn, Ptr<NetDevice> device);
+		ndn::StackHelper ndnHelper;
+		ndnHelper.AddFaceCreateCallback(WifiNetDevice::GetTypeId(),
+										MakeCallback(&WifiApStaDeviceBroadcastCallback));
+		ndnHelper.AddFaceCreateCallback(UnitDiskNetDevice::GetTypeId(),
+										MakeCallback(&WifiApStaDeviceBroadcastCallback));
+
+		ndnHelper.setCsSize(20);
+		ndnHelper.InstallAll();
+		double setupSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - setupStart).count();
+		std::cout << "Trace=" << MobilityTrace << ", Num=" << N << ", setup " << setupSeconds << " s, "
+				  << pointList.size() << " points" << std::endl;
+
+		uint32_t failed = Zygote::Run(pointList, zygote.jobs, [&](const Zygote::Point &point) {
+			RngSeedManager::SetRun(point.run);
+			// 802.11p退避和单位圆盘丢包的随机变量在fork前创建, 使用的是zygote的run;
+			// 重新分配流号, 使其按本点的run重建
+			int64_t streams = options.fast ? unitDisk.AssignStreams(devices, 0) : wifi80211p.AssignStreams(devices, 0);
+			NS_ABORT_MSG_IF(streams == 0, "no random stream of the devices was reassigned for run " << point.run);
+			// 接在设备之后的流, 同样按run重建; test/zygote.py检查不同run的取值互不相同
+			Ptr<UniformRandomVariable> rngCheck = CreateObject<UniformRandomVariable>();
+			rngCheck->SetStream(streams);
+			std::cout << "RngCheck=" << std::setprecision(17) << rngCheck->GetValue() << std::setprecision(6) << std::endl;
+			double Popularity = options.popularity;
+			double Rate = options.rate;
+			string strategyParams = options.strategyParams;
+			for (auto &param : point.params)
+			{
+				// popularity/rate为应用参数, params为策略实例名参数(如params=pth~0.9/t~2, 缺省为--strategyParams),
+				// ns3::开头的为属性默认值, 作用于子进程中创建的对象
+				if (param.first == "popularity")
+					Popularity = std::stod(param.second);
+				else if (param.first == "rate")
+					Rate = std::stod(param.second);
+				else if (param.first == "params")
+					strategyParams = param.second;
+				else
+					Config::SetDefault(param.first, StringValue(param.second));
+			}
+
+			ndn::StrategyChoiceHelper::InstallAll("/", "/localhost/nfd/strategy/" + point.strategy + "/%FD%01" + (strategyParams.empty() ? "" : "/" + strategyParams));
+
+			ndn::AppHelper consumerHelper("ns3::ndn::ConsumerZipfMandelbrot");
+			consumerHelper.SetAttribute("Frequency", DoubleValue(Rate));
+			consumerHelper.SetAttribute("NumberOfContents", StringValue("50"));
+			consumerHelper.SetAttribute("q", StringValue("0"));
+			consumerHelper.SetAttribute("s", DoubleValue(Popularity));
+			consumerHelper.SetPrefix("/ustc");
+			NodeContainer consumerContainer;
+			for (auto &id : ConsumerId)
+			{
+				consumerContainer.Add(nodes[id]);
+			}
+			consumerHelper.Install(consumerContainer);
+
+			ndn::AppHelper producer("ns3::ndn::Producer");
+			producer.SetPrefix("/ustc");
+			producer.SetAttribute("PayloadSize", UintegerValue(1024));
+			NodeContainer producerContainer;
+			for (auto &id : ProducerId)
+			{
+				producerContainer.Add(nodes[id]);
+			}
+			producer.Install(producerContainer);
+
+			std::cout << "Trace=" << MobilityTrace << ", Num=" << N << ", Strategy=" << point.strategy
+					  << ", Run=" << point.run << std::endl;
+			ndn::AppDelayTracer::Install(consumerContainer, point.output + ".delay");
+
+			RunReport runReport(zygote.report ? point.output + ".json" : "");
+			runReport.SetParameter("strategy", point.strategy);
+			runReport.SetParameter("run", point.run);
+			runReport.SetParameter("num", N);
+			runReport.SetParameter("time", Time);
+			runReport.SetParameter("trace", MobilityTrace);
+			runReport.SetParameter("fast", options.fast);
+			runReport.SetParameter("popularity", Popularity);
+			runReport.SetParameter("rate", Rate);
+			runReport.SetParameter("strategyParams", strategyParams);
+			runReport.SetParameter("setup_s", setupSeconds);
+			runReport.Start();
+			MemoryReport memoryReport(zygote.memory ? point.output + ".memory.csv" : "", Seconds(options.memoryInterval));
+			memoryReport.Start();
+			AirtimeReport airtimeReport(zygote.airtime ? point.output + ".airtime.csv" : "", Seconds(options.airtimeInterval));
+			airtimeReport.Start();
+			HopTracer hopTracer(zygote.hops ? point.output + ".hops.csv" : "", point.strategy, options.hopSampling);
+			hopTracer.Start();
+			// steady>0时每steady秒统计一次ISR/ISD, 稳定或崩溃后提前结束
+			SteadyStateMonitor steadyMonitor(Rate * consumerContainer.GetN(), Seconds(options.steady));
+			steadyMonitor.Start();
+
+			Simulator::Stop(Seconds(Time));
+			Simulator::Run();
+			steadyMonitor.Finish();
+			runReport.SetParameter("stop_reason", steadyMonitor.GetStopReason());
+			runReport.SetParameter("stop_time", Simulator::Now().GetSeconds());
+			runReport.Finish();
+			memoryReport.Finish();
+			airtimeReport.Finish();
+			hopTracer.Finish();
+			Simulator::Destroy();
+			std::cout << "end";
+			return 0;
+		});
+		Simulator::Destroy();
+		return failed == 0 ? 0 : 1;
+	}
+}
+
+int main(int argc, char *argv[])
+{
+	// 创建命令行对象
+	ns3::CommandLine cmd;
+	ns3::ScenarioOptions options;
+	ns3::ZygoteOptions zygote;
+	// 添加自定义参数, 输出文件由各点的output前缀决定, 不注册AddOutputValues中的路径参数
+	options.AddValues(cmd);
+	cmd.AddValue("points", "File with one \"<strategy> <run> <output prefix> [key=value ...]\" per line", zygote.points);
+	cmd.AddValue("jobs", "Number of children running at the same time", zygote.jobs);
+	cmd.AddValue("report", "Write a JSON performance report to <output prefix>.json", zygote.report);
+	cmd.AddValue("memory", "Write memory samples to <output prefix>.memory.csv", zygote.memory);
+	cmd.AddValue("airtime", "Write per-region airtime every interval to <output prefix>.airtime.csv", zygote.airtime);
+	cmd.AddValue("hops", "Write the per-hop latency breakdown to <output prefix>.hops.csv", zygote.hops);
+
+	// 解析命令行参数
+	options.Parse(cmd, argc, argv);
+
+	return ns3::main(options, zygote);
+}
\ No newline at end of file
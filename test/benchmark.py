@@ -0,0 +1,139 @@
+import argparse
+import json
+import os
+import random
+import subprocess
+import time
+
+# 在合成高速公路场景下测量各转发策略的性能随车辆规模的变化
+
+# mine.cc安装的MINE策略不在extensions/中, 无法运行, 因此不参与比较
+STRATEGY_VALUES = ['vndn', 'dasb', 'lisic', 'lsif', 'prfs', 'difs', 'opt', 'ccaf', 'mupf']
+SIZES = [60, 120, 250, 500, 1000, 2000]
+RATE = 10.0
+TIME = 10.0
+POPULARITY = 0.7
+
+DENSITY = 20        # 车辆/km
+LANES = 4           # 双向各两车道
+LANE_WIDTH = 4.0
+SPEED_MIN = 20.0    # m/s
+SPEED_MAX = 33.0
+
+
+def generateHighwayTrace(path, num, seed=1):
+    """生成ns-2格式的高速公路轨迹: 车辆均匀分布在各车道上, 以恒定速度驶向路段终点"""
+    rng = random.Random(seed)
+    length = max(1000.0, num / DENSITY * 1000.0)
+    lines = []
+    for i in range(num):
+        lane = i % LANES
+        x = rng.uniform(0, length)
+        y = lane * LANE_WIDTH
+        speed = rng.uniform(SPEED_MIN, SPEED_MAX)
+        # 前两条车道向东行驶, 后两条向西
+        dest = length + 10 * SPEED_MAX * TIME if lane < LANES // 2 else -10 * SPEED_MAX * TIME
+        lines.append(f'$node_({i}) set X_ {x:.2f}')
+        lines.append(f'$node_({i}) set Y_ {y:.2f}')
+        lines.append(f'$node_({i}) set Z_ 0.0')
+        lines.append(f'$ns_ at 0.0 "$node_({i}) setdest {dest:.2f} {y:.2f} {speed:.2f}"')
+    os.makedirs(os.path.dirname(path), exist_ok=True)
+    with open(path, 'w') as file:
+        file.write('\n'.join(lines) + '\n')
+
+
+def runBenchmark(strategy, num, trace, folder, timeout, logging):
+    report = os.path.join(folder, f'{strategy}-n{num}.json')
+    logfile = os.path.join(folder, f'{strategy}-n{num}.log')
+    delayfile = os.path.join(folder, f'{strategy}-n{num}.delay')
+    memoryfile = os.path.join(folder, f'{strategy}-n{num}.memory.csv')
+    env = dict(os.environ)
+    if logging:
+        env['NS_LOG'] = f'ndn-cxx.nfd.{strategy.upper()}:ndn.Producer'
+    else:
+        env.pop('NS_LOG', None)
+    command = (f'./waf --run "{strategy} --num={num} --consumers=0 --producers={num - 1} '
+               f'--popularity={POPULARITY} --rate={RATE} --time={TIME} --trace={trace} '
+               f'--delay_log={delayfile} --report={report} --memory={memoryfile}"')
+    print(f"{strategy} n={num} 开始")
+    start = time.time()
+    status = 'ok'
+    try:
+        with open(logfile, 'w') as log:
+            code = subprocess.call(command, shell=True, stdout=log, stderr=subprocess.STDOUT,
+                                   env=env, timeout=timeout)
+        if code != 0 or not os.path.exists(report):
+            status = f'failed ({code})'
+    except subprocess.TimeoutExpired:
+        status = 'timeout'
+    result = {'strategy': strategy, 'num': num, 'status': status,
+              'elapsed_s': round(time.time() - start, 3)}
+    if status == 'ok':
+        with open(report) as file:
+            result.update(json.load(file))
+        result['memory_peak'] = readMemoryPeak(memoryfile + '.peak.csv')
+    print(f"{strategy} n={num} 结束: {status}")
+    return result
+
+
+def readMemoryPeak(path):
+    """读取各子系统的内存峰值: {subsystem: {entries, bytes}}"""
+    peaks = {}
+    if not os.path.exists(path):
+        return peaks
+    with open(path) as file:
+        next(file)
+        for line in file:
+            subsystem, entries, bytes_, _, _ = line.strip().split(',')
+            peaks[subsystem] = {'entries': int(entries), 'bytes': int(bytes_)}
+    return peaks
+
+
+def interestCost(result):
+    """每个Interest在策略回调中花费的平均时间(us): 所有回调的总时间除以afterReceiveInterest的调用次数.
+    total_s已是不含嵌套回调的自身时间; 嵌套在其他回调中的afterReceiveInterest(如发给本节点应用)不算新的Interest"""
+    callbacks = result.get('callbacks', [])
+    interests = sum(c['calls'] - c.get('nested_calls', 0) for c in callbacks
+                    if c['trigger'] == 'afterReceiveInterest')
+    if interests == 0:
+        return ''
+    return sum(c['total_s'] for c in callbacks) / interests * 1e6
+
+
+def writeSummary(results, folder):
+    with open(os.path.join(folder, 'report.json'), 'w') as file:
+        json.dump(results, file, indent=2)
+    # 各子系统内存峰值随规模的变化, 用于找出超线性增长的表
+    with open(os.path.join(folder, 'memory.csv'), 'w') as file:
+        file.write('strategy,num,subsystem,peak_entries,peak_bytes\n')
+        for r in results:
+            for subsystem, peak in sorted(r.get('memory_peak', {}).items()):
+                file.write(f"{r['strategy']},{r['num']},{subsystem},{peak['entries']},{peak['bytes']}\n")
+    with open(os.path.join(folder, 'summary.csv'), 'w') as file:
+        file.write('strategy,num,status,wall_clock_s,events,events_per_s,peak_rss_kb,strategy_s,interest_us\n')
+        for r in results:
+            strategyTime = sum(c['total_s'] for c in r.get('callbacks', []))
+            file.write(f"{r['strategy']},{r['num']},{r['status']},{r.get('wall_clock_s', '')},"
+                       f"{r.get('events', '')},{r.get('events_per_s', '')},"
+                       f"{r.get('peak_rss_kb', '')},{strategyTime},{interestCost(r)}\n")
+
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(description='VANET strategy scaling benchmark')
+    parser.add_argument('--strategies', nargs='+', default=STRATEGY_VALUES)
+    parser.add_argument('--sizes', nargs='+', type=int, default=SIZES)
+    parser.add_argument('--output', default='test/results/benchmark')
+    parser.add_argument('--timeout', type=int, default=6 * 3600, help='每次仿真的超时时间(s)')
+    parser.add_argument('--logging', action='store_true', help='与test.py一样打开策略日志')
+    args = parser.parse_args()
+
+    os.makedirs(args.output, exist_ok=True)
+    results = []
+    for num in args.sizes:
+        trace = f'mobility-traces/synthetic/highway-n{num}.tcl'
+        if not os.path.exists(trace):
+            generateHighwayTrace(trace, num)
+        for strategy in args.strategies:
+            results.append(runBenchmark(strategy, num, trace, args.output, args.timeout, args.logging))
+            writeSummary(results, args.output)
+    print("benchmark完成: " + os.path.join(args.output, 'report.json'))
@@ -0,0 +1,96 @@
+import argparse
+import csv
+import os
+import subprocess
+from concurrent.futures import ThreadPoolExecutor
+
+from sweep import RATE, STRATEGY_VALUES, TIME, pointConfig
+
+# 逐跳时延分解: 各策略以--hops运行, 按名字哈希抽样Interest/Data, 得到每一跳的
+# strategy(收到到发出, 其中defer为策略定时器)、mac(入队到开始发送)、air(发送到下一跳收到)
+# 与消费者重传等待retx_wait, 汇总为"组成部分 × 策略"的平均时延表
+
+COMPONENTS = ['strategy', 'defer', 'mac', 'air', 'retx_wait', 'cancelled']
+
+
+def runOnce(strategy, args, seed):
+    trace, num, consumers, producers, popularity = pointConfig(args.scenario, args.indicator)
+    folder = os.path.join('test', 'logs', 'hops', args.scenario, strategy)
+    os.makedirs(folder, exist_ok=True)
+    prefix = os.path.join(folder, f'{args.indicator}-s{args.sampling}-run{seed}')
+    hopfile = prefix + '.hops.csv'
+    if not os.path.exists(hopfile):
+        command = [f'build/{strategy}', f'--num={num}', f'--consumers={consumers}', f'--producers={producers}',
+                   f'--popularity={popularity}', f'--rate={RATE}', f'--time={args.time}', f'--trace={trace}',
+                   f'--delay_log={prefix}.delay', f'--RngRun={seed}', f'--hops={hopfile}',
+                   f'--hopSampling={args.sampling}']
+        with open(prefix + '.log', 'w') as log:
+            subprocess.call(command, stdout=log, stderr=subprocess.STDOUT)
+    if not os.path.exists(hopfile):
+        print(f"{strategy} run{seed}: 没有生成{hopfile}")
+        return []
+    with open(hopfile) as file:
+        return list(csv.DictReader(file))
+
+
+def merge(rows):
+    """多个种子的同一(策略, 报文, 组成部分): 样本数相加, 时延按样本数加权平均.
+    各种子的分位数不能这样合并, 只保留在每个种子的.hops.csv中"""
+    merged = {}
+    for row in rows:
+        key = (row['strategy'], row['packet'], row['component'])
+        samples = int(row['samples'])
+        entry = merged.setdefault(key, {'samples': 0, 'mean_ms': 0.0})
+        entry['samples'] += samples
+        if row['mean_ms'] == '':
+            continue
+        entry['mean_ms'] += float(row['mean_ms']) * samples
+    for key, entry in merged.items():
+        if key[2] != 'cancelled' and entry['samples'] > 0:
+            entry['mean_ms'] = round(entry['mean_ms'] / entry['samples'], 4)
+    return merged
+
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(description='Per-hop latency breakdown per strategy')
+    parser.add_argument('--strategies', nargs='+', default=STRATEGY_VALUES)
+    parser.add_argument('--scenario', default='1_Num')
+    parser.add_argument('--indicator', type=float, default=100)
+    parser.add_argument('--time', type=float, default=TIME)
+    parser.add_argument('--sampling', type=int, default=16, help='每多少个Interest/Data抽样一个')
+    parser.add_argument('--seeds', type=int, default=1)
+    parser.add_argument('--jobs', type=int, default=os.cpu_count())
+    parser.add_argument('--output', default='test/results/hops')
+    args = parser.parse_args()
+    if args.scenario != '3_Popularity':
+        args.indicator = int(args.indicator)
+
+    subprocess.call('./waf', shell=True)
+    with ThreadPoolExecutor(max_workers=args.jobs) as pool:
+        futures = [pool.submit(runOnce, strategy, args, seed)
+                   for strategy in args.strategies for seed in range(1, args.seeds + 1)]
+        merged = merge(row for future in futures for row in future.result())
+
+    os.makedirs(args.output, exist_ok=True)
+    output = os.path.join(args.output, f'{args.scenario}-{args.indicator}.csv')
+    with open(output, 'w', newline='') as file:
+        writer = csv.writer(file)
+        writer.writerow(['strategy', 'packet', 'component', 'samples', 'mean_ms'])
+        for (strategy, packet, component), entry in sorted(merged.items()):
+            writer.writerow([strategy, packet, component, entry['samples'], entry['mean_ms']])
+
+    # 每跳平均时延(ms), cancelled为被抑制/取消的延迟转发数
+    strategies = sorted({key[0] for key in merged})
+    print('packet,component,' + ','.join(strategies))
+    for packet in ['interest', 'data']:
+        for component in COMPONENTS:
+            values = []
+            for strategy in strategies:
+                entry = merged.get((strategy, packet, component))
+                if entry is None:
+                    values.append('')
+                else:
+                    values.append(str(entry['samples'] if component == 'cancelled' else entry['mean_ms']))
+            if any(values):
+                print(f'{packet},{component},' + ','.join(values))
+    print("结果: " + output)
@@ -0,0 +1,62 @@
+import glob
+import os
+
+# result.py、calibrate.py、sweep.py、zygote.py、tune.py共用的指标计算
+
+RESULTS_VALUES = ['FIP', 'FDP', 'ISD', 'ISR']
+
+
+def lineTime(line):
+    """NS_LOG行首的仿真时间"+<t>s", 没有时间前缀时返回None"""
+    if not line.startswith('+'):
+        return None
+    try:
+        return float(line[1:line.index('s')])
+    except ValueError:
+        return None
+
+
+def calMetric(logfile, delayfile, num, rate, time):
+    """[FIP, FDP, ISD, ISR], 日志未以end结尾时返回None.
+    MPI运行时各进程的时延日志为<delayfile>.rank<k>, 一并读取.
+    打开--steady时SteadyStateMonitor输出预热窗口, 预热期间的包不计入, 各指标按预热之后的仿真时长归一化,
+    提前结束的运行按实际仿真时长归一化; FIP/FDP再折算到time"""
+    logs = open(logfile, 'r').readlines()
+    # 各MPI进程都输出不带换行的end, 最后一行可能是endend
+    if len(logs) == 0 or not logs[-1].endswith("end"):
+        return None
+    warmup = 0
+    stop = time
+    for line in logs:
+        if line.startswith("Warm-up until "):
+            warmup = float(line.split()[2])
+        if line.startswith("Stopped at "):
+            stop = float(line.split()[2])
+    # 仿真时长不超过一个窗口时没有预热之后的部分, 按整段计算
+    if warmup >= stop:
+        warmup = 0
+    fip_num = fdp_num = 0
+    for line in logs:
+        if "localhost" in line:
+            continue
+        t = lineTime(line)
+        if t is not None and t < warmup:
+            continue
+        if "do Send Interest" in line:
+            fip_num += 1
+        if "do Send Data" in line:
+            fdp_num += 1
+    delay_list = []
+    for path in [delayfile] + sorted(glob.glob(delayfile + '.rank*')):
+        if not os.path.exists(path):
+            continue
+        for line in open(path, 'r').readlines()[1:]:
+            value = line.split("\t")
+            if value[4] == "LastDelay" and value[1] == "0" and float(value[0]) >= warmup:
+                delay_list.append(float(value[5]))
+    measured = stop - warmup
+    fip = round(fip_num * time / measured / num, 4)
+    fdp = round(fdp_num * time / measured / num, 4)
+    if len(delay_list) == 0:
+        return [fip, fdp, 0, 0]
+    return [fip, fdp, round(sum(delay_list) / len(delay_list), 6), round(len(delay_list) / rate / measured, 5)]
@@ -6,46 +6,7 @@ import matplotlib
 matplotlib.use('Agg')
 import matplotlib.pyplot as plt
 
-def calMetric(logfile: str, delayfile: str, num, rate, time): 
-    logs = open(logfile, 'r').readlines()
-    if (logs[-1] != "end"):
-        return [pd.NA]*len(RESULTS_VALUES)
-    fip=fdp=0
-    fip_num=fdp_num=hit_num=sat_by_pro_num = 0
-    for line in logs:
-        if ("localhost" in line):
-            continue
-        if ("do Send Interest" in line):
-            fip_num += 1
-        if ("do Send Data" in line):
-            fdp_num += 1
-        if ("afterContentStoreHit" in line):
-            hit_num += 1
-        if ("responding with Data" in line):
-            sat_by_pro_num += 1
-    fip = round(fip_num/num, 4) 
-    fdp = round(fdp_num/num, 4)
-
-    delay_list = [] 
-    hc_list = []
-    delays = open(delayfile, 'r').readlines()[1:]
-    for line in delays:
-        value = line.split("\t")
-        if ( value[4] == "LastDelay" and value[1] == "0"):
-            delay_list.append(float(value[5]))
-            hc_list.append(float(value[8]))
-    if (len(delay_list) == 0 ):
-        mean_delay = 0
-        mean_hc = 0
-        isr = 0
-        hir = 0
-    else:
-        mean_delay = round (sum(delay_list) / len(delay_list), 6)
-        mean_hc =round( sum(hc_list) / len(hc_list), 2)
-        isr = round(len(delay_list)/rate/time, 5) 
-        # hir = round( hit_num/(fip_num+hit_num), 4) 
-        hir = round((len(delays)/2 - sat_by_pro_num)/ (len(delays)/2), 4)
-    return [fip, fdp, mean_delay, isr]
+from metrics import RESULTS_VALUES, calMetric
 
 def writeResultToFile(scenario:str, indicators:list):
     logs_folder =  'test/logs/' + scenario
@@ -65,7 +26,7 @@ def writeResultToFile(scenario:str, indicators:list):
                 num = indicator
             else:
                 num = 100
-            metric = calMetric(logfile, delayfile, num, RATE, TIME)
+            metric = calMetric(logfile, delayfile, num, RATE, TIME) or [pd.NA]*len(RESULTS_VALUES)
             strategy_metrics = pd.DataFrame({strategy : metric}, index=RESULTS_VALUES)
             try:
                 df = pd.read_csv(resultfile, index_col=0)
@@ -174,7 +135,6 @@ def resultAndPlot2(scenario, indicators):
     plt.savefig(f'test/figures/{scenario}.png')
 
 STRATEGY_VALUES =['vndn', 'dasb', 'lisic', 'prfs', 'ccaf']
-RESULTS_VALUES = ['FIP', 'FDP', 'ISD' , 'ISR']
 RATE = 10.0
 TIME = 20.0
 nums =  [num for num in range(60, 181, 40)]
@@ -0,0 +1,191 @@
+import argparse
+import csv
+import math
+import os
+import subprocess
+from concurrent.futures import FIRST_COMPLETED, ThreadPoolExecutor, wait
+
+from metrics import RESULTS_VALUES, calMetric
+
+# 自适应重复实验: 每个(场景, 取值, 策略)点用不同的RngRun重复运行, 指标以Welford算法在线累计,
+# 当ISR/ISD/FIP的95%置信区间半宽都低于阈值时停止该点, 空闲的进程优先分配给仍然噪声较大的点
+
+STRATEGY_VALUES = ['vndn', 'dasb', 'lisic', 'prfs', 'ccaf']
+TARGET_METRICS = ['ISR', 'ISD', 'FIP']
+RATE = 10.0
+TIME = 20.0
+SCENARIOS = {
+    '1_Num': [num for num in range(60, 181, 40)],
+    '3_Popularity': [round(0.3 + i * 0.3, 1) for i in range(4)],
+    '4_Speed': [x for x in range(80, 111, 10)],
+}
+# 半宽阈值: max(相对阈值*|均值|, 绝对下限), 绝对下限用于均值接近0的指标(如崩溃时的ISR)
+ABSOLUTE_FLOOR = {'ISR': 0.01, 'ISD': 0.005, 'FIP': 0.5}
+# 自由度1..30的t分布0.975分位数, 更大的自由度用1.96
+T95 = [12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+       2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+       2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042]
+
+
+class Welford:
+    """在线均值与方差"""
+
+    def __init__(self):
+        self.n = 0
+        self.mean = 0.0
+        self.m2 = 0.0
+
+    def add(self, x):
+        self.n += 1
+        delta = x - self.mean
+        self.mean += delta / self.n
+        self.m2 += delta * (x - self.mean)
+
+    def halfWidth(self):
+        """均值95%置信区间的半宽, 少于2个样本时为inf"""
+        if self.n < 2:
+            return math.inf
+        t = T95[self.n - 2] if self.n - 1 <= len(T95) else 1.96
+        return t * math.sqrt(self.m2 / (self.n - 1) / self.n)
+
+
+def pointConfig(scenario, indicator):
+    """与test.py中runScenario相同的轨迹与参数: (trace, num, consumers, producers, popularity)"""
+    if scenario == '1_Num':
+        return f'mobility-traces/{scenario}/n{indicator}.tcl', indicator + 1, 0, indicator, 0.7
+    if scenario == '3_Popularity':
+        return 'mobility-traces/1_Num/n100.tcl', 101, 0, 100, indicator
+    return f'mobility-traces/{scenario}/{indicator}.tcl', 101, 0, 100, 0.7
+
+
+class Point:
+    def __init__(self, scenario, indicator, strategy):
+        self.scenario = scenario
+        self.indicator = indicator
+        self.strategy = strategy
+        self.stats = {name: Welford() for name in RESULTS_VALUES}
+        self.runs = 0           # 已提交的次数, 也用作下一个RngRun
+        self.failed = 0
+        self.seen = set()       # 已得到的指标组合, 用于检查各次重复是否独立
+        self.duplicates = 0     # 与之前某次重复完全相同的次数
+
+    def folder(self, kind):
+        return os.path.join('test', kind, 'sweep', self.scenario, str(self.indicator))
+
+    def noise(self, rel):
+        """各目标指标半宽与阈值之比的最大值, 不大于1即收敛"""
+        ratios = []
+        for name in TARGET_METRICS:
+            stat = self.stats[name]
+            threshold = max(rel * abs(stat.mean), ABSOLUTE_FLOOR[name])
+            ratios.append(stat.halfWidth() / threshold)
+        return max(ratios)
+
+    def wanted(self, rel):
+        """估计收敛所需的成功次数: 半宽约与1/sqrt(n)成正比"""
+        n = self.stats['ISR'].n
+        noise = self.noise(rel)
+        if n < 2 or math.isinf(noise):
+            return n + 1
+        return math.ceil(n * noise ** 2)
+
+
+def runPoint(point, seed, steady):
+    trace, num, consumers, producers, popularity = pointConfig(point.scenario, point.indicator)
+    logfile = os.path.join(point.folder('logs'), f'{point.strategy}-run{seed}.log')
+    delayfile = os.path.join(point.folder('logs_delay'), f'{point.strategy}-run{seed}.log')
+    # 已有完整日志时直接复用, 中断后重新运行可以继续
+    if not (os.path.exists(logfile) and os.path.exists(delayfile)
+            and open(logfile).read().endswith('end')):
+        env = dict(os.environ)
+        env['NS_LOG'] = f'ndn-cxx.nfd.{point.strategy.upper()}:ndn.Producer'
+        command = (f'build/{point.strategy} --num={num} --consumers={consumers} --producers={producers} '
+                   f'--popularity={popularity} --rate={RATE} --time={TIME} --trace={trace} '
+                   f'--delay_log={delayfile} --RngRun={seed} --steady={steady}')
+        with open(logfile, 'w') as log:
+            subprocess.call(command, shell=True, stdout=log, stderr=subprocess.STDOUT, env=env)
+    return calMetric(logfile, delayfile, num - 1, RATE, TIME)
+
+
+def writeResults(points, output):
+    os.makedirs(output, exist_ok=True)
+    for scenario in sorted({p.scenario for p in points}):
+        with open(os.path.join(output, f'{scenario}.csv'), 'w', newline='') as file:
+            writer = csv.writer(file)
+            writer.writerow(['indicator', 'strategy', 'runs', 'failed', 'duplicates']
+                            + [f'{name}{suffix}' for name in RESULTS_VALUES for suffix in ('', '_hw')])
+            for p in points:
+                if p.scenario != scenario:
+                    continue
+                row = [p.indicator, p.strategy, p.stats['ISR'].n, p.failed, p.duplicates]
+                for name in RESULTS_VALUES:
+                    stat = p.stats[name]
+                    row += [round(stat.mean, 6), round(stat.halfWidth(), 6) if stat.n > 1 else '']
+                writer.writerow(row)
+
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(description='Replicate sweep points until their 95% CIs are tight')
+    parser.add_argument('--scenarios', nargs='+', default=list(SCENARIOS))
+    parser.add_argument('--strategies', nargs='+', default=STRATEGY_VALUES)
+    parser.add_argument('--rel', type=float, default=0.05, help='半宽相对阈值')
+    parser.add_argument('--min-runs', type=int, default=3)
+    parser.add_argument('--max-runs', type=int, default=20)
+    parser.add_argument('--jobs', type=int, default=os.cpu_count())
+    parser.add_argument('--steady', type=float, default=0, help='稳态检测窗口(秒), 稳定或崩溃后提前结束, 0为运行完整时长')
+    parser.add_argument('--output', default='test/results/sweep')
+    args = parser.parse_args()
+
+    # 先构建一次, 之后并行直接运行build/下的程序, 避免多个waf同时检查构建
+    subprocess.call('./waf', shell=True)
+
+    points = [Point(s, i, strategy) for s in args.scenarios for i in SCENARIOS[s] for strategy in args.strategies]
+    for p in points:
+        os.makedirs(p.folder('logs'), exist_ok=True)
+        os.makedirs(p.folder('logs_delay'), exist_ok=True)
+
+    def nextPoint():
+        # 先补足min_runs, 之后选噪声最大且未收敛的点; 一个点同时排队的次数不超过估计所需,
+        # 避免已经足够的点占用进程
+        candidates = [p for p in points if p.runs < args.max_runs and p.runs - p.failed < args.min_runs]
+        if candidates:
+            return min(candidates, key=lambda p: p.runs)
+        candidates = [p for p in points if p.runs < args.max_runs and p.noise(args.rel) > 1
+                      and p.runs - p.failed < p.wanted(args.rel)]
+        if candidates:
+            return max(candidates, key=lambda p: p.noise(args.rel))
+        return None
+
+    with ThreadPoolExecutor(max_workers=args.jobs) as pool:
+        running = {}
+        while True:
+            while len(running) < args.jobs:
+                point = nextPoint()
+                if point is None:
+                    break
+                point.runs += 1
+                running[pool.submit(runPoint, point, point.runs, args.steady)] = point
+            if not running:
+                break
+            done, _ = wait(running, return_when=FIRST_COMPLETED)
+            for future in done:
+                point = running.pop(future)
+                metric = future.result()
+                if metric is None:
+                    point.failed += 1
+                else:
+                    # 两次重复得到完全相同的指标可能是RngRun没有作用到随机变量上(置信区间偏窄),
+                    # 也可能是网络崩溃(ISR=ISD=0)等结果本身相同, 只警告并计数, 不中断整个扫描
+                    if tuple(metric) in point.seen:
+                        point.duplicates += 1
+                        print(f"警告: {point.scenario}={point.indicator} {point.strategy}: "
+                              f"指标与之前的重复完全相同{metric}, 共{point.duplicates}次")
+                    point.seen.add(tuple(metric))
+                    for name, value in zip(RESULTS_VALUES, metric):
+                        point.stats[name].add(value)
+                print(f"{point.scenario}={point.indicator} {point.strategy}: {point.stats['ISR'].n}次, "
+                      f"噪声比{round(point.noise(args.rel), 3)}")
+            writeResults(points, args.output)
+
+    unconverged = [p for p in points if p.noise(args.rel) > 1]
+    print(f"完成, {len(unconverged)}个点在{args.max_runs}次内未收敛")
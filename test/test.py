@@ -44,18 +44,8 @@ def runScenario(scenario: str, indicators: list):
             popularity = 0.7
         run(trace, logfile_folder, delayfile_folder, num, consumers, producers, popularity)
 
-def modify_cpp_file(file_path, scenario, indicator):
-    with open(file_path, 'r') as file:
-        lines = file.readlines()
-    if scenario == '5_Time':
-        lines[25] = f'\t\t\tconst double CCAF::T({indicator});' + '\n'
-    elif scenario == '6_Pth':   
-        lines[24] = f'\t\t\tconst double CCAF::Pth({indicator});' + '\n'
-    elif scenario == '7_CacheSize':
-        lines[27] = f'\t\t\tconst int CCAF::CACHE_SIZE({indicator});' + '\n'
-    with open(file_path, 'w') as file:
-        file.writelines(lines)
-    print(f"{scenario}={indicator} has been modified.")
+# 扫描的CCAF参数通过实例名参数(--strategyParams)传入, 不再改写ccaf.cpp
+STRATEGY_PARAMS = {'5_Time': 't', '6_Pth': 'pth', '7_CacheSize': 'cache-size'}
 
 def runScenario2(scenario : str, indicators : list):
     logfile_folder =  'test/logs/' + scenario 
@@ -63,16 +53,15 @@ def runScenario2(scenario : str, indicators : list):
     os.makedirs(logfile_folder, exist_ok=True)
     os.makedirs(delayfile_folder, exist_ok=True)
     for indicator in indicators:
-        modify_cpp_file('extensions/ccaf.cpp', scenario, indicator)
         logfile = os.path.join(logfile_folder, f'{indicator}.log')
         delayfile = os.path.join(delayfile_folder, f'{indicator}.log')
         if (os.path.exists(logfile) and os.path.exists(delayfile)):
             continue
         if scenario == '7_CacheSize':
-            command = f'NS_LOG=ndn-cxx.nfd.CCAF:ndn.Producer ./waf --run "ccaf --num=121 --consumers=0 --producers=120 --popularity=0.7 --rate=20.0 --time=20.0 --trace=mobility-traces/1_Num/n120.tcl --delay_log={delayfile} --size={indicator}">{logfile} 2>&1'
+            command = f'NS_LOG=ndn-cxx.nfd.CCAF:ndn.Producer ./waf --run "ccaf --num=121 --consumers=0 --producers=120 --popularity=0.7 --rate=20.0 --time=20.0 --trace=mobility-traces/1_Num/n120.tcl --delay_log={delayfile} --size={indicator} --strategyParams={STRATEGY_PARAMS[scenario]}~{indicator}">{logfile} 2>&1'
             os.system(command)
         else:
-            command = f'NS_LOG=ndn-cxx.nfd.CCAF:ndn.Producer ./waf --run "ccaf --num=101 --consumers=0 --producers=100 --popularity=0.7 --rate=20.0 --time=20.0 --trace=mobility-traces/1_Num/n100.tcl --delay_log={delayfile} --size=20">{logfile} 2>&1'
+            command = f'NS_LOG=ndn-cxx.nfd.CCAF:ndn.Producer ./waf --run "ccaf --num=101 --consumers=0 --producers=100 --popularity=0.7 --rate=20.0 --time=20.0 --trace=mobility-traces/1_Num/n100.tcl --delay_log={delayfile} --size=20 --strategyParams={STRATEGY_PARAMS[scenario]}~{indicator}">{logfile} 2>&1'
             os.system(command)
 
 STRATEGY_VALUES =['vndn', 'dasb', 'lisic', 'prfs', 'ccaf']
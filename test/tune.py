@@ -0,0 +1,186 @@
+import argparse
+import csv
+import json
+import math
+import os
+import random
+import subprocess
+from concurrent.futures import ThreadPoolExecutor
+
+from metrics import RESULTS_VALUES, calMetric
+from sweep import SCENARIOS, pointConfig
+
+# 策略阈值自动调参(successive halving): 随机采样一批参数(含默认值), 先用短仿真评估全部参数,
+# 每一轮保留得分最高的1/eta, 仿真时长乘以eta后再评估, 直到max-time; 参数以--strategyParams传入
+
+RATE = 10.0
+# 每个参数: (采样方式, 下限, 上限), 与各策略构造函数中读取的实例名参数一致
+SPACES = {
+    'ccaf': {'pth': ('linear', 0.5, 0.99), 't': ('linear', 0.5, 5.0), 'cache-size': ('int', 5, 50)},
+    'dasb': {'defer-max': ('log', 5e-4, 1e-2), 'suppression-angle': ('linear', math.pi / 12, math.pi / 2)},
+    'lisic': {'alpha': ('log', 1e8, 1e10)},
+    'lsif': {'let-alpha': ('linear', 1.0, 20.0)},
+    'prfs': {'let-alpha': ('log', 0.1, 10.0)},
+    'mupf': {'mu': ('linear', 0.0, 1.0), 'phi': ('linear', 0.0, 1.0), 'omega': ('linear', 0.0, 1.0)},
+}
+# 归一化为和为1的权重
+NORMALIZE = {'mupf': ['mu', 'phi', 'omega']}
+# 以秒计的时间窗口参数, 每一轮的仿真时长须大于其采样上限
+WINDOW_PARAMS = {'ccaf': ['t']}
+
+
+def readDefaults(strategy, scenario):
+    """以很短的仿真运行一次场景, 从运行报告的strategy_parameters中读取策略实际使用的缺省值,
+    使调参的起点与C++中的缺省值只有一处来源"""
+    trace, num, consumers, producers, popularity = pointConfig(scenario, SCENARIOS[scenario][0])
+    folder = os.path.join('test', 'logs', 'tune', scenario, strategy)
+    os.makedirs(folder, exist_ok=True)
+    report = os.path.join(folder, 'defaults.json')
+    command = [f'build/{strategy}', f'--num={num}', f'--consumers={consumers}', f'--producers={producers}',
+               f'--popularity={popularity}', f'--rate={RATE}', '--time=0.1', f'--trace={trace}',
+               f'--report={report}']
+    subprocess.run(command, stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL, check=True)
+    with open(report) as file:
+        values = json.load(file)['strategy_parameters'].get(strategy.upper(), {})
+    missing = set(SPACES[strategy]) - set(values)
+    assert not missing, f'{strategy}: 运行报告中没有参数{missing}, 构造函数中没有读取它们'
+    # 整数参数(如cache-size)在报告中也是浮点数
+    return {key: int(values[key]) if SPACES[strategy][key][0] == 'int' else values[key]
+            for key in SPACES[strategy]}
+
+
+def sample(strategy, rng):
+    params = {}
+    for key, (kind, low, high) in SPACES[strategy].items():
+        if kind == 'log':
+            params[key] = math.exp(rng.uniform(math.log(low), math.log(high)))
+        elif kind == 'int':
+            params[key] = rng.randint(low, high)
+        else:
+            params[key] = rng.uniform(low, high)
+    keys = NORMALIZE.get(strategy, [])
+    total = sum(params[k] for k in keys)
+    for k in keys:
+        params[k] = params[k] / total if total > 0 else 1 / len(keys)
+    return params
+
+
+def formatParams(params):
+    """实例名参数, 如pth~0.85/t~1.5"""
+    return '/'.join(f'{key}~{value:.6g}' if isinstance(value, float) else f'{key}~{value}'
+                    for key, value in params.items())
+
+
+def score(metric, args):
+    """越大越好: ISR减去ISD(秒)与FIP的加权惩罚"""
+    fip, fdp, isd, isr = metric
+    return isr - args.isd_weight * isd - args.fip_weight * fip
+
+
+def runOnce(strategy, scenario, indicator, config, params, duration, seed, args):
+    trace, num, consumers, producers, popularity = pointConfig(scenario, indicator)
+    folder = os.path.join('test', 'logs', 'tune', scenario, strategy)
+    os.makedirs(folder, exist_ok=True)
+    prefix = os.path.join(folder, f'c{config}-t{duration:g}-{indicator}-run{seed}')
+    logfile, delayfile = prefix + '.log', prefix + '.delay'
+    if not (os.path.exists(logfile) and os.path.exists(delayfile)
+            and open(logfile).read().endswith('end')):
+        env = dict(os.environ)
+        env['NS_LOG'] = f'ndn-cxx.nfd.{strategy.upper()}:ndn.Producer'
+        command = [f'build/{strategy}', f'--num={num}', f'--consumers={consumers}', f'--producers={producers}',
+                   f'--popularity={popularity}', f'--rate={RATE}', f'--time={duration}', f'--trace={trace}',
+                   f'--delay_log={delayfile}', f'--RngRun={seed}', f'--steady={args.steady}',
+                   f'--strategyParams={formatParams(params)}']
+        with open(logfile, 'w') as log:
+            subprocess.call(command, stdout=log, stderr=subprocess.STDOUT, env=env)
+    return calMetric(logfile, delayfile, num - 1, RATE, duration)
+
+
+def tune(strategy, scenario, args, pool, writer):
+    rng = random.Random(args.seed)
+    configs = [readDefaults(strategy, scenario)] + [sample(strategy, rng) for _ in range(args.configs - 1)]
+    alive = list(range(len(configs)))
+    durations = []
+    duration = args.min_time
+    while duration < args.max_time:
+        durations.append(duration)
+        duration *= args.eta
+    durations.append(args.max_time)
+
+    cost = 0.0
+    scores = {}
+    for rung, duration in enumerate(durations):
+        jobs = {}
+        for config in alive:
+            for indicator in SCENARIOS[scenario]:
+                for seed in range(1, args.seeds + 1):
+                    jobs[(config, indicator, seed)] = pool.submit(
+                        runOnce, strategy, scenario, indicator, config, configs[config], duration, seed, args)
+        cost += len(jobs) * duration
+        metrics = {key: future.result() for key, future in jobs.items()}
+        for config in alive:
+            results = [m for (c, _, _), m in metrics.items() if c == config]
+            # 有失败的运行时该参数直接淘汰
+            if any(m is None for m in results):
+                scores[config] = -math.inf
+                mean = [''] * len(RESULTS_VALUES)
+            else:
+                scores[config] = sum(score(m, args) for m in results) / len(results)
+                mean = [round(sum(m[i] for m in results) / len(results), 6) for i in range(len(RESULTS_VALUES))]
+            writer.writerow([scenario, strategy, rung, duration, config, formatParams(configs[config])]
+                            + mean + [round(scores[config], 6)])
+        alive.sort(key=lambda c: scores[c], reverse=True)
+        print(f"{scenario} {strategy} 第{rung}轮 time={duration:g}s: {len(alive)}组参数, "
+              f"最好c{alive[0]} {formatParams(configs[alive[0]])} 得分{round(scores[alive[0]], 4)}")
+        if rung + 1 < len(durations):
+            alive = alive[:max(1, math.ceil(len(alive) / args.eta))]
+
+    best = alive[0]
+    # 与所有参数都以max-time完整运行相比的仿真时长
+    grid = args.configs * len(SCENARIOS[scenario]) * args.seeds * args.max_time
+    print(f"{scenario} {strategy}: 最优参数 {formatParams(configs[best])}, 仿真{cost:g}s, "
+          f"为完整评估的{round(cost / grid * 100, 1)}%")
+    return configs[best], scores[best], cost
+
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(description='Tune strategy thresholds with successive halving')
+    parser.add_argument('--strategies', nargs='+', default=list(SPACES))
+    parser.add_argument('--scenarios', nargs='+', default=['1_Num'])
+    parser.add_argument('--configs', type=int, default=27, help='初始参数组数(含默认值)')
+    parser.add_argument('--eta', type=int, default=3, help='每轮保留1/eta, 仿真时长乘以eta')
+    # 默认6/18/54s三轮(27->9->3组), 仿真时长为全部参数都运行max-time的1/3, 也少于全部以20s运行;
+    # 只有两轮时(如10/20s)几乎不省时间
+    parser.add_argument('--min-time', type=float, default=6.0, help='须大于时间窗口参数(如CCAF的t)的采样上限')
+    parser.add_argument('--max-time', type=float, default=54.0, help='不应超过移动轨迹的时长')
+    parser.add_argument('--seeds', type=int, default=2, help='每个取值重复的RngRun数')
+    parser.add_argument('--isd-weight', type=float, default=1.0)
+    parser.add_argument('--fip-weight', type=float, default=0.0)
+    parser.add_argument('--steady', type=float, default=0, help='稳态检测窗口(秒), 0为运行完整时长')
+    parser.add_argument('--seed', type=int, default=1, help='参数采样的随机种子')
+    parser.add_argument('--jobs', type=int, default=os.cpu_count())
+    parser.add_argument('--output', default='test/results/tune')
+    args = parser.parse_args()
+    for strategy in args.strategies:
+        for key in WINDOW_PARAMS.get(strategy, []):
+            if args.min_time <= SPACES[strategy][key][2]:
+                parser.error(f'--min-time={args.min_time:g}不大于{strategy}的{key}采样上限{SPACES[strategy][key][2]:g}')
+
+    subprocess.call('./waf', shell=True)
+    os.makedirs(args.output, exist_ok=True)
+    with open(os.path.join(args.output, 'rungs.csv'), 'w', newline='') as rungsFile, \
+            ThreadPoolExecutor(max_workers=args.jobs) as pool:
+        writer = csv.writer(rungsFile)
+        writer.writerow(['scenario', 'strategy', 'rung', 'time', 'config', 'params'] + RESULTS_VALUES + ['score'])
+        best = []
+        for scenario in args.scenarios:
+            for strategy in args.strategies:
+                params, value, cost = tune(strategy, scenario, args, pool, writer)
+                rungsFile.flush()
+                best.append([scenario, strategy, formatParams(params), round(value, 6), cost])
+
+    with open(os.path.join(args.output, 'best.csv'), 'w', newline='') as file:
+        writer = csv.writer(file)
+        writer.writerow(['scenario', 'strategy', 'strategyParams', 'score', 'simulated_s'])
+        writer.writerows(best)
+    print("结果: " + os.path.join(args.output, 'best.csv'))
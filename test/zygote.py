@@ -0,0 +1,79 @@
+import argparse
+import csv
+import os
+import subprocess
+import time
+
+from metrics import RESULTS_VALUES, calMetric
+
+# 用zygote程序在同一轨迹上运行多个(策略, 种子)点: 部署只做一次, 每个点由fork出的子进程运行
+
+STRATEGY_VALUES = ['VNDN', 'DASB', 'LISIC', 'LSIF', 'PRFS', 'DIFS']
+RATE = 10.0
+TIME = 20.0
+POPULARITY = 0.7
+
+
+def writePoints(path, strategies, runs, folder):
+    with open(path, 'w') as file:
+        for strategy in strategies:
+            for run in runs:
+                file.write(f'{strategy} {run} {os.path.join(folder, f"{strategy}-run{run}")}\n')
+
+
+def readRngCheck(logfile):
+    """子进程按本点的run重建随机流后输出的RngCheck取值"""
+    if not os.path.exists(logfile):
+        return None
+    for line in open(logfile, 'r'):
+        if line.startswith('RngCheck='):
+            return line.strip().split('=', 1)[1]
+    return None
+
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(description='Run strategy/seed points from one zygote process')
+    parser.add_argument('--strategies', nargs='+', default=STRATEGY_VALUES)
+    parser.add_argument('--runs', nargs='+', type=int, default=[1, 2, 3])
+    parser.add_argument('--num', type=int, default=100)
+    parser.add_argument('--jobs', type=int, default=os.cpu_count())
+    parser.add_argument('--fast', action='store_true', help='使用单位圆盘模型')
+    parser.add_argument('--output', default='test/results/zygote')
+    args = parser.parse_args()
+
+    os.makedirs(args.output, exist_ok=True)
+    points = os.path.join(args.output, 'points.txt')
+    writePoints(points, args.strategies, args.runs, args.output)
+    trace = f'mobility-traces/1_Num/n{args.num}.tcl'
+    # 子进程继承zygote的日志设置, 因此一次打开所有策略的日志
+    env = dict(os.environ)
+    env['NS_LOG'] = ':'.join(f'ndn-cxx.nfd.{s}' for s in args.strategies) + ':ndn.Producer'
+    command = (f'./waf --run "zygote --num={args.num + 1} --consumers=0 --producers={args.num} '
+               f'--popularity={POPULARITY} --rate={RATE} --time={TIME} --trace={trace} '
+               f'--points={points} --jobs={args.jobs} --report=true'
+               + (' --fast=true' if args.fast else '') + '"')
+    start = time.time()
+    subprocess.call(command, shell=True, env=env)
+    print(f"全部{len(args.strategies) * len(args.runs)}个点耗时{round(time.time() - start, 1)}s")
+
+    with open(os.path.join(args.output, 'summary.csv'), 'w', newline='') as file:
+        writer = csv.writer(file)
+        writer.writerow(['strategy', 'run'] + RESULTS_VALUES)
+        for strategy in args.strategies:
+            for run in args.runs:
+                prefix = os.path.join(args.output, f'{strategy}-run{run}')
+                metric = None
+                if os.path.exists(prefix + '.log') and os.path.exists(prefix + '.delay'):
+                    metric = calMetric(prefix + '.log', prefix + '.delay', args.num, RATE, TIME)
+                writer.writerow([strategy, run] + (metric or [''] * len(RESULTS_VALUES)))
+    print("结果: " + os.path.join(args.output, 'summary.csv'))
+
+    # 同一策略的不同run必须使用不同的随机流, 否则复制实验之间并不独立
+    for strategy in args.strategies:
+        checks = {}
+        for run in args.runs:
+            value = readRngCheck(os.path.join(args.output, f'{strategy}-run{run}.log'))
+            if value is not None:
+                checks[run] = value
+        assert len(set(checks.values())) == len(checks), f'{strategy}: runs share random streams {checks}'
+